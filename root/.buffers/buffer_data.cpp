@@ -0,0 +1,81 @@
+#include "buffer_data.h"
+#include "mesh_generator.h"
+
+static const std::vector<int> SPHERE_LODS = { 4, 8, 16, 32, 64 };
+static const size_t SPHERE_DEFAULT_LOD = 2;
+
+/*
+** Data
+*/
+std::unordered_map<BufferData::Type, BufferData::MeshData> BufferData::Data() {
+    std::unordered_map<Type, MeshData> map;
+    /* Triangle */
+    map.emplace(Type::TRIANGLE, MeshData{
+        {
+            -0.5f, -0.5f, -0.5f,     0.0f, 0.0f,
+            0.5f, -0.5f, -0.5f,      1.0f, 0.0f,
+            0.5f, -0.5f,  0.5f,      1.0f, 1.0f,
+            -0.5f, -0.5f,  0.5f,     0.0f, 1.0f,
+            0.0f,  0.5f,  0.0f,      0.5f, 0.5f
+        },
+        {
+            4, 0, 1,
+            4, 1, 2,
+            4, 2, 3,
+            4, 3, 0,
+            0, 1, 2,
+            0, 2, 3
+        },
+        glm::vec3(-0.5f, -0.5f, -0.5f),
+        glm::vec3(0.5f, 0.5f, 0.5f)
+    });
+    /* Cube */
+    map.emplace(Type::CUBE, MeshData{
+        {
+            -0.5f, -0.5f,  0.5f,     0.0f, 0.0f,
+            0.5f, -0.5f,  0.5f,      1.0f, 0.0f,
+            0.5f,  0.5f,  0.5f,      1.0f, 1.0f,
+            -0.5f,  0.5f,  0.5f,     0.0f, 1.0f,
+            
+            0.5f, -0.5f, -0.5f,      0.0f, 0.0f,
+            -0.5f, -0.5f, -0.5f,     1.0f, 0.0f,
+            -0.5f,  0.5f, -0.5f,     1.0f, 1.0f,
+            0.5f,  0.5f, -0.5f,      0.0f, 1.0f,
+            
+            -0.5f,  0.5f,  0.5f,     0.0f, 0.0f,
+            0.5f,  0.5f,  0.5f,      1.0f, 0.0f,
+            0.5f,  0.5f, -0.5f,      1.0f, 1.0f,
+            -0.5f,  0.5f, -0.5f,     0.0f, 1.0f,
+            
+            -0.5f, -0.5f, -0.5f,     0.0f, 0.0f,
+            0.5f, -0.5f, -0.5f,      1.0f, 0.0f,
+            0.5f, -0.5f,  0.5f,      1.0f, 1.0f,
+            -0.5f, -0.5f,  0.5f,     0.0f, 1.0f,
+            
+            0.5f, -0.5f,  0.5f,      0.0f, 0.0f,
+            0.5f, -0.5f, -0.5f,      1.0f, 0.0f,
+            0.5f,  0.5f, -0.5f,      1.0f, 1.0f,
+            0.5f,  0.5f,  0.5f,      0.0f, 1.0f,
+            
+            -0.5f, -0.5f, -0.5f,     0.0f, 0.0f,
+            -0.5f, -0.5f,  0.5f,     1.0f, 0.0f,
+            -0.5f,  0.5f,  0.5f,     1.0f, 1.0f,
+            -0.5f,  0.5f, -0.5f,     0.0f, 1.0f
+        },
+        {
+            0, 1, 2, 0, 2, 3,
+            4, 5, 6, 4, 6, 7,
+            8, 9, 10, 8, 10, 11,
+            12, 13, 14, 12, 14, 15,
+            16, 17, 18, 16, 18, 19,
+            20, 21, 22, 20, 22, 23
+        },
+        glm::vec3(-0.5f, -0.5f, -0.5f),
+        glm::vec3(0.5f, 0.5f, 0.5f)
+    });
+    /* Sphere */
+    auto sphereData = MeshGenerator::cubeSphereLodChain(SPHERE_LODS, SPHERE_DEFAULT_LOD);
+    map.emplace(Type::SPHERE, std::move(sphereData));
+
+    return map;
+}
\ No newline at end of file
@@ -1,16 +1,8 @@
 #include "buffer_generator.h"
-#include "buffers.h"
-#include "../camera.h"
-#include "../.controller/shader_controller.h"
-#include "../.preset/preset_loader.h"
-#include "../_data/data_parser.h"
+#include "../_data/asset_cache.h"
 #include <algorithm>
 #include <queue>
 #include <iostream>
-#include <unordered_set>
-#include <emscripten/html5.h>
-#include <fstream>
-#include <sstream>
 
 BufferGenerator::BufferGenerator(Camera* camera) :
     camera(camera) 
@@ -23,42 +15,7 @@ BufferGenerator::~BufferGenerator() {};
 ** Load Distance Map
 */
 void BufferGenerator::loadDistanceMap() {
-    try {
-        std::ifstream file("/_data/positions.json");
-        if(!file.is_open()) {
-            std::cerr << "Failed to open positions.json file" << std::endl;
-            return;
-        }
-
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        std::string data = buffer.str();
-
-        DataParser::Value root = DataParser::Parser::parse(data);
-        if(!root.hasKey("distances") || !root["distances"].isArray()) {
-            std::cerr << "Invalid positions.json format: missing distances array" << std::endl;
-            return;
-        }
-
-        const auto& distancesArray = root["distances"].asArray();
-        for(const auto& distanceValue : distancesArray) {
-            if(!distanceValue.isObject()) continue;
-            if(distanceValue.hasKey("index") && distanceValue.hasKey("distance")) {
-                int i = distanceValue["index"].asInt();
-                std::string distanceStr = distanceValue["distance"].asString();
-                if(distanceStr.back() == 'f') {
-                    distanceStr.pop_back();
-                }
-
-                float distance = std::stof(distanceStr);
-                distanceMap[i] = distance;
-            }
-        }
-
-        std::cout << "Loaded " << distanceMap.size() << " distance mappings" << std::endl;
-    } catch(const std::exception& err) {
-        std::cerr << "Error loading distance map: " << err.what() << std::endl;
-    }
+    distanceMap = AssetCache::get().getDistances("/_data/positions.json");
 }
 
 /*
@@ -122,9 +79,9 @@ std::string BufferGenerator::rotationToString(RotationAxis axis) {
 ** Calculate Distance from Pos
 */
 float BufferGenerator::calculateDistanceFromPosition(int position) {
-    auto it = distanceMap.find(position);
-    if(it != distanceMap.end()) {
-        return it->second;
+    if(distanceMap) {
+        auto it = distanceMap->find(position);
+        if(it != distanceMap->end()) return it->second;
     }
     return 1.0f + (position - 8) * 0.15f;
 }
@@ -149,32 +106,14 @@ PlanetBuffer BufferGenerator::generatePlanet(const PlanetData& data) {
 /*
 ** Update Planets
 */
-void BufferGenerator::updatePlanetRotation(std::vector<PlanetBuffer>& planets, float deltaTime) {
+void BufferGenerator::updatePlanetRotation(OrbitalState& state, float deltaTime) {
     const float SPEED_MULTIPLIER_CENTER = 2000.0f;
     const float SPEED_MULTIPLIER_ITSELF = 20.0f;
     
-    for(auto& planet : planets) {
-        switch(planet.data.rotationDir) {
-            case RotationAxis::X:
-                planet.data.currentRotation.x += planet.data.rotationSpeedItself * SPEED_MULTIPLIER_ITSELF * deltaTime;
-                break;
-            case RotationAxis::Y:
-                planet.data.currentRotation.y += planet.data.rotationSpeedItself * SPEED_MULTIPLIER_ITSELF * deltaTime;
-                break;
-            case RotationAxis::Z:
-                planet.data.currentRotation.z += planet.data.rotationSpeedItself * SPEED_MULTIPLIER_ITSELF * deltaTime;
-                break;
-        }
-        if(planet.data.position != 0) {
-            planet.data.orbitAngle.y += planet.data.rotationSpeedCenter * SPEED_MULTIPLIER_CENTER * deltaTime;
-            planet.data.orbitAngle.y = fmod(planet.data.orbitAngle.y, 360.0f);
-        }
-        
-        planet.data.currentRotation.x = fmod(planet.data.currentRotation.x, 360.0f);
-        planet.data.currentRotation.y = fmod(planet.data.currentRotation.y, 360.0f);
-        planet.data.currentRotation.z = fmod(planet.data.currentRotation.z, 360.0f);
-        planet.data.orbitAngle.y = fmod(planet.data.orbitAngle.y, 360.0f);
-    }
+    state.advance(
+        SPEED_MULTIPLIER_ITSELF * deltaTime, 
+        SPEED_MULTIPLIER_CENTER * deltaTime
+    );
 }
 
 /*
@@ -228,43 +167,3 @@ bool BufferGenerator::replaceLastPlanet(
     planets[highestIndex].position = highestPos;
     return true;
 };
-
-/*
-** Generate
-*/
-void generate(const char* data) {
-    try {
-        std::string str(data);
-
-        PlanetData newPlanet;
-        BufferGenerator* bufferGenerator;
-        PresetLoader* presetLoader;
-
-        auto& planets = presetLoader->getCurrentPreset().planets;
-        int availablePos = bufferGenerator->findAvailablePosition(
-            presetLoader->getCurrentPreset().planets
-        );
-        if(availablePos == -1) {
-            bufferGenerator->replaceLastPlanet(
-                presetLoader->getCurrentPreset().planets, newPlanet
-            );
-        } else {
-            newPlanet.position = availablePos;
-            newPlanet.distanceFromCenter = bufferGenerator->calculateDistanceFromPosition(
-                availablePos
-            );
-            presetLoader->getCurrentPreset().planets.push_back(newPlanet);
-        }
-
-        Buffers* buffers;
-        auto newBuffers = bufferGenerator->generateFromPreset(
-            presetLoader->getCurrentPreset()
-        );
-        buffers->planetBuffers.clear();
-        for(auto& buffer : newBuffers) {
-            buffers->planetBuffers.push_back(std::move(buffer));
-        }
-    } catch(const std::exception& err) {
-        std::cerr << "Error creating planet!" << err.what() << std::endl;
-    }
-}
\ No newline at end of file
@@ -1,8 +1,7 @@
 #pragma once
 #include "../.preset/preset_data.h"
 #include "buffer_data.h"
-#include "../camera.h"
-#include <emscripten/html5.h>
+#include "orbital_state.h"
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -12,11 +11,9 @@ struct PlanetBuffer {
     uint32_t vao;
     uint32_t vbo;
     uint32_t ebo;
-    glm::vec3 worldPos;
     bool isPreview = false;
 
     PlanetBuffer() : 
-        worldPos(0.0f),
         isPreview(false) 
     {}
     PlanetBuffer(PlanetBuffer&&) = default;
@@ -26,10 +23,11 @@ struct PlanetBuffer {
     PlanetBuffer& operator=(const PlanetBuffer&) = delete;
 };
 
+class Camera;
 class BufferGenerator {
     private:    
         Camera* camera;
-        std::unordered_map<int, float> distanceMap;
+        std::shared_ptr<const std::unordered_map<int, float>> distanceMap;
 
         void loadDistanceMap();
 
@@ -39,21 +37,13 @@ class BufferGenerator {
 
         std::vector<PlanetBuffer> generateFromPreset(const PresetData& preset);
         PlanetBuffer generatePlanet(const PlanetData& data);
-        void updatePlanetRotation(std::vector<PlanetBuffer>& planets, float deltaTime);
+        void updatePlanetRotation(OrbitalState& state, float deltaTime);
         int findAvailablePosition(const std::vector<PlanetData>& planets);
         bool replaceLastPlanet(std::vector<PlanetData>& planets, const PlanetData& newPlanet);
         float calculateDistanceFromPosition(int position);
 
-        BufferData::Type shapeToBufferType(const std::string& name);
-        RotationAxis rotationToBufferType(const std::string& axis);
-        std::string shapeToString(BufferData::Type type);
-        std::string rotationToString(RotationAxis axis);
-};
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-    void EMSCRIPTEN_KEEPALIVE generatePlanetParser(const char* data);
-#ifdef __cplusplus
-}
-#endif
\ No newline at end of file
+        static BufferData::Type shapeToBufferType(const std::string& name);
+        static RotationAxis rotationToBufferType(const std::string& axis);
+        static std::string shapeToString(BufferData::Type type);
+        static std::string rotationToString(RotationAxis axis);
+};
\ No newline at end of file
@@ -1,11 +1,14 @@
 #include "buffers.h"
 #include "../.controller/shader_controller.h"
 #include "../camera.h"
+#include "../_utils/profiler.h"
 #include <emscripten.h>
 #include <GLES3/gl3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <cstring>
 
 Buffers::Buffers(
     Camera* camera, 
@@ -15,7 +18,14 @@ Buffers::Buffers(
     camera(camera),
     shaderController(shaderController),
     bufferController(bufferController),
-    isPreviewMode(false)
+    isPreviewMode(false),
+    instancedRendering(true),
+    lodPixelScale(0.0f),
+    lodCameraPos(0.0f),
+    cullStats{},
+    lodStats{},
+    uniformUploads(0),
+    instanceVbo(0)
 {}
 Buffers::~Buffers() {
     for(auto& [type, v] : vaos) {
@@ -23,6 +33,10 @@ Buffers::~Buffers() {
         glDeleteBuffers(1, &vbos[type]);
         glDeleteBuffers(1, &ebos[type]);
     } 
+    for(auto& [type, v] : instancedVaos) {
+        glDeleteVertexArrays(1, &v);
+    }
+    if(instanceVbo != 0) glDeleteBuffers(1, &instanceVbo);
 }
 
 /*
@@ -31,7 +45,7 @@ Buffers::~Buffers() {
 void Buffers::set(BufferData::Type type) {
     if(vaos.find(type) != vaos.end()) return;
 
-    BufferData::MeshData meshData = BufferData::GetMeshData(type);
+    const BufferData::MeshData& meshData = BufferData::GetMeshData(type);
     GLuint vao;
     GLuint vbo;
     GLuint ebo;
@@ -57,13 +71,13 @@ void Buffers::set(BufferData::Type type) {
         GL_STATIC_DRAW
     );
 
-    GLuint posAttr = glGetAttribLocation(shaderController->shaderProgram, "aPos");
+    GLint posAttr = shaderController->getAttrib(ShaderController::Attrib::POS);
     if(posAttr != -1) {
         glVertexAttribPointer(posAttr, 3, GL_FLOAT, GL_FALSE,  5 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(posAttr);
     }
 
-    GLuint texCoordAttr = glGetAttribLocation(shaderController->shaderProgram, "aTexCoord");
+    GLint texCoordAttr = shaderController->getAttrib(ShaderController::Attrib::TEX_COORD);
     if(texCoordAttr != -1) {
         glVertexAttribPointer(texCoordAttr, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
         glEnableVertexAttribArray(texCoordAttr);
@@ -74,7 +88,198 @@ void Buffers::set(BufferData::Type type) {
     vaos[type] = vao;
     vbos[type] = vbo;
     ebos[type] = ebo;
-    indexCounts[type] = meshData.indices.size();
+    lodLevels[type] = meshData.lods;
+    defaultLods[type] = meshData.defaultLod;
+    boundRadii[type] = glm::length(meshData.maxBounds - meshData.minBounds) * 0.5f;
+
+    setInstanced(type);
+}
+
+/*
+** Get Lod
+*/
+const BufferData::LodLevel& Buffers::getLod(BufferData::Type type) {
+    return lodLevels[type][defaultLods[type]];
+}
+
+const BufferData::LodLevel& Buffers::getLod(BufferData::Type type, int lod) {
+    return lodLevels[type][lod];
+}
+
+/*
+** Update Visibility
+*/
+void Buffers::updateVisibility() {
+    PROFILE_ZONE(CULLING);
+    visiblePlanets.clear();
+    cullStats = CullStats{};
+    if(camera) frustum.extract(camera->getProjectionMatrix() * camera->getViewMatrix());
+
+    for(size_t i = 0; i < planetBuffers.size(); i++) {
+        const PlanetBuffer& planetBuffer = planetBuffers[i];
+        if(vaos.find(planetBuffer.data.shape) == vaos.end()) continue;
+
+        float radius = boundRadii[planetBuffer.data.shape] * planetBuffer.data.size;
+        if(camera && !frustum.containsSphere(orbitalState.getWorldPos(i), radius)) {
+            cullStats.culled++;
+            continue;
+        }
+        visiblePlanets.push_back(i);
+        cullStats.visible++;
+    }
+}
+
+/*
+**
+*** Lod Selection
+**
+*/
+void Buffers::beginLodFrame() {
+    lodStats = LodStats{};
+    if(!camera) {
+        lodPixelScale = 0.0f;
+        return;
+    }
+
+    /* projection[1][1] = 1 / tan(fov / 2), so world radius / distance * scale = pixels */
+    glm::mat4 projection = camera->getProjectionMatrix();
+    lodPixelScale = projection[1][1] * camera->main->height * 0.5f;
+    lodCameraPos = camera->position;
+}
+
+/*
+** Select Lod
+*/
+int Buffers::selectLod(size_t index) {
+    const PlanetBuffer& planetBuffer = planetBuffers[index];
+    const std::vector<BufferData::LodLevel>& levels = lodLevels[planetBuffer.data.shape];
+    if(levels.empty()) return -1;
+
+    int finest = static_cast<int>(levels.size()) - 1;
+    if(lodPixelScale <= 0.0f) return static_cast<int>(defaultLods[planetBuffer.data.shape]);
+
+    float radius = boundRadii[planetBuffer.data.shape] * planetBuffer.data.size;
+    float distance = glm::length(orbitalState.getWorldPos(index) - lodCameraPos);
+    if(distance <= radius) return finest;
+
+    float pixelRadius = radius / distance * lodPixelScale;
+    if(pixelRadius < LOD_CULL_PIXELS) return -1;
+    if(levels.size() == 1) return 0;
+
+    /* Four cube faces wrap the silhouette; keep each segment under LOD_EDGE_PIXELS */
+    float required = glm::two_pi<float>() * pixelRadius / (4.0f * LOD_EDGE_PIXELS);
+    for(int i = 0; i < finest; i++) {
+        if(static_cast<float>(levels[i].subdivisions) >= required) return i;
+    }
+    return finest;
+}
+
+void Buffers::recordLod(BufferData::Type type, int lod) {
+    if(lod < 0) {
+        lodStats.skipped++;
+        return;
+    }
+    if(static_cast<size_t>(lod) < MAX_LOD_LEVELS) lodStats.histogram[lod]++;
+    lodStats.drawn++;
+    lodStats.triangles += static_cast<uint32_t>(getLod(type, lod).indexCount / 3);
+}
+
+void Buffers::endLodFrame() {
+    if(lodStatsCallback) lodStatsCallback(lodStats);
+}
+
+/*
+** Set Instanced Buffers
+*/
+void Buffers::setInstanced(BufferData::Type type) {
+    if(instancedVaos.find(type) != instancedVaos.end()) return;
+
+    if(instanceVbo == 0) glGenBuffers(1, &instanceVbo);
+    GLint instanceModelAttr = shaderController->getAttrib(ShaderController::Attrib::INSTANCE_MODEL);
+    GLint instanceColorAttr = shaderController->getAttrib(ShaderController::Attrib::INSTANCE_COLOR);
+    GLint instanceHoverAttr = shaderController->getAttrib(ShaderController::Attrib::INSTANCE_HOVER);
+    GLint instanceUvRectAttr = shaderController->getAttrib(ShaderController::Attrib::INSTANCE_UV_RECT);
+
+    GLuint vao;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbos[type]);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebos[type]);
+
+    GLint posAttr = shaderController->getAttrib(ShaderController::Attrib::POS);
+    if(posAttr != -1) {
+        glVertexAttribPointer(posAttr, 3, GL_FLOAT, GL_FALSE,  5 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(posAttr);
+    }
+
+    GLint texCoordAttr = shaderController->getAttrib(ShaderController::Attrib::TEX_COORD);
+    if(texCoordAttr != -1) {
+        glVertexAttribPointer(texCoordAttr, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+        glEnableVertexAttribArray(texCoordAttr);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    if(instanceModelAttr != -1) {
+        for(int i = 0; i < 4; i++) {
+            glEnableVertexAttribArray(instanceModelAttr + i);
+            glVertexAttribDivisor(instanceModelAttr + i, 1);
+        }
+    }
+    if(instanceColorAttr != -1) {
+        glEnableVertexAttribArray(instanceColorAttr);
+        glVertexAttribDivisor(instanceColorAttr, 1);
+    }
+    if(instanceHoverAttr != -1) {
+        glEnableVertexAttribArray(instanceHoverAttr);
+        glVertexAttribDivisor(instanceHoverAttr, 1);
+    }
+    if(instanceUvRectAttr != -1) {
+        glEnableVertexAttribArray(instanceUvRectAttr);
+        glVertexAttribDivisor(instanceUvRectAttr, 1);
+    }
+
+    glBindVertexArray(0);
+    instancedVaos[type] = vao;
+}
+
+/*
+** Bind Instance Attributes
+*/
+void Buffers::bindInstanceAttributes(size_t firstInstance) {
+    const GLsizei stride = INSTANCE_FLOATS * sizeof(float);
+    const size_t base = firstInstance * stride;
+    GLint instanceModelAttr = shaderController->getAttrib(ShaderController::Attrib::INSTANCE_MODEL);
+    GLint instanceColorAttr = shaderController->getAttrib(ShaderController::Attrib::INSTANCE_COLOR);
+    GLint instanceHoverAttr = shaderController->getAttrib(ShaderController::Attrib::INSTANCE_HOVER);
+    GLint instanceUvRectAttr = shaderController->getAttrib(ShaderController::Attrib::INSTANCE_UV_RECT);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    if(instanceModelAttr != -1) {
+        for(int i = 0; i < 4; i++) {
+            glVertexAttribPointer(
+                instanceModelAttr + i, 4, GL_FLOAT, GL_FALSE, stride, 
+                (void*)(base + i * 4 * sizeof(float))
+            );
+        }
+    }
+    if(instanceColorAttr != -1) {
+        glVertexAttribPointer(
+            instanceColorAttr, 3, GL_FLOAT, GL_FALSE, stride, 
+            (void*)(base + 16 * sizeof(float))
+        );
+    }
+    if(instanceHoverAttr != -1) {
+        glVertexAttribPointer(
+            instanceHoverAttr, 1, GL_FLOAT, GL_FALSE, stride, 
+            (void*)(base + 19 * sizeof(float))
+        );
+    }
+    if(instanceUvRectAttr != -1) {
+        glVertexAttribPointer(
+            instanceUvRectAttr, 4, GL_FLOAT, GL_FALSE, stride, 
+            (void*)(base + 20 * sizeof(float))
+        );
+    }
 }
 
 /*
@@ -84,77 +289,273 @@ void Buffers::createBufferForPlanet(const PlanetBuffer& planetBuffer) {
     set(planetBuffer.data.shape);
 }
 
+/*
+** Add / Remove Planet
+*/
+void Buffers::addPlanet(PlanetBuffer&& planetBuffer) {
+    createBufferForPlanet(planetBuffer);
+    orbitalState.push(planetBuffer.data);
+    planetBuffers.push_back(std::move(planetBuffer));
+}
+
+void Buffers::removePlanet(size_t index) {
+    if(index >= planetBuffers.size()) return;
+    planetBuffers.erase(planetBuffers.begin() + index);
+    orbitalState.erase(index);
+
+    /* Picking reads the list before the next render rebuilds it */
+    size_t kept = 0;
+    for(size_t i : visiblePlanets) {
+        if(i != index) visiblePlanets[kept++] = i > index ? i - 1 : i;
+    }
+    visiblePlanets.resize(kept);
+}
+
 /*
 ** Render
 */
 void Buffers::render() {
     glUseProgram(shaderController->shaderProgram);
+    updateVisibility();
+    uniformUploads = 0;
     
-    if(!isPreviewMode) {
-        for(auto& planetBuffer : planetBuffers) {
-            auto it = vaos.find(planetBuffer.data.shape);
-            if(it == vaos.end()) continue;
-    
-            glBindVertexArray(it->second);
-    
-            static float previewRotation = 0.0f;
-            previewRotation += 0.5f;
-    
-            float orbitRadius = planetBuffer.data.distanceFromCenter;
-            float orbitAngle = planetBuffer.data.orbitAngle.y;
-            planetBuffer.worldPos = glm::vec3(
-                orbitRadius * cos(glm::radians(orbitAngle)),
-                0.0f,
-                orbitRadius * sin(glm::radians(orbitAngle))
-            );
-    
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, planetBuffer.worldPos);
-            model = glm::rotate(model, planetBuffer.data.currentRotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
-            model = glm::scale(model, glm::vec3(planetBuffer.data.size));
-            unsigned int modelLoc = glGetUniformLocation(shaderController->shaderProgram, "model");
-            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-            
-            GLuint planetColorLoc = glGetUniformLocation(shaderController->shaderProgram, "pColor");
-            if(planetColorLoc != -1) {
-                glm::vec3 color = planetBuffer.data.colorRgb;
-                glUniform3f(planetColorLoc, color.r, color.g, color.b);
+    {
+        PROFILE_ZONE(DRAW);
+        if(!isPreviewMode) {
+            beginLodFrame();
+            if(instancedRendering) {
+                renderInstanced();
+            } else {
+                renderPlanets();
             }
+            endLodFrame();
+        }
+        renderPreviewPlanet();
+    }
+    Profiler::get().countUniforms(uniformUploads);
 
-            GLuint useTexLoc = glGetUniformLocation(shaderController->shaderProgram, "uUseTex");
-            bool hasTex = 
-                !planetBuffer.data.texture.empty() &&
-                bufferController->getTextureLoader()->texExists(planetBuffer.data.texture);
-            if(useTexLoc != -1) {
-                glUniform1i(useTexLoc, hasTex ? 1 : 0);
+    glBindVertexArray(0);
+}
+
+/*
+** Render Planets
+*/
+void Buffers::renderPlanets() {
+    GLint instancedLoc = shaderController->getUniform(ShaderController::Uniform::INSTANCED);
+    if(instancedLoc != -1) {
+        glUniform1i(instancedLoc, 0);
+        uniformUploads++;
+    }
+
+    for(size_t i : visiblePlanets) {
+        const PlanetBuffer& planetBuffer = planetBuffers[i];
+        int lodIndex = selectLod(i);
+        recordLod(planetBuffer.data.shape, lodIndex);
+        if(lodIndex < 0) continue;
+
+        glBindVertexArray(vaos[planetBuffer.data.shape]);
+
+        glm::mat4 model = glm::mat4(1.0f);
+        model = glm::translate(model, orbitalState.getWorldPos(i));
+        model = glm::rotate(model, orbitalState.rotationY[i], glm::vec3(0.0f, 1.0f, 0.0f));
+        model = glm::scale(model, glm::vec3(planetBuffer.data.size));
+        GLint modelLoc = shaderController->getUniform(ShaderController::Uniform::MODEL);
+        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+        uniformUploads++;
+        
+        GLint planetColorLoc = shaderController->getUniform(ShaderController::Uniform::P_COLOR);
+        if(planetColorLoc != -1) {
+            glm::vec3 color = planetBuffer.data.colorRgb;
+            glUniform3f(planetColorLoc, color.r, color.g, color.b);
+            uniformUploads++;
+        }
+
+        GLint useTexLoc = shaderController->getUniform(ShaderController::Uniform::USE_TEX);
+        bool hasTex = 
+            planetBuffer.data.texture != TextureRegistry::NONE &&
+            bufferController->getTextureLoader()->texExists(planetBuffer.data.texture);
+        if(useTexLoc != -1) {
+            glUniform1i(useTexLoc, hasTex ? 1 : 0);
+            uniformUploads++;
+        }
+        if(hasTex) {
+            GLint texLoc = shaderController->getUniform(ShaderController::Uniform::TEX);
+            GLuint texId = bufferController->getTextureLoader()->getTex(planetBuffer.data.texture);
+            if(texLoc != -1 && texId != 0) {
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, texId);
+                glUniform1i(texLoc, 0);
+                uniformUploads++;
             }
-            if(hasTex) {
-                GLuint texLoc = glGetUniformLocation(shaderController->shaderProgram, "uTex");
-                GLuint texId = bufferController->getTextureLoader()->getTex(planetBuffer.data.texture);
-                if(texLoc != -1 && texId != 0) {
-                    glActiveTexture(GL_TEXTURE0);
-                    glBindTexture(GL_TEXTURE_2D, texId);
-                    glUniform1i(texLoc, 0);
-                }
+            GLint uvRectLoc = shaderController->getUniform(ShaderController::Uniform::UV_RECT);
+            if(uvRectLoc != -1) {
+                TextureLoader::UvRect rect = bufferController->getTextureLoader()->getTexRect(planetBuffer.data.texture);
+                glUniform4f(uvRectLoc, rect.u, rect.v, rect.width, rect.height);
+                uniformUploads++;
             }
+        }
 
-            GLuint hoverLoc = glGetUniformLocation(shaderController->shaderProgram, "isHovered"); 
-            int isThisPlanetHovered = (
-                bufferController->raycaster->selectedPlanetIndex == &planetBuffer - &planetBuffers[0]
-            ) ? 1 : 0;
-            if(hoverLoc != -1) {
-                glUniform1f(hoverLoc, (float)isThisPlanetHovered);
+        GLint hoverLoc = shaderController->getUniform(ShaderController::Uniform::IS_HOVERED); 
+        int isThisPlanetHovered = (
+            bufferController->raycaster->selectedPlanetIndex == static_cast<int>(i)
+        ) ? 1 : 0;
+        if(hoverLoc != -1) {
+            glUniform1f(hoverLoc, (float)isThisPlanetHovered);
+            uniformUploads++;
+        }
+
+        const BufferData::LodLevel& lod = getLod(planetBuffer.data.shape, lodIndex);
+        glDrawElements(
+            GL_TRIANGLES,
+            lod.indexCount,
+            GL_UNSIGNED_INT,
+            (void*)(lod.indexOffset * sizeof(GLuint))
+        );
+        Profiler::get().countDraw(lod.indexCount / 3);
+    }
+}
+
+/*
+** Render Instanced
+*/
+void Buffers::renderInstanced() {
+    if(planetBuffers.empty()) return;
+
+    TextureLoader* textureLoader = bufferController->getTextureLoader();
+    int hoveredIndex = bufferController->raycaster ? 
+        bufferController->raycaster->selectedPlanetIndex : 
+        -1;
+
+    for(auto& batch : instanceBatches) {
+        batch.planets.clear();
+    }
+    for(size_t i : visiblePlanets) {
+        const PlanetBuffer& planetBuffer = planetBuffers[i];
+        if(instancedVaos.find(planetBuffer.data.shape) == instancedVaos.end()) continue;
+
+        int lodIndex = selectLod(i);
+        recordLod(planetBuffer.data.shape, lodIndex);
+        if(lodIndex < 0) continue;
+
+        /* Atlased textures report their page, so they share its batch */
+        GLuint texId = 0;
+        if(
+            planetBuffer.data.texture != TextureRegistry::NONE &&
+            textureLoader->texExists(planetBuffer.data.texture)
+        ) {
+            texId = textureLoader->getTex(planetBuffer.data.texture);
+        }
+
+        InstanceBatch* batch = nullptr;
+        for(auto& b : instanceBatches) {
+            if(
+                b.shape == planetBuffer.data.shape && 
+                b.lod == lodIndex && 
+                b.texId == texId
+            ) {
+                batch = &b;
+                break;
             }
-    
-            glDrawElements(
-                GL_TRIANGLES,
-                indexCounts[planetBuffer.data.shape],
-                GL_UNSIGNED_INT,
-                0
-            );
         }
+        if(!batch) {
+            instanceBatches.push_back({ planetBuffer.data.shape, lodIndex, texId, {}, 0 });
+            batch = &instanceBatches.back();
+        }
+        batch->planets.push_back(i);
+    }
+
+    /* Instance Data */
+    instanceData.resize(visiblePlanets.size() * INSTANCE_FLOATS);
+    size_t instanceCount = 0;
+    for(auto& batch : instanceBatches) {
+        batch.firstInstance = instanceCount;
+        for(size_t i : batch.planets) {
+            const PlanetBuffer& planetBuffer = planetBuffers[i];
+
+            glm::mat4 model = glm::mat4(1.0f);
+            model = glm::translate(model, orbitalState.getWorldPos(i));
+            model = glm::rotate(model, orbitalState.rotationY[i], glm::vec3(0.0f, 1.0f, 0.0f));
+            model = glm::scale(model, glm::vec3(planetBuffer.data.size));
+
+            float* dst = &instanceData[instanceCount * INSTANCE_FLOATS];
+            memcpy(dst, glm::value_ptr(model), 16 * sizeof(float));
+            dst[16] = planetBuffer.data.colorRgb.r;
+            dst[17] = planetBuffer.data.colorRgb.g;
+            dst[18] = planetBuffer.data.colorRgb.b;
+            dst[19] = hoveredIndex == static_cast<int>(i) ? 1.0f : 0.0f;
+            TextureLoader::UvRect rect = batch.texId != 0 ?
+                textureLoader->getTexRect(planetBuffer.data.texture) :
+                TextureLoader::UvRect{ 0.0f, 0.0f, 1.0f, 1.0f };
+            dst[20] = rect.u;
+            dst[21] = rect.v;
+            dst[22] = rect.width;
+            dst[23] = rect.height;
+            instanceCount++;
+        }
+    }
+    if(instanceCount == 0) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        instanceCount * INSTANCE_FLOATS * sizeof(float),
+        instanceData.data(),
+        GL_STREAM_DRAW
+    );
+
+    /* Draw */
+    GLint instancedLoc = shaderController->getUniform(ShaderController::Uniform::INSTANCED);
+    GLint useTexLoc = shaderController->getUniform(ShaderController::Uniform::USE_TEX);
+    GLint texLoc = shaderController->getUniform(ShaderController::Uniform::TEX);
+    GLint hoverLoc = shaderController->getUniform(ShaderController::Uniform::IS_HOVERED);
+    if(instancedLoc != -1) {
+        glUniform1i(instancedLoc, 1);
+        uniformUploads++;
+    }
+    if(hoverLoc != -1) {
+        glUniform1f(hoverLoc, 0.0f);
+        uniformUploads++;
+    }
+
+    for(const auto& batch : instanceBatches) {
+        if(batch.planets.empty()) continue;
+
+        glBindVertexArray(instancedVaos[batch.shape]);
+        bindInstanceAttributes(batch.firstInstance);
+
+        if(useTexLoc != -1) {
+            glUniform1i(useTexLoc, batch.texId != 0 ? 1 : 0);
+            uniformUploads++;
+        }
+        if(batch.texId != 0 && texLoc != -1) {
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, batch.texId);
+            glUniform1i(texLoc, 0);
+            uniformUploads++;
+        }
+
+        const BufferData::LodLevel& lod = getLod(batch.shape, batch.lod);
+        glDrawElementsInstanced(
+            GL_TRIANGLES,
+            lod.indexCount,
+            GL_UNSIGNED_INT,
+            (void*)(lod.indexOffset * sizeof(GLuint)),
+            batch.planets.size()
+        );
+        Profiler::get().countDraw(lod.indexCount / 3 * batch.planets.size());
+    }
+
+    if(instancedLoc != -1) {
+        glUniform1i(instancedLoc, 0);
+        uniformUploads++;
     }
-     if(!previewPlanet.data.name.empty()) {
+}
+
+/*
+** Render Preview Planet
+*/
+void Buffers::renderPreviewPlanet() {
+    if(!previewPlanet.data.name.empty()) {
         auto it = vaos.find(previewPlanet.data.shape);
         if(it != vaos.end()) {
             glBindVertexArray(it->second);
@@ -173,8 +574,9 @@ void Buffers::render() {
                 glm::vec3(0.0f, 0.0f, 0.0f),
                 glm::vec3(0.0f, 1.0f, 0.0f)
             );
-            unsigned int viewLoc = glGetUniformLocation(shaderController->shaderProgram, "view");
+            GLint viewLoc = shaderController->getUniform(ShaderController::Uniform::VIEW);
             glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
+            uniformUploads++;
 
             glm::mat4 model = glm::mat4(1.0f);
             model = glm::translate(model, glm::vec3(screenX, screenY, 0.0f));
@@ -188,41 +590,56 @@ void Buffers::render() {
             }
             
             model = glm::scale(model, glm::vec3(previewPlanet.data.size));
-            unsigned int modelLoc = glGetUniformLocation(shaderController->shaderProgram, "model");
+            GLint modelLoc = shaderController->getUniform(ShaderController::Uniform::MODEL);
             glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+            uniformUploads++;
 
-            GLuint planetColorLoc = glGetUniformLocation(shaderController->shaderProgram, "pColor");
+            GLint planetColorLoc = shaderController->getUniform(ShaderController::Uniform::P_COLOR);
             if(planetColorLoc != -1) {
                 glm::vec3 color = previewPlanet.data.colorRgb;
                 glUniform3f(planetColorLoc, color.r, color.g, color.b);
+                uniformUploads++;
             }
 
-            GLuint useTexLoc = glGetUniformLocation(shaderController->shaderProgram, "uUseTex");
+            GLint useTexLoc = shaderController->getUniform(ShaderController::Uniform::USE_TEX);
             bool hasTex = 
-                !previewPlanet.data.texture.empty() &&
+                previewPlanet.data.texture != TextureRegistry::NONE &&
                 bufferController->getTextureLoader()->texExists(previewPlanet.data.texture);
             if(useTexLoc != -1) {
                 glUniform1i(useTexLoc, hasTex ? 1 : 0);
+                uniformUploads++;
             }
             if(hasTex) {
-                GLuint texLoc = glGetUniformLocation(shaderController->shaderProgram, "uTex");
+                GLint texLoc = shaderController->getUniform(ShaderController::Uniform::TEX);
                 GLuint texId = bufferController->getTextureLoader()->getTex(previewPlanet.data.texture);
                 if(texLoc != -1 && texId != 0) {
                     glActiveTexture(GL_TEXTURE0);
                     glBindTexture(GL_TEXTURE_2D, texId);
                     glUniform1i(texLoc, 0);
+                    uniformUploads++;
+                }
+                GLint uvRectLoc = shaderController->getUniform(ShaderController::Uniform::UV_RECT);
+                if(uvRectLoc != -1) {
+                    TextureLoader::UvRect rect = bufferController->getTextureLoader()->getTexRect(previewPlanet.data.texture);
+                    glUniform4f(uvRectLoc, rect.u, rect.v, rect.width, rect.height);
+                    uniformUploads++;
                 }
             }
 
-            GLuint hoverLoc = glGetUniformLocation(shaderController->shaderProgram, "isHovered"); 
-            if(hoverLoc != -1) glUniform1f(hoverLoc, 0.0f);
+            GLint hoverLoc = shaderController->getUniform(ShaderController::Uniform::IS_HOVERED); 
+            if(hoverLoc != -1) {
+                glUniform1f(hoverLoc, 0.0f);
+                uniformUploads++;
+            }
 
+            const BufferData::LodLevel& lod = getLod(previewPlanet.data.shape);
             glDrawElements(
                 GL_TRIANGLES,
-                indexCounts[previewPlanet.data.shape],
+                lod.indexCount,
                 GL_UNSIGNED_INT,
-                0
+                (void*)(lod.indexOffset * sizeof(GLuint))
             );
+            Profiler::get().countDraw(lod.indexCount / 3);
             
             if(!isPreviewMode) {
                 camera->set();
@@ -230,7 +647,6 @@ void Buffers::render() {
         }
     }
 
-    glBindVertexArray(0);
 }
 
 /*
@@ -257,12 +673,19 @@ void Buffers::updatePreviewPlanet(const PlanetData& data) {
     set(previewPlanet.data.shape);
 }
 
+void Buffers::setPreviewShape(BufferData::Type type) {
+    previewPlanet.data.shape = type;
+    set(type);
+}
+
 void Buffers::cleanupPreviewPlanet() {
     previewPlanet = PlanetBuffer();
 }
 
 void Buffers::clearBuffers() {
     planetBuffers.clear();
+    orbitalState.clear();
+    visiblePlanets.clear();
 }
 
 void Buffers::setPreviewMode(bool preview) {
@@ -273,6 +696,34 @@ bool Buffers::isInPreviewMode() const {
     return isPreviewMode;
 }
 
+void Buffers::setInstancedRendering(bool instanced) {
+    instancedRendering = instanced;
+}
+
+bool Buffers::isInstancedRendering() const {
+    return instancedRendering;
+}
+
+void Buffers::setCamera(Camera* camera) {
+    this->camera = camera;
+}
+
+const std::vector<size_t>& Buffers::getVisiblePlanets() const {
+    return visiblePlanets;
+}
+
+const Buffers::CullStats& Buffers::getCullStats() const {
+    return cullStats;
+}
+
+void Buffers::setLodStatsCallback(std::function<void(const LodStats&)> callback) {
+    lodStatsCallback = callback;
+}
+
+const Buffers::LodStats& Buffers::getLodStats() const {
+    return lodStats;
+}
+
 /*
 ** Init
 */
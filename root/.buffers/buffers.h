@@ -1,26 +1,94 @@
 #pragma once
 #include <GLFW/glfw3.h>
 #include <GLES3/gl3.h>
+#include <cstdint>
+#include <functional>
+#include <glm/glm.hpp>
 #include "buffer_data.h"
+#include "frustum.h"
+#include "orbital_state.h"
 #include "../.buffers/buffer_generator.h"
 #include "../.controller/buffer_controller.h"
 
 class Camera;
 class ShaderController;
 class Buffers {
+    public:
+        static constexpr size_t MAX_LOD_LEVELS = 8;
+
+        /* Per-frame Lod counters, laid out as a flat uint32 block for JS */
+        struct LodStats {
+            uint32_t histogram[MAX_LOD_LEVELS];
+            uint32_t drawn;
+            uint32_t skipped;
+            uint32_t triangles;
+        };
+
+        struct CullStats {
+            uint32_t visible;
+            uint32_t culled;
+        };
+
     private:
         Camera* camera;
         ShaderController* shaderController;
         BufferController* bufferController;
 
         bool isPreviewMode;
+        bool instancedRendering;
 
         std::unordered_map<BufferData::Type, GLuint> vaos;
         std::unordered_map<BufferData::Type, GLuint> vbos;
         std::unordered_map<BufferData::Type, GLuint> ebos;
-        std::unordered_map<BufferData::Type, size_t> indexCounts;
+        std::unordered_map<BufferData::Type, std::vector<BufferData::LodLevel>> lodLevels;
+        std::unordered_map<BufferData::Type, size_t> defaultLods;
+        std::unordered_map<BufferData::Type, float> boundRadii;
+
+        /* Culling */
+        Frustum frustum;
+        std::vector<size_t> visiblePlanets;
+        CullStats cullStats;
+
+        /* Lod Selection */
+        static constexpr float LOD_CULL_PIXELS = 1.0f;
+        static constexpr float LOD_EDGE_PIXELS = 8.0f;
+
+        float lodPixelScale;
+        glm::vec3 lodCameraPos;
+        LodStats lodStats;
+        uint32_t uniformUploads;
+        std::function<void(const LodStats&)> lodStatsCallback;
+
+        /* Instancing */
+        struct InstanceBatch {
+            BufferData::Type shape;
+            int lod;
+            GLuint texId;
+            std::vector<size_t> planets;
+            size_t firstInstance;
+        };
+
+        static constexpr int INSTANCE_FLOATS = 24;
+
+        std::unordered_map<BufferData::Type, GLuint> instancedVaos;
+        GLuint instanceVbo;
+        std::vector<InstanceBatch> instanceBatches;
+        std::vector<float> instanceData;
         
         void set(BufferData::Type type);
+        const BufferData::LodLevel& getLod(BufferData::Type type);
+        const BufferData::LodLevel& getLod(BufferData::Type type, int lod);
+        void beginLodFrame();
+        int selectLod(size_t index);
+        void recordLod(BufferData::Type type, int lod);
+        void endLodFrame();
+        void setInstanced(BufferData::Type type);
+        void bindInstanceAttributes(size_t firstInstance);
+
+        void updateVisibility();
+        void renderPlanets();
+        void renderInstanced();
+        void renderPreviewPlanet();
         
     public:
         Buffers(
@@ -31,21 +99,36 @@ class Buffers {
         ~Buffers();
 
         std::vector<PlanetBuffer> planetBuffers;
+        OrbitalState orbitalState;
         PlanetBuffer previewPlanet;
 
         void setupPreviewPlanet(const PlanetData& data);
         void updatePreviewPlanet(const PlanetData& data);
+        void setPreviewShape(BufferData::Type type);
         void cleanupPreviewPlanet();
         bool hasPreviewPlanet() const {
             return !previewPlanet.data.name.empty();
         }
 
         void createBufferForPlanet(const PlanetBuffer& planetBuffer);
+        void addPlanet(PlanetBuffer&& planetBuffer);
+        void removePlanet(size_t index);
         void clearBuffers();
 
         void setPreviewMode(bool preview);
         bool isInPreviewMode() const;
 
+        void setInstancedRendering(bool instanced);
+        bool isInstancedRendering() const;
+
+        void setCamera(Camera* camera);
+
+        const std::vector<size_t>& getVisiblePlanets() const;
+        const CullStats& getCullStats() const;
+
+        void setLodStatsCallback(std::function<void(const LodStats&)> callback);
+        const LodStats& getLodStats() const;
+
         void render();
         void init();
 };
\ No newline at end of file
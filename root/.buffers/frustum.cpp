@@ -0,0 +1,37 @@
+#include "frustum.h"
+
+Frustum::Frustum() {
+    for(auto& plane : planes) plane = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+/*
+** Extract Planes
+*/
+void Frustum::extract(const glm::mat4& viewProjection) {
+    glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+    glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+    glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+    glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+    planes[0] = row3 + row0;
+    planes[1] = row3 - row0;
+    planes[2] = row3 + row1;
+    planes[3] = row3 - row1;
+    planes[4] = row3 + row2;
+    planes[5] = row3 - row2;
+
+    for(auto& plane : planes) {
+        float length = glm::length(glm::vec3(plane));
+        if(length > 0.0f) plane /= length;
+    }
+}
+
+/*
+** Contains Sphere
+*/
+bool Frustum::containsSphere(const glm::vec3& center, float radius) const {
+    for(const auto& plane : planes) {
+        if(glm::dot(glm::vec3(plane), center) + plane.w < -radius) return false;
+    }
+    return true;
+}
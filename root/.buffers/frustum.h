@@ -0,0 +1,13 @@
+#pragma once
+#include <glm/glm.hpp>
+
+class Frustum {
+    private:
+        glm::vec4 planes[6];
+
+    public:
+        Frustum();
+
+        void extract(const glm::mat4& viewProjection);
+        bool containsSphere(const glm::vec3& center, float radius) const;
+};
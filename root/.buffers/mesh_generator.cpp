@@ -0,0 +1,391 @@
+#include "mesh_generator.h"
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+namespace {
+    struct WeldKey {
+        int32_t v[BufferData::VERTEX_STRIDE];
+
+        bool operator==(const WeldKey& other) const {
+            for(size_t i = 0; i < BufferData::VERTEX_STRIDE; i++) {
+                if(v[i] != other.v[i]) return false;
+            }
+            return true;
+        }
+    };
+
+    struct WeldKeyHash {
+        size_t operator()(const WeldKey& key) const {
+            uint64_t h = 1469598103934665603ull;
+            for(size_t i = 0; i < BufferData::VERTEX_STRIDE; i++) {
+                h ^= static_cast<uint32_t>(key.v[i]);
+                h *= 1099511628211ull;
+            }
+            return static_cast<size_t>(h);
+        }
+    };
+
+    const float WELD_SCALE = 100000.0f;
+    const float PI = 3.14159265358979323846f;
+
+    void pushVertex(std::vector<float>& vertices, const glm::vec3& p, float u, float v) {
+        vertices.push_back(p.x);
+        vertices.push_back(p.y);
+        vertices.push_back(p.z);
+        vertices.push_back(u);
+        vertices.push_back(v);
+    }
+
+    GLuint copyVertex(std::vector<float>& vertices, GLuint index, float u) {
+        const float* src = &vertices[index * BufferData::VERTEX_STRIDE];
+        GLuint copy = static_cast<GLuint>(vertices.size() / BufferData::VERTEX_STRIDE);
+        pushVertex(vertices, glm::vec3(src[0], src[1], src[2]), u, src[4]);
+        return copy;
+    }
+
+    /*
+     * Equirectangular UVs on the unit-diameter sphere. Points on the
+     * seam (x < 0, z = 0) start at u = 0 so only the triangles east of
+     * it need copies
+     */
+    void sphereUvs(std::vector<float>& vertices) {
+        const size_t stride = BufferData::VERTEX_STRIDE;
+        for(size_t i = 0; i < vertices.size(); i += stride) {
+            const float* p = &vertices[i];
+            float u = 0.5f + std::atan2(p[2], p[0]) / (2.0f * PI);
+            if(p[0] < 0.0f && std::fabs(p[2]) * WELD_SCALE < 0.5f) u = 0.0f;
+            vertices[i + 3] = u;
+            vertices[i + 4] = 0.5f + std::asin(glm::clamp(p[1] * 2.0f, -1.0f, 1.0f)) / PI;
+        }
+    }
+
+    /*
+     * Triangles spanning the seam get copies of their western vertices
+     * at u + 1. Where the seam runs along edges those are seam points,
+     * which land exactly on u = 1
+     */
+    void splitSeam(std::vector<float>& vertices, std::vector<GLuint>& triangles) {
+        const size_t stride = BufferData::VERTEX_STRIDE;
+        std::unordered_map<GLuint, GLuint> seamCopies;
+        for(size_t i = 0; i < triangles.size(); i += 3) {
+            float us[3];
+            for(size_t k = 0; k < 3; k++) us[k] = vertices[triangles[i + k] * stride + 3];
+            float minU = std::min(us[0], std::min(us[1], us[2]));
+            float maxU = std::max(us[0], std::max(us[1], us[2]));
+            if(maxU - minU <= 0.5f) continue;
+
+            for(size_t k = 0; k < 3; k++) {
+                GLuint index = triangles[i + k];
+                if(us[k] >= 0.5f) continue;
+
+                auto it = seamCopies.find(index);
+                if(it == seamCopies.end()) {
+                    it = seamCopies.emplace(index, copyVertex(vertices, index, us[k] + 1.0f)).first;
+                }
+                triangles[i + k] = it->second;
+            }
+        }
+    }
+
+    /*
+     * A vertex on a pole has no longitude; each triangle gets its own
+     * copy at the mean u of its other two vertices
+     */
+    void splitPoles(std::vector<float>& vertices, std::vector<GLuint>& triangles) {
+        const size_t stride = BufferData::VERTEX_STRIDE;
+        for(size_t i = 0; i < triangles.size(); i += 3) {
+            for(size_t k = 0; k < 3; k++) {
+                const float* p = &vertices[triangles[i + k] * stride];
+                if(std::fabs(p[0]) * WELD_SCALE >= 0.5f || std::fabs(p[2]) * WELD_SCALE >= 0.5f) continue;
+
+                float u = 0.5f * (
+                    vertices[triangles[i + (k + 1) % 3] * stride + 3] +
+                    vertices[triangles[i + (k + 2) % 3] * stride + 3]
+                );
+                triangles[i + k] = copyVertex(vertices, triangles[i + k], u);
+            }
+        }
+    }
+}
+
+/*
+** Weld
+*/
+void MeshGenerator::weld(std::vector<float>& vertices, std::vector<GLuint>& indices) {
+    const size_t stride = BufferData::VERTEX_STRIDE;
+    const size_t vertexCount = vertices.size() / stride;
+
+    std::unordered_map<WeldKey, GLuint, WeldKeyHash> unique;
+    unique.reserve(vertexCount);
+    std::vector<GLuint> remap(vertexCount);
+    std::vector<float> welded;
+    welded.reserve(vertices.size());
+
+    for(size_t i = 0; i < vertexCount; i++) {
+        WeldKey key;
+        for(size_t c = 0; c < stride; c++) {
+            key.v[c] = static_cast<int32_t>(std::lround(vertices[i * stride + c] * WELD_SCALE));
+        }
+
+        auto it = unique.find(key);
+        if(it != unique.end()) {
+            remap[i] = it->second;
+            continue;
+        }
+
+        GLuint newIndex = static_cast<GLuint>(welded.size() / stride);
+        welded.insert(
+            welded.end(), 
+            vertices.begin() + i * stride, 
+            vertices.begin() + (i + 1) * stride
+        );
+        unique.emplace(key, newIndex);
+        remap[i] = newIndex;
+    }
+
+    for(auto& index : indices) {
+        index = remap[index];
+    }
+    vertices.swap(welded);
+}
+
+/*
+** Cube Sphere
+**
+** Equirectangular UVs, as on the icosphere, so vertices shared by two
+** faces weld into one. With an even subdivision count the seam and the
+** poles fall on grid vertices and are the only points split.
+*/
+BufferData::MeshData MeshGenerator::cubeSphere(int subdivisions) {
+    if(subdivisions < 1) subdivisions = 1;
+
+    std::vector<float> vertices;
+    std::vector<GLuint> indices;
+
+    const glm::vec3 cubeVertices[8] = {
+        { -0.5f, -0.5f, -0.5f },
+        { 0.5f, -0.5f, -0.5f },
+        { 0.5f, 0.5f, -0.5f },
+        { -0.5f, 0.5f, -0.5f },
+        { -0.5f, -0.5f, 0.5f },
+        { 0.5f, -0.5f, 0.5f },
+        { 0.5f, 0.5f, 0.5f },
+        { -0.5f, 0.5f, 0.5f }
+    };
+    const GLuint cubeFaces[6][4] = {
+        { 0, 1, 2, 3 },
+        { 5, 4, 7, 6 },
+        { 4, 0, 3, 7 },
+        { 1, 5, 6, 2 },
+        { 3, 2, 6, 7 },
+        { 4, 5, 1, 0 }
+    };
+
+    const int verticesPerFace = (subdivisions + 1) * (subdivisions + 1);
+    vertices.reserve(6 * verticesPerFace * BufferData::VERTEX_STRIDE);
+    indices.reserve(6 * subdivisions * subdivisions * 6);
+
+    for(int face = 0; face < 6; ++face) {
+        glm::vec3 v0 = cubeVertices[cubeFaces[face][0]];
+        glm::vec3 v1 = cubeVertices[cubeFaces[face][1]];
+        glm::vec3 v2 = cubeVertices[cubeFaces[face][2]];
+        glm::vec3 v3 = cubeVertices[cubeFaces[face][3]];
+
+        for(int y = 0; y <= subdivisions; ++y) {
+            float fy = static_cast<float>(y) / subdivisions;
+            glm::vec3 a = glm::mix(v0, v3, fy);
+            glm::vec3 b = glm::mix(v1, v2, fy);
+
+            for(int x = 0; x <= subdivisions; ++x) {
+                float fx = static_cast<float>(x) / subdivisions;
+                glm::vec3 point = glm::normalize(glm::mix(a, b, fx)) * 0.5f;
+                pushVertex(vertices, point, 0.0f, 0.0f);
+            }
+        }
+
+        int baseVertex = face * verticesPerFace;
+        for(int y = 0; y < subdivisions; ++y) {
+            for(int x = 0; x < subdivisions; ++x) {
+                GLuint i0 = baseVertex + y * (subdivisions + 1) + x;
+                GLuint i1 = i0 + 1;
+                GLuint i2 = baseVertex + (y + 1) * (subdivisions + 1) + x;
+                GLuint i3 = i2 + 1;
+
+                indices.push_back(i0);
+                indices.push_back(i2);
+                indices.push_back(i1);
+
+                indices.push_back(i1);
+                indices.push_back(i2);
+                indices.push_back(i3);
+            }
+        }
+    }
+
+    /* Faces share their edge vertices before UVs split the seam */
+    weld(vertices, indices);
+    sphereUvs(vertices);
+    splitSeam(vertices, indices);
+    splitPoles(vertices, indices);
+
+    BufferData::MeshData mesh(
+        vertices,
+        indices,
+        glm::vec3(-0.5f, -0.5f, -0.5f),
+        glm::vec3(0.5f, 0.5f, 0.5f)
+    );
+    mesh.lods[0].subdivisions = subdivisions;
+    return mesh;
+}
+
+/*
+** Icosphere
+*/
+BufferData::MeshData MeshGenerator::icosphere(int subdivisions) {
+    if(subdivisions < 0) subdivisions = 0;
+
+    const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;
+    std::vector<glm::vec3> positions = {
+        { -1.0f, t, 0.0f }, { 1.0f, t, 0.0f }, { -1.0f, -t, 0.0f }, { 1.0f, -t, 0.0f },
+        { 0.0f, -1.0f, t }, { 0.0f, 1.0f, t }, { 0.0f, -1.0f, -t }, { 0.0f, 1.0f, -t },
+        { t, 0.0f, -1.0f }, { t, 0.0f, 1.0f }, { -t, 0.0f, -1.0f }, { -t, 0.0f, 1.0f }
+    };
+    std::vector<GLuint> triangles = {
+        0, 11, 5,   0, 5, 1,    0, 1, 7,    0, 7, 10,   0, 10, 11,
+        1, 5, 9,    5, 11, 4,   11, 10, 2,  10, 7, 6,   7, 1, 8,
+        3, 9, 4,    3, 4, 2,    3, 2, 6,    3, 6, 8,    3, 8, 9,
+        4, 9, 5,    2, 4, 11,   6, 2, 10,   8, 6, 7,    9, 8, 1
+    };
+    for(auto& p : positions) {
+        p = glm::normalize(p) * 0.5f;
+    }
+
+    /* Subdivide */
+    for(int level = 0; level < subdivisions; level++) {
+        std::unordered_map<uint64_t, GLuint> midpoints;
+        std::vector<GLuint> next;
+        next.reserve(triangles.size() * 4);
+
+        auto midpoint = [&](GLuint a, GLuint b) -> GLuint {
+            uint64_t key = a < b ?
+                (static_cast<uint64_t>(a) << 32) | b :
+                (static_cast<uint64_t>(b) << 32) | a;
+            auto it = midpoints.find(key);
+            if(it != midpoints.end()) return it->second;
+
+            positions.push_back(glm::normalize(positions[a] + positions[b]) * 0.5f);
+            GLuint index = static_cast<GLuint>(positions.size() - 1);
+            midpoints.emplace(key, index);
+            return index;
+        };
+
+        for(size_t i = 0; i < triangles.size(); i += 3) {
+            GLuint a = triangles[i];
+            GLuint b = triangles[i + 1];
+            GLuint c = triangles[i + 2];
+            GLuint ab = midpoint(a, b);
+            GLuint bc = midpoint(b, c);
+            GLuint ca = midpoint(c, a);
+
+            next.insert(next.end(), { a, ab, ca });
+            next.insert(next.end(), { b, bc, ab });
+            next.insert(next.end(), { c, ca, bc });
+            next.insert(next.end(), { ab, bc, ca });
+        }
+        triangles.swap(next);
+    }
+
+    /* UVs */
+    std::vector<float> vertices;
+    vertices.reserve(positions.size() * BufferData::VERTEX_STRIDE);
+    for(const auto& p : positions) {
+        pushVertex(vertices, p, 0.0f, 0.0f);
+    }
+    sphereUvs(vertices);
+    splitSeam(vertices, triangles);
+
+    BufferData::MeshData mesh(
+        vertices,
+        triangles,
+        glm::vec3(-0.5f, -0.5f, -0.5f),
+        glm::vec3(0.5f, 0.5f, 0.5f)
+    );
+    mesh.lods[0].subdivisions = subdivisions;
+    return mesh;
+}
+
+/*
+** Lod Chain
+*/
+BufferData::MeshData MeshGenerator::lodChain(
+    const std::vector<BufferData::MeshData>& levels,
+    const std::vector<int>& subdivisions,
+    size_t defaultLod
+) {
+    std::vector<float> vertices;
+    std::vector<GLuint> indices;
+    std::vector<BufferData::LodLevel> lods;
+    glm::vec3 minBounds(0.0f);
+    glm::vec3 maxBounds(0.0f);
+
+    size_t vertexTotal = 0;
+    size_t indexTotal = 0;
+    for(const auto& level : levels) {
+        vertexTotal += level.vertices.size();
+        indexTotal += level.indices.size();
+    }
+    vertices.reserve(vertexTotal);
+    indices.reserve(indexTotal);
+
+    for(size_t i = 0; i < levels.size(); i++) {
+        const auto& level = levels[i];
+        GLuint baseVertex = static_cast<GLuint>(vertices.size() / BufferData::VERTEX_STRIDE);
+
+        BufferData::LodLevel lod;
+        lod.subdivisions = i < subdivisions.size() ? subdivisions[i] : 0;
+        lod.indexOffset = indices.size();
+        lod.indexCount = level.indices.size();
+        lod.vertexCount = level.vertices.size() / BufferData::VERTEX_STRIDE;
+        lods.push_back(lod);
+
+        vertices.insert(vertices.end(), level.vertices.begin(), level.vertices.end());
+        for(GLuint index : level.indices) {
+            indices.push_back(baseVertex + index);
+        }
+
+        minBounds = i == 0 ? level.minBounds : glm::min(minBounds, level.minBounds);
+        maxBounds = i == 0 ? level.maxBounds : glm::max(maxBounds, level.maxBounds);
+    }
+
+    BufferData::MeshData mesh(vertices, indices, minBounds, maxBounds);
+    if(!lods.empty()) {
+        mesh.lods = lods;
+        mesh.defaultLod = defaultLod < lods.size() ? defaultLod : lods.size() - 1;
+    }
+    return mesh;
+}
+
+BufferData::MeshData MeshGenerator::cubeSphereLodChain(
+    const std::vector<int>& subdivisions,
+    size_t defaultLod
+) {
+    std::vector<BufferData::MeshData> levels;
+    levels.reserve(subdivisions.size());
+    for(int s : subdivisions) {
+        levels.push_back(cubeSphere(s));
+    }
+    return lodChain(levels, subdivisions, defaultLod);
+}
+
+BufferData::MeshData MeshGenerator::icosphereLodChain(
+    const std::vector<int>& subdivisions,
+    size_t defaultLod
+) {
+    std::vector<BufferData::MeshData> levels;
+    levels.reserve(subdivisions.size());
+    for(int s : subdivisions) {
+        levels.push_back(icosphere(s));
+    }
+    return lodChain(levels, subdivisions, defaultLod);
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+#include "buffer_data.h"
+#include <vector>
+
+class MeshGenerator {
+    public:
+        static BufferData::MeshData cubeSphere(int subdivisions);
+        static BufferData::MeshData icosphere(int subdivisions);
+
+        static BufferData::MeshData lodChain(
+            const std::vector<BufferData::MeshData>& levels,
+            const std::vector<int>& subdivisions,
+            size_t defaultLod
+        );
+        static BufferData::MeshData cubeSphereLodChain(
+            const std::vector<int>& subdivisions,
+            size_t defaultLod
+        );
+        static BufferData::MeshData icosphereLodChain(
+            const std::vector<int>& subdivisions,
+            size_t defaultLod
+        );
+
+        static void weld(std::vector<float>& vertices, std::vector<GLuint>& indices);
+};
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "orbital_kernel.h"
+#include "../.preset/preset_data.h"
+#include <cmath>
+
+#if defined(ORBITAL_KERNEL_WASM)
+    #include <wasm_simd128.h>
+#elif defined(ORBITAL_KERNEL_SSE)
+    #include <emmintrin.h>
+#endif
+
+/*
+** Scalar Reference
+*/
+void OrbitalKernel::advanceScalar(const Spin& spin, size_t count, float spinStep, float orbitStep) {
+    for(size_t i = 0; i < count; i++) {
+        float step = spin.speedItself[i] * spinStep;
+        spin.rotX[i] = fmod(spin.rotX[i] + (spin.axis[i] == RotationAxis::X ? step : 0.0f), 360.0f);
+        spin.rotY[i] = fmod(spin.rotY[i] + (spin.axis[i] == RotationAxis::Y ? step : 0.0f), 360.0f);
+        spin.rotZ[i] = fmod(spin.rotZ[i] + (spin.axis[i] == RotationAxis::Z ? step : 0.0f), 360.0f);
+        spin.angle[i] = fmod(
+            spin.angle[i] + (spin.orbiting[i] ? spin.speedCenter[i] * orbitStep : 0.0f), 
+            360.0f
+        );
+    }
+}
+
+void OrbitalKernel::positionsScalar(const Orbit& orbit, size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        float radians = orbit.angle[i] * 0.017453292519943295f;
+        orbit.x[i] = orbit.radius[i] * cos(radians);
+        orbit.y[i] = 0.0f;
+        orbit.z[i] = orbit.radius[i] * sin(radians);
+    }
+}
+
+#if ORBITAL_KERNEL_SIMD
+/*
+** Lane Helpers
+*/
+namespace {
+#if defined(ORBITAL_KERNEL_WASM)
+    typedef v128_t f4;
+
+    inline f4 load(const float* p) { return wasm_v128_load(p); }
+    inline void store(float* p, f4 v) { wasm_v128_store(p, v); }
+    inline f4 splat(float v) { return wasm_f32x4_splat(v); }
+    inline f4 add(f4 a, f4 b) { return wasm_f32x4_add(a, b); }
+    inline f4 sub(f4 a, f4 b) { return wasm_f32x4_sub(a, b); }
+    inline f4 mul(f4 a, f4 b) { return wasm_f32x4_mul(a, b); }
+    inline f4 div(f4 a, f4 b) { return wasm_f32x4_div(a, b); }
+    inline f4 trunc(f4 v) { return wasm_f32x4_trunc(v); }
+    inline f4 nearest(f4 v) { return wasm_f32x4_nearest(v); }
+    inline f4 greater(f4 a, f4 b) { return wasm_f32x4_gt(a, b); }
+    inline f4 less(f4 a, f4 b) { return wasm_f32x4_lt(a, b); }
+    inline f4 mask(f4 m, f4 v) { return wasm_v128_and(m, v); }
+    inline f4 select(f4 m, f4 a, f4 b) { return wasm_v128_bitselect(a, b, m); }
+    inline f4 equalsByte(const uint8_t* p, int value) {
+        return wasm_i32x4_eq(wasm_i32x4_make(p[0], p[1], p[2], p[3]), wasm_i32x4_splat(value));
+    }
+#else
+    typedef __m128 f4;
+
+    inline f4 load(const float* p) { return _mm_loadu_ps(p); }
+    inline void store(float* p, f4 v) { _mm_storeu_ps(p, v); }
+    inline f4 splat(float v) { return _mm_set1_ps(v); }
+    inline f4 add(f4 a, f4 b) { return _mm_add_ps(a, b); }
+    inline f4 sub(f4 a, f4 b) { return _mm_sub_ps(a, b); }
+    inline f4 mul(f4 a, f4 b) { return _mm_mul_ps(a, b); }
+    inline f4 div(f4 a, f4 b) { return _mm_div_ps(a, b); }
+    inline f4 trunc(f4 v) { return _mm_cvtepi32_ps(_mm_cvttps_epi32(v)); }
+    inline f4 nearest(f4 v) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(v)); }
+    inline f4 greater(f4 a, f4 b) { return _mm_cmpgt_ps(a, b); }
+    inline f4 less(f4 a, f4 b) { return _mm_cmplt_ps(a, b); }
+    inline f4 mask(f4 m, f4 v) { return _mm_and_ps(m, v); }
+    inline f4 select(f4 m, f4 a, f4 b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    inline f4 equalsByte(const uint8_t* p, int value) {
+        __m128i lanes = _mm_setr_epi32(p[0], p[1], p[2], p[3]);
+        return _mm_castsi128_ps(_mm_cmpeq_epi32(lanes, _mm_set1_epi32(value)));
+    }
+#endif
+
+    /* fmod(x, 360) for |x| < 2^31 * 360, truncating toward zero like fmod */
+    inline f4 wrapDegrees(f4 x) {
+        const f4 full = splat(360.0f);
+        return sub(x, mul(trunc(div(x, full)), full));
+    }
+
+    /* sin(2 * pi * t), folded to [-1/4, 1/4] turn and evaluated as an odd Taylor polynomial */
+    inline f4 sinTurns(f4 t) {
+        t = sub(t, nearest(t));
+        t = select(greater(t, splat(0.25f)), sub(splat(0.5f), t), t);
+        t = select(less(t, splat(-0.25f)), sub(splat(-0.5f), t), t);
+
+        f4 x = mul(t, splat(6.28318530717958647692f));
+        f4 x2 = mul(x, x);
+        f4 p = splat(-2.5052108385441718775e-8f);
+        p = add(mul(p, x2), splat(2.7557319223985890653e-6f));
+        p = add(mul(p, x2), splat(-1.9841269841269841270e-4f));
+        p = add(mul(p, x2), splat(8.3333333333333333333e-3f));
+        p = add(mul(p, x2), splat(-1.6666666666666666667e-1f));
+        p = add(mul(p, x2), splat(1.0f));
+        return mul(p, x);
+    }
+}
+
+/*
+** SIMD
+*/
+void OrbitalKernel::advanceSimd(const Spin& spin, size_t count, float spinStep, float orbitStep) {
+    const f4 spinStep4 = splat(spinStep);
+    const f4 orbitStep4 = splat(orbitStep);
+
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        f4 step = mul(load(spin.speedItself + i), spinStep4);
+        f4 orbit = mul(load(spin.speedCenter + i), orbitStep4);
+
+        f4 rotX = add(load(spin.rotX + i), mask(equalsByte(spin.axis + i, RotationAxis::X), step));
+        f4 rotY = add(load(spin.rotY + i), mask(equalsByte(spin.axis + i, RotationAxis::Y), step));
+        f4 rotZ = add(load(spin.rotZ + i), mask(equalsByte(spin.axis + i, RotationAxis::Z), step));
+        f4 angle = add(load(spin.angle + i), select(equalsByte(spin.orbiting + i, 0), splat(0.0f), orbit));
+
+        store(spin.rotX + i, wrapDegrees(rotX));
+        store(spin.rotY + i, wrapDegrees(rotY));
+        store(spin.rotZ + i, wrapDegrees(rotZ));
+        store(spin.angle + i, wrapDegrees(angle));
+    }
+    if(i < count) {
+        Spin tail = {
+            spin.speedItself + i, spin.speedCenter + i,
+            spin.axis + i, spin.orbiting + i,
+            spin.rotX + i, spin.rotY + i, spin.rotZ + i,
+            spin.angle + i
+        };
+        advanceScalar(tail, count - i, spinStep, orbitStep);
+    }
+}
+
+void OrbitalKernel::positionsSimd(const Orbit& orbit, size_t count) {
+    const f4 toTurns = splat(1.0f / 360.0f);
+    const f4 quarter = splat(0.25f);
+    const f4 zero = splat(0.0f);
+
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        f4 turns = mul(load(orbit.angle + i), toTurns);
+        f4 radius = load(orbit.radius + i);
+        store(orbit.x + i, mul(radius, sinTurns(add(turns, quarter))));
+        store(orbit.y + i, zero);
+        store(orbit.z + i, mul(radius, sinTurns(turns)));
+    }
+    if(i < count) {
+        Orbit tail = {
+            orbit.angle + i, orbit.radius + i,
+            orbit.x + i, orbit.y + i, orbit.z + i
+        };
+        positionsScalar(tail, count - i);
+    }
+}
+#else
+void OrbitalKernel::advanceSimd(const Spin& spin, size_t count, float spinStep, float orbitStep) {
+    advanceScalar(spin, count, spinStep, orbitStep);
+}
+
+void OrbitalKernel::positionsSimd(const Orbit& orbit, size_t count) {
+    positionsScalar(orbit, count);
+}
+#endif
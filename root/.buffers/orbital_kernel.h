@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__wasm_simd128__)
+    #define ORBITAL_KERNEL_SIMD 1
+    #define ORBITAL_KERNEL_WASM 1
+#elif defined(__SSE2__) || defined(_M_X64)
+    #define ORBITAL_KERNEL_SIMD 1
+    #define ORBITAL_KERNEL_SSE 1
+#else
+    #define ORBITAL_KERNEL_SIMD 0
+#endif
+
+/*
+** Spin/orbit update kernels over the OrbitalState arrays. The scalar
+** versions are the reference; the SIMD versions step four bodies at a
+** time (wasm SIMD128 under Emscripten, SSE2 natively) and use a
+** polynomial sin/cos accurate to ~1e-7 over a full turn.
+*/
+class OrbitalKernel {
+    public:
+        struct Spin {
+            const float* speedItself;
+            const float* speedCenter;
+            const uint8_t* axis;
+            const uint8_t* orbiting;
+            float* rotX;
+            float* rotY;
+            float* rotZ;
+            float* angle;
+        };
+
+        struct Orbit {
+            const float* angle;
+            const float* radius;
+            float* x;
+            float* y;
+            float* z;
+        };
+
+        static void advanceScalar(const Spin& spin, size_t count, float spinStep, float orbitStep);
+        static void advanceSimd(const Spin& spin, size_t count, float spinStep, float orbitStep);
+        static void positionsScalar(const Orbit& orbit, size_t count);
+        static void positionsSimd(const Orbit& orbit, size_t count);
+
+        static bool hasSimd() { return ORBITAL_KERNEL_SIMD != 0; }
+};
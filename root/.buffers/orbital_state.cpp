@@ -0,0 +1,111 @@
+#include "orbital_state.h"
+#include <cmath>
+
+/*
+** Storage
+*/
+void OrbitalState::reserve(size_t count) {
+    rotationSpeedItself.reserve(count);
+    rotationSpeedCenter.reserve(count);
+    rotationAxis.reserve(count);
+    orbiting.reserve(count);
+    rotationX.reserve(count);
+    rotationY.reserve(count);
+    rotationZ.reserve(count);
+    orbitAngle.reserve(count);
+    distanceFromCenter.reserve(count);
+    worldX.reserve(count);
+    worldY.reserve(count);
+    worldZ.reserve(count);
+}
+
+void OrbitalState::push(const PlanetData& data) {
+    rotationSpeedItself.push_back(data.rotationSpeedItself);
+    rotationSpeedCenter.push_back(data.rotationSpeedCenter);
+    rotationAxis.push_back(static_cast<uint8_t>(data.rotationDir));
+    orbiting.push_back(data.position != 0 ? 1 : 0);
+    rotationX.push_back(data.currentRotation.x);
+    rotationY.push_back(data.currentRotation.y);
+    rotationZ.push_back(data.currentRotation.z);
+    orbitAngle.push_back(data.orbitAngle.y);
+    distanceFromCenter.push_back(data.distanceFromCenter);
+
+    float angle = glm::radians(data.orbitAngle.y);
+    worldX.push_back(data.distanceFromCenter * cos(angle));
+    worldY.push_back(0.0f);
+    worldZ.push_back(data.distanceFromCenter * sin(angle));
+}
+
+void OrbitalState::erase(size_t index) {
+    if(index >= size()) return;
+
+    rotationSpeedItself.erase(rotationSpeedItself.begin() + index);
+    rotationSpeedCenter.erase(rotationSpeedCenter.begin() + index);
+    rotationAxis.erase(rotationAxis.begin() + index);
+    orbiting.erase(orbiting.begin() + index);
+    rotationX.erase(rotationX.begin() + index);
+    rotationY.erase(rotationY.begin() + index);
+    rotationZ.erase(rotationZ.begin() + index);
+    orbitAngle.erase(orbitAngle.begin() + index);
+    distanceFromCenter.erase(distanceFromCenter.begin() + index);
+    worldX.erase(worldX.begin() + index);
+    worldY.erase(worldY.begin() + index);
+    worldZ.erase(worldZ.begin() + index);
+}
+
+void OrbitalState::clear() {
+    rotationSpeedItself.clear();
+    rotationSpeedCenter.clear();
+    rotationAxis.clear();
+    orbiting.clear();
+    rotationX.clear();
+    rotationY.clear();
+    rotationZ.clear();
+    orbitAngle.clear();
+    distanceFromCenter.clear();
+    worldX.clear();
+    worldY.clear();
+    worldZ.clear();
+}
+
+/*
+** Kernels
+*/
+OrbitalKernel::Spin OrbitalState::spinView() {
+    return {
+        rotationSpeedItself.data(),
+        rotationSpeedCenter.data(),
+        rotationAxis.data(),
+        orbiting.data(),
+        rotationX.data(),
+        rotationY.data(),
+        rotationZ.data(),
+        orbitAngle.data()
+    };
+}
+
+OrbitalKernel::Orbit OrbitalState::orbitView() {
+    return {
+        orbitAngle.data(),
+        distanceFromCenter.data(),
+        worldX.data(),
+        worldY.data(),
+        worldZ.data()
+    };
+}
+
+void OrbitalState::advance(float spinStep, float orbitStep) {
+    if(useSimd) {
+        OrbitalKernel::advanceSimd(spinView(), size(), spinStep, orbitStep);
+    } else {
+        OrbitalKernel::advanceScalar(spinView(), size(), spinStep, orbitStep);
+    }
+}
+
+void OrbitalState::updatePositions() {
+    if(useSimd) {
+        OrbitalKernel::positionsSimd(orbitView(), size());
+    } else {
+        OrbitalKernel::positionsScalar(orbitView(), size());
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "../.preset/preset_data.h"
+#include "orbital_kernel.h"
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+/*
+** Hot per-frame simulation fields, stored as parallel arrays and
+** kept index-aligned with Buffers::planetBuffers.
+*/
+class OrbitalState {
+    public:
+        std::vector<float> rotationSpeedItself;
+        std::vector<float> rotationSpeedCenter;
+        std::vector<uint8_t> rotationAxis;
+        std::vector<uint8_t> orbiting;
+
+        std::vector<float> rotationX;
+        std::vector<float> rotationY;
+        std::vector<float> rotationZ;
+        std::vector<float> orbitAngle;
+        std::vector<float> distanceFromCenter;
+
+        std::vector<float> worldX;
+        std::vector<float> worldY;
+        std::vector<float> worldZ;
+
+        bool useSimd = OrbitalKernel::hasSimd();
+
+        size_t size() const { return rotationSpeedItself.size(); }
+        void reserve(size_t count);
+        void push(const PlanetData& data);
+        void erase(size_t index);
+        void clear();
+
+        OrbitalKernel::Spin spinView();
+        OrbitalKernel::Orbit orbitView();
+
+        void advance(float spinStep, float orbitStep);
+        void updatePositions();
+
+        glm::vec3 getWorldPos(size_t index) const {
+            return glm::vec3(worldX[index], worldY[index], worldZ[index]);
+        }
+        glm::vec3 getRotation(size_t index) const {
+            return glm::vec3(rotationX[index], rotationY[index], rotationZ[index]);
+        }
+};
@@ -0,0 +1,239 @@
+#include "ray_intersection.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+/*
+** Screen Ray
+*/
+glm::vec3 RayIntersection::screenRay(
+    double mouseX,
+    double mouseY,
+    int viewportWidth,
+    int viewportHeight,
+    float fov,
+    const glm::vec3& position,
+    const glm::vec3& target,
+    const glm::vec3& up
+) {
+    float x = (2.0f * mouseX) / viewportWidth - 1.0f;
+    float y = 1.0f - (2.0f * mouseY) / viewportHeight;
+
+    glm::vec4 rayClip = glm::vec4(x, y, -1.0f, 1.0f);
+    
+    glm::mat4 projMatrix = glm::perspective(
+        glm::radians(fov),
+        (float)viewportWidth / (float)viewportHeight,
+        0.1f,
+        100.0f
+    );
+    
+    glm::mat4 invProj = glm::inverse(projMatrix);
+    glm::vec4 rayEye = invProj * rayClip;
+    rayEye = glm::vec4(rayEye.x, rayEye.y, -1.0f, 0.0f);
+    glm::mat4 view = glm::lookAt(position, target, up);
+    glm::mat4 invView = glm::inverse(view);
+
+    glm::vec4 rayWorld4 = invView * rayEye;
+    return glm::normalize(glm::vec3(rayWorld4));
+}
+
+/*
+** Test
+*/
+bool RayIntersection::test(
+    const glm::vec3& rayOrigin,
+    const glm::vec3& rayDir,
+    const glm::vec3& planetPosition,
+    float planetSize,
+    BufferData::Type shapeType
+) {
+    switch(shapeType) {
+        case BufferData::Type::SPHERE:
+            return sphere(rayOrigin, rayDir, planetPosition, planetSize);
+        case BufferData::Type::CUBE:
+            return cube(rayOrigin, rayDir, planetPosition, planetSize);
+        case BufferData::Type::TRIANGLE:
+            return triangle(rayOrigin, rayDir, planetPosition, planetSize);
+        default:
+            return mesh(rayOrigin, rayDir, planetPosition, planetSize, shapeType);
+    }
+}
+
+/*
+**
+*** Intersection
+**
+*/
+bool RayIntersection::sphere(
+    const glm::vec3& rayOrigin,
+    const glm::vec3& rayWorldDir,
+    const glm::vec3& planetPosition,
+    float planetSize
+) {
+    glm::vec3 sphereCenter = planetPosition;
+    float sphereRadius = planetSize;
+
+    glm::vec3 oc = rayOrigin - sphereCenter;
+    float a = glm::dot(rayWorldDir, rayWorldDir);
+    float b = 2.0f * glm::dot(oc, rayWorldDir);
+    float c = glm::dot(oc, oc) - sphereRadius * sphereRadius;
+
+    float discriminant = b * b - 4.0f * a * c;
+    return discriminant >= 0;
+}
+
+bool RayIntersection::cube(
+    const glm::vec3& rayOrigin,
+    const glm::vec3& rayWorldDir,
+    const glm::vec3& planetPosition,
+    float planetSize
+) {
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, planetPosition);
+    model = glm::scale(model, glm::vec3(planetSize * 2.0f));
+
+    glm::mat4 invModel = glm::inverse(model);
+    glm::vec3 localRayOrigin = glm::vec3(invModel * glm::vec4(rayOrigin, 1.0f));
+    glm::vec3 localRayDir = glm::vec3(invModel * glm::vec4(rayWorldDir, 0.0f));
+
+    glm::vec3 aabbMin = glm::vec3(-0.5f, -0.5f, -0.5f);
+    glm::vec3 aabbMax = glm::vec3(0.5f, 0.5f, 0.5f);
+    
+    glm::vec3 invDir = 1.0f / localRayDir;
+    glm::vec3 t0 = (aabbMin - localRayOrigin) * invDir;
+    glm::vec3 t1 = (aabbMax - localRayOrigin) * invDir;
+
+    glm::vec3 tmin = glm::min(t0, t1);
+    glm::vec3 tmax = glm::max(t0, t1);
+
+    float tminMax = glm::max(glm::max(tmin.x, tmin.y), tmin.z);
+    float tmaxMin = glm::min(glm::min(tmax.x, tmax.y), tmax.z);
+    
+    return tmaxMin >= tminMax && tmaxMin > 0;
+}
+
+bool RayIntersection::triangle(
+    const glm::vec3& rayOrigin,
+    const glm::vec3& rayWorldDir,
+    const glm::vec3& planetPosition,
+    float planetSize
+) {
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, planetPosition);
+    model = glm::scale(model, glm::vec3(planetSize * 2.0f));
+
+    glm::mat4 invModel = glm::inverse(model);
+    glm::vec3 localRayOrigin = glm::vec3(invModel * glm::vec4(rayOrigin, 1.0f));
+    glm::vec3 localRayDir = glm::vec3(invModel * glm::vec4(rayWorldDir, 0.0f));
+    localRayDir = glm::normalize(localRayDir);
+
+    glm::vec3 v0 = glm::vec3(-0.3f, -0.3f, -0.3f);
+    glm::vec3 v1 = glm::vec3(0.3f, -0.3f, -0.3f);
+    glm::vec3 v2 = glm::vec3(0.3f, -0.3f, 0.3f);
+    glm::vec3 v3 = glm::vec3(-0.3f, -0.3f, 0.3f);
+    glm::vec3 v4 = glm::vec3(0.0f, 0.3f, 0.0f);
+
+    glm::vec3 triangles[6][3] = {
+        {v4, v0, v1},
+        {v4, v1, v2},
+        {v4, v2, v3},
+        {v4, v3, v0}, 
+        {v0, v1, v2},
+        {v0, v2, v3}
+    };
+    for(int i = 0; i < 6; i++) {
+        if(rayTriangle(
+            localRayOrigin,
+            localRayDir,
+            triangles[i][0],
+            triangles[i][1],
+            triangles[i][2]
+        )) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool RayIntersection::mesh(
+    const glm::vec3& rayOrigin,
+    const glm::vec3& rayWorldDir,
+    const glm::vec3& planetPosition,
+    float planetSize,
+    BufferData::Type shapeType
+) {
+    const BufferData::MeshData& meshData = BufferData::GetMeshData(shapeType);
+    const std::vector<float>& vertices = meshData.vertices;
+    const std::vector<GLuint>& indices = meshData.indices;
+
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, planetPosition);
+    model = glm::scale(model, glm::vec3(planetSize));
+
+    glm::mat4 invModel = glm::inverse(model);
+    glm::vec3 localRayOrigin = glm::vec3(invModel * glm::vec4(rayOrigin, 1.0f));
+    glm::vec3 localRayDir = glm::vec3(invModel * glm::vec4(rayWorldDir, 0.0f));
+    localRayDir = glm::normalize(localRayDir);
+
+    const BufferData::LodLevel& lod = meshData.getDefaultLod();
+    const size_t stride = BufferData::VERTEX_STRIDE;
+    for(size_t i = lod.indexOffset; i < lod.indexOffset + lod.indexCount; i += 3) {
+        GLuint i0 = indices[i];
+        GLuint i1 = indices[i + 1];
+        GLuint i2 = indices[i + 2];
+        
+        glm::vec3 v0 = glm::vec3(
+            vertices[i0 * stride],
+            vertices[i0 * stride + 1],
+            vertices[i0 * stride + 2]
+        );
+        glm::vec3 v1 = glm::vec3(
+            vertices[i1 * stride],
+            vertices[i1 * stride + 1],
+            vertices[i1 * stride + 2]
+        );
+        glm::vec3 v2 = glm::vec3(
+            vertices[i2 * stride],
+            vertices[i2 * stride + 1],
+            vertices[i2 * stride + 2]
+        );
+        if(rayTriangle(
+            localRayOrigin, 
+            localRayDir, 
+            v0, v1, v2)
+        ) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool RayIntersection::rayTriangle(
+    const glm::vec3& rayOrigin,
+    const glm::vec3& rayDir,
+    const glm::vec3& v0,
+    const glm::vec3& v1,
+    const glm::vec3& v2
+) {
+    const float EPSILON = 0.0000001f;
+
+    glm::vec3 edge1 = v1 - v0;
+    glm::vec3 edge2 = v2 - v0;
+    glm::vec3 h = glm::cross(rayDir, edge2);
+
+    float a = glm::dot(edge1, h);
+    if(a > -EPSILON && a < EPSILON) return false;
+
+    float f = 1.0f / a;
+    glm::vec3 s = rayOrigin - v0;
+    float u = f * glm::dot(s, h);
+    if(u < 0.0f || u > 1.0f) return false;
+
+    glm::vec3 q = glm::cross(s, edge1);
+    float v = f * glm::dot(rayDir, q);
+    if(v < 0.0f || u + v > 1.0f) return false;
+
+    float t = f * glm::dot(edge2, q);
+    return t > EPSILON;
+}
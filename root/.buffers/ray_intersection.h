@@ -0,0 +1,62 @@
+#pragma once
+#include <glm/glm.hpp>
+#include "buffer_data.h"
+
+/*
+** Pure ray/shape tests used by the Raycaster. No camera or GL state,
+** so it builds into the native core.
+*/
+class RayIntersection {
+    public:
+        static glm::vec3 screenRay(
+            double mouseX,
+            double mouseY,
+            int viewportWidth,
+            int viewportHeight,
+            float fov,
+            const glm::vec3& position,
+            const glm::vec3& target,
+            const glm::vec3& up
+        );
+
+        static bool test(
+            const glm::vec3& rayOrigin,
+            const glm::vec3& rayDir,
+            const glm::vec3& planetPosition,
+            float planetSize,
+            BufferData::Type shapeType
+        );
+
+        static bool sphere(
+            const glm::vec3& rayOrigin,
+            const glm::vec3& rayDir,
+            const glm::vec3& planetPosition,
+            float planetSize
+        );
+        static bool cube(
+            const glm::vec3& rayOrigin,
+            const glm::vec3& rayDir,
+            const glm::vec3& planetPosition,
+            float planetSize
+        );
+        static bool triangle(
+            const glm::vec3& rayOrigin,
+            const glm::vec3& rayDir,
+            const glm::vec3& planetPosition,
+            float planetSize
+        );
+        static bool mesh(
+            const glm::vec3& rayOrigin,
+            const glm::vec3& rayDir,
+            const glm::vec3& planetPosition,
+            float planetSize,
+            BufferData::Type shapeType
+        );
+        static bool rayTriangle(
+            const glm::vec3& rayOrigin,
+            const glm::vec3& rayDir,
+            const glm::vec3& v0,
+            const glm::vec3& v1,
+            const glm::vec3& v2
+        );
+};
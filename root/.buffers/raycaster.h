@@ -67,33 +67,4 @@ class Raycaster {
         }
         int getSelectedPlanetIndex() const { return selectedPlanetIndex; }
         void clearSelection() { selectedPlanetIndex = -1; }
-
-        bool sphereIntersection(
-            glm::vec3 rayWorldDir,
-            const glm::vec3& planetPosition,
-            float planetSize
-        );
-        bool cubeIntersection(
-            glm::vec3 rayWorldDir,
-            const glm::vec3& planetPosition,
-            float planetSize
-        );
-        bool triangleIntersection(
-            glm::vec3 rayWorldDir,
-            const glm::vec3& planetPosition,
-            float planetSize
-        );
-        bool meshIntersection(
-            glm::vec3 rayWorldDir,
-            const glm::vec3& planetPosition,
-            float planetSize,
-            BufferData::Type shapeType
-        );
-        bool rayTriangleIntersection(
-            const glm::vec3& rayOrigin,
-            const glm::vec3& rayDir,
-            const glm::vec3& v0,
-            const glm::vec3& v1,
-            const glm::vec3& v2
-        );
 };
\ No newline at end of file
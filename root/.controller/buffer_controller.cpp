@@ -1,7 +1,10 @@
 #include "buffer_controller.h"
 #include "../.buffers/buffers.h"
 #include "preview_controller.h"
+#include "../_data/asset_cache.h"
 #include "../_utils/color_converter.h"
+#include "../_utils/profiler.h"
+#include "../_platform/platform.h"
 #include <iostream>
 
 BufferController::BufferController(
@@ -16,6 +19,8 @@ BufferController::BufferController(
     presetManager(nullptr),
     buffers(nullptr),
     raycaster(nullptr),
+    defaultData(nullptr),
+    textureLoader(nullptr),
     selectedPlanetIndex(-1),
     presetLoaded(false)
 {};
@@ -66,7 +71,7 @@ void BufferController::initTextureLoader() {
 ** Preset
 */
 void BufferController::setDefaultData() {
-    defaultData = new DefaultData(presetManager);
+    defaultData = new DefaultData();
     defaultData->init();
 }
 void BufferController::setPresetPath() {
@@ -74,13 +79,14 @@ void BufferController::setPresetPath() {
     presetManager->getPresetLoader()->setPath(path);
 }
 
-PresetData BufferController::getCurrentPreset() const {
+const PresetData& BufferController::getCurrentPreset() const {
     return currentPreset;
 }
 
 void BufferController::onPresetImported(const PresetData& preset) {
     PresetData presetCopy = preset;
     loadPresetData(presetCopy);
+    presetManager->getPresetSaver()->markReplaced();
 }
 
 /*
@@ -124,7 +130,7 @@ void BufferController::setDataToUpdate(PlanetData& uData, const DataParser::Valu
 
     uData.texture = 
         pData.hasKey("texture") ? 
-        pData["texture"].asString() : 
+        TextureRegistry::get().intern(pData["texture"].asString()) : 
         dData.texture;
 
     if(pData.hasKey("rotationDir")) {
@@ -158,33 +164,27 @@ void BufferController::setDataToUpdate(PlanetData& uData, const DataParser::Valu
 ** Update Planet Positions
 */
 void BufferController::updatePlanetPositions() {
-    for(auto& planet : buffers->planetBuffers) {
-        float orbitRadius = planet.data.distanceFromCenter;
-        float orbitAngle = planet.data.orbitAngle.y;
-        planet.worldPos = glm::vec3(
-            orbitRadius * cos(glm::radians(orbitAngle)),
-            0.0f,
-            orbitRadius * sin(glm::radians(orbitAngle))
-        );
-    }
+    buffers->orbitalState.updatePositions();
 }
 
 /*
 ** Check Planet Intersections
 */
 int BufferController::checkPlanetIntersections(double mouseX, double mouseY) {
+    PROFILE_ZONE(RAYCAST);
     if(!raycaster || buffers->planetBuffers.empty()) {
         selectedPlanetIndex = -1;
         return -1;
     }
     selectedPlanetIndex = -1;
 
-    for(int i = 0; i < buffers->planetBuffers.size(); i++) {
+    for(size_t i : buffers->getVisiblePlanets()) {
+        if(i >= buffers->planetBuffers.size()) continue;
         auto& planet = buffers->planetBuffers[i];
         if(raycaster->checkIntersection(
             mouseX, mouseY,
             main->width, main->height,
-            planet.worldPos,
+            buffers->orbitalState.getWorldPos(i),
             planet.data.size,
             i,
             planet.data.shape
@@ -209,7 +209,7 @@ void BufferController::handleRaycasterRender(double mouseX, double mouseY) {
         raycaster->render(
             mouseX,
             mouseY,
-            planet.worldPos,
+            buffers->orbitalState.getWorldPos(hoveredPlanetIndex),
             planet.data.size,
             hoveredPlanetIndex,
             planet.data.shape
@@ -223,15 +223,16 @@ void BufferController::handleRaycasterClick(double mouseX, double mouseY) {
     int clickedPlanetIndex = checkPlanetIntersections(mouseX, mouseY);
     if(clickedPlanetIndex != -1) {
         auto& planet = buffers->planetBuffers[clickedPlanetIndex];
+        glm::vec3 planetPosition = buffers->orbitalState.getWorldPos(clickedPlanetIndex);
         if(raycaster->handleClick(
             mouseX, mouseY,
             main->width, main->height,
-            planet.worldPos,
+            planetPosition,
             planet.data.size,
             clickedPlanetIndex,
             planet.data.shape
         )) {
-            camera->zoomToObj(planet.worldPos, planet.data.size);
+            camera->zoomToObj(planetPosition, planet.data.size);
         }
     }
 }
@@ -264,6 +265,7 @@ int BufferController::getSelectedPlanetIndex() const {
 
 void BufferController::setCamera(Camera* cam) {
     camera = cam;
+    if(buffers) buffers->setCamera(camera);
     if(camera && buffers && shaderLoader) {
         if (raycaster) {
             delete raycaster;
@@ -290,6 +292,8 @@ void BufferController::clearBuffers() {
         raycaster->setIsIntersecting(false);
         raycaster->selectedPlanetIndex = -1;
     }
+    presetManager->getPresetSaver()->markReplaced();
+    releaseUnusedTextures();
 }
 
 void BufferController::deleteSelectedPlanet() {
@@ -299,15 +303,14 @@ void BufferController::deleteSelectedPlanet() {
 
     if(selectedPlanetIndex < buffers->planetBuffers.size()) {
         std::string planetName = buffers->planetBuffers[selectedPlanetIndex].data.name;
-        buffers->planetBuffers.erase(
-            buffers->planetBuffers.begin() + selectedPlanetIndex
-        );
+        buffers->removePlanet(selectedPlanetIndex);
     }
     if(selectedPlanetIndex < currentPreset.planets.size()) {
         std::string planetName = currentPreset.planets[selectedPlanetIndex].name;
         currentPreset.planets.erase(
             currentPreset.planets.begin() + selectedPlanetIndex
         );
+        presetManager->getPresetSaver()->markRemoved(selectedPlanetIndex);
     }
     if(presetManager->getPresetLoader() && 
        selectedPlanetIndex < presetManager->getPresetLoader()->getCurrentPreset().planets.size()) {
@@ -323,6 +326,7 @@ void BufferController::deleteSelectedPlanet() {
         raycaster->selectedPlanetIndex = -1;
         raycaster->setIsIntersecting(false);
     }
+    releaseUnusedTextures();
 }
 
 bool BufferController::isPreviewActive() const {
@@ -341,26 +345,45 @@ void BufferController::loadPresetData(PresetData& preset) {
         presetManager->getPresetLoader()->setCurrentPreset(preset);
     }
     if(buffers) {
-        buffers->planetBuffers.clear();
         buffers->clearBuffers();
     }
 
     std::vector<PlanetBuffer> newPlanetBuffers = bufferGenerator->generateFromPreset(currentPreset);
     for(auto& planetBuffer : newPlanetBuffers) {
-        float orbitRadius = planetBuffer.data.distanceFromCenter;
-        float initialAngle = planetBuffer.data.orbitAngle.y;
-        
-        glm::vec3 planetPosition(
-            orbitRadius * cos(glm::radians(initialAngle)),
-            0.0f,
-            orbitRadius * sin(glm::radians(initialAngle))
-        );
-        planetBuffer.worldPos = planetPosition;
         planetBuffer.isPreview = false;
+        buffers->addPlanet(std::move(planetBuffer));
+    }
+    releaseUnusedTextures();
+}
 
-        buffers->createBufferForPlanet(planetBuffer);
-        buffers->planetBuffers.push_back(std::move(planetBuffer));
+/*
+** Release Unused Textures
+**
+** Frees registry sources and textures no planet, preset, cached
+** preset, default or pending load refers to anymore. Runs after planets are removed or
+** the preset is replaced.
+*/
+void BufferController::releaseUnusedTextures() {
+    std::unordered_set<TextureRegistry::Handle> live;
+    for(const auto& planet : currentPreset.planets) live.insert(planet.texture);
+    for(const auto& planetBuffer : planetBuffers) live.insert(planetBuffer.data.texture);
+    if(presetManager && presetManager->getPresetLoader()) {
+        for(const auto& planet : presetManager->getPresetLoader()->getCurrentPreset().planets) {
+            live.insert(planet.texture);
+        }
+    }
+    if(buffers) {
+        for(const auto& planetBuffer : buffers->planetBuffers) live.insert(planetBuffer.data.texture);
+        live.insert(buffers->previewPlanet.data.texture);
     }
+    if(defaultData) {
+        for(const auto& data : defaultData->getAllData()) live.insert(data.texture);
+    }
+    AssetCache::get().collectTextures(live);
+    if(textureLoader) textureLoader->collectPending(live);
+
+    std::vector<TextureRegistry::Handle> freed = TextureRegistry::get().sweep(live);
+    if(textureLoader && !freed.empty()) textureLoader->release(freed);
 }
 
 TextureLoader* BufferController::getTextureLoader() {
@@ -377,27 +400,22 @@ void BufferController::render(float deltaTime) {
             presetLoaded = true;
 
             std::vector<PlanetBuffer> newPlanetBuffers = bufferGenerator->generateFromPreset(currentPreset);
-            buffers->planetBuffers.clear();
+            buffers->clearBuffers();
             for(auto& planetBuffer : newPlanetBuffers) {
-                float orbitRadius = planetBuffer.data.distanceFromCenter;
-                float initialAngle = planetBuffer.data.orbitAngle.y;
-                
-                glm::vec3 planetPosition(
-                    orbitRadius * cos(glm::radians(initialAngle)),
-                    0.0f,
-                    orbitRadius * sin(glm::radians(initialAngle))
-                );
-                planetBuffer.worldPos = planetPosition;
                 planetBuffer.isPreview = false;
-                buffers->createBufferForPlanet(planetBuffer);
-                buffers->planetBuffers.push_back(std::move(planetBuffer));
+                buffers->addPlanet(std::move(planetBuffer));
             }
         } else {
             printf("ERR failed to load preset!\n");
             return;
         }
     }
-    bufferGenerator->updatePlanetRotation(buffers->planetBuffers, deltaTime);
-    updatePlanetPositions();
+    {
+        PROFILE_ZONE(SIMULATION);
+        bufferGenerator->updatePlanetRotation(buffers->orbitalState, deltaTime);
+        updatePlanetPositions();
+    }
+    presetManager->getPresetSaver()->update(Platform::now());
+    textureLoader->update();
     buffers->render();
 }
\ No newline at end of file
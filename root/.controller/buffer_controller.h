@@ -61,8 +61,9 @@ class BufferController {
         const PlanetBuffer* getSelectedPlanet() const;
         int getSelectedPlanetIndex() const;
         void deleteSelectedPlanet();
-        PresetData getCurrentPreset() const;
+        const PresetData& getCurrentPreset() const;
         void onPresetImported(const PresetData& preset);
+        void releaseUnusedTextures();
 
         TextureLoader* getTextureLoader();
 
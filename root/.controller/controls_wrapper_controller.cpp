@@ -1,5 +1,6 @@
 #include "controls_wrapper_controller.h"
 #include "buffer_controller.h"
+#include "../.buffers/buffers.h"
 #include <iostream>
 
 BufferController* g_bufferController = nullptr;
@@ -99,7 +100,7 @@ extern "C" {
         if(g_bufferController && g_bufferController->presetManager) {
             PresetExporter* exporter = g_bufferController->presetManager->getPresetExporter();
             if(exporter) {
-                PresetData currentPreset = g_bufferController->getCurrentPreset();
+                const PresetData& currentPreset = g_bufferController->getCurrentPreset();
                 exporter->exportPreset(currentPreset);
             }
         }
@@ -127,4 +128,30 @@ extern "C" {
             g_bufferController->clearBuffers();
         }
     }
+
+    /*
+     * Instanced Rendering
+     */
+    void setInstancedRendering(int enabled) {
+        if(g_bufferController && g_bufferController->buffers) {
+            g_bufferController->buffers->setInstancedRendering(enabled != 0);
+            std::cout << "Instanced rendering " << (enabled ? "enabled" : "disabled") << std::endl;
+        }
+    }
+
+    /*
+     * Lod Stats
+     */
+    const uint32_t* getLodStats() {
+        if(!g_bufferController || !g_bufferController->buffers) return nullptr;
+        return reinterpret_cast<const uint32_t*>(&g_bufferController->buffers->getLodStats());
+    }
+
+    /*
+     * Cull Stats
+     */
+    const uint32_t* getCullStats() {
+        if(!g_bufferController || !g_bufferController->buffers) return nullptr;
+        return reinterpret_cast<const uint32_t*>(&g_bufferController->buffers->getCullStats());
+    }
 }
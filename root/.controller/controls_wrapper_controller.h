@@ -1,5 +1,6 @@
 #pragma once
 #include <emscripten.h>
+#include <cstdint>
 
 class BufferController;
 class ControlsWrapperController {
@@ -22,6 +23,9 @@ extern "C" {
     void EMSCRIPTEN_KEEPALIVE onResetToDefault();
     void EMSCRIPTEN_KEEPALIVE onClear();
     void EMSCRIPTEN_KEEPALIVE appendToDOM(const char* html);
+    void EMSCRIPTEN_KEEPALIVE setInstancedRendering(int enabled);
+    const uint32_t* EMSCRIPTEN_KEEPALIVE getLodStats();
+    const uint32_t* EMSCRIPTEN_KEEPALIVE getCullStats();
 #ifdef __cplusplus
 }
 #endif
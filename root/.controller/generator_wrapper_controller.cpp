@@ -7,6 +7,7 @@
 #include "preview_controller.h"
 #include "../.buffers/buffers.h"
 #include "../_utils/color_converter.h"
+#include "../_utils/profiler.h"
 #include <iostream>
 #include <sstream>
 
@@ -81,6 +82,7 @@ extern "C" {
      * Update Preview
      */
     void updatePreviewPlanet(const char* data) {
+        PROFILE_ZONE(PREVIEW);
         if(!g_generatorWrapperController) {
             printf("ERROR: g_generatorWrapperController is null!\n");
             return;
@@ -99,10 +101,6 @@ extern "C" {
             auto planetData = DataParser::Parser::parse(dataStr);
             PlanetData previewPlanetData;
 
-            g_generatorWrapperController->
-                bufferController->
-                    defaultData->init();
-        
             g_generatorWrapperController->
                 bufferController->
                     setDataToUpdate(previewPlanetData, planetData);
@@ -118,6 +116,19 @@ extern "C" {
         }
     }
 
+    /*
+     * Update Preview from a packed struct, no string or parse on the
+     * way. Returns 0 when the caller should fall back to the JSON path.
+     */
+    int updatePreviewPacket(const PreviewPlanetPacket* packet) {
+        PROFILE_ZONE(PREVIEW);
+        if(!packet || !g_generatorWrapperController) return 0;
+
+        return g_generatorWrapperController->
+            bufferController->
+            previewController->updatePreview(*packet) ? 1 : 0;
+    }
+
     /*
      * Cleanup Preview
      */
@@ -163,10 +174,6 @@ extern "C" {
             auto data = DataParser::Parser::parse(str);
             PlanetData newPlanet;
 
-            g_generatorWrapperController->
-                bufferController->
-                    defaultData->init();
-        
             g_generatorWrapperController->
                 bufferController->
                     setDataToUpdate(newPlanet, data);
@@ -198,29 +205,20 @@ extern "C" {
             }
 
             preset.planets.push_back(newPlanet);
-            g_generatorWrapperController->bufferController->currentPreset.planets.push_back(newPlanet);
+            auto& currentPlanets = g_generatorWrapperController->bufferController->currentPreset.planets;
+            currentPlanets.push_back(newPlanet);
+            g_generatorWrapperController->
+                bufferController->
+                presetManager->
+                getPresetSaver()->markAdded(currentPlanets.size() - 1, newPlanet);
             
             PlanetBuffer newPlanetBuffer;
             newPlanetBuffer.data = newPlanet;
             newPlanetBuffer.isPreview = false;
 
-            float orbitRadius = newPlanet.distanceFromCenter;
-            float initialAngle = newPlanet.orbitAngle.y;
-            glm::vec3 planetPosition(
-                orbitRadius * cos(glm::radians(initialAngle)),
-                0.0f,
-                orbitRadius * sin(glm::radians(initialAngle))
-            );
-            newPlanetBuffer.worldPos = planetPosition;
-
-            g_generatorWrapperController->
-                bufferController->
-                buffers->createBufferForPlanet(newPlanetBuffer);
-            
             g_generatorWrapperController->
                 bufferController->
-                buffers->
-                planetBuffers.push_back(std::move(newPlanetBuffer));
+                buffers->addPlanet(std::move(newPlanetBuffer));
 
 
             printf("Generated planet: %s at position %d\n", newPlanet.name.c_str(), newPlanet.position);
@@ -259,7 +257,7 @@ extern "C" {
         str << "\"g\":" << defaultData.colorRgb.g << ",";
         str << "\"b\":" << defaultData.colorRgb.b;
         str << "},";
-         str << "\"texture\":\"" << defaultData.texture << "\",";
+        str << "\"texture\":\"" << TextureRegistry::get().source(defaultData.texture) << "\",";
         str << "\"position\":" << defaultData.position << ",";
         str << "\"rotationDir\":\"" << (defaultData.rotationDir == RotationAxis::X ? "X" : 
                                        defaultData.rotationDir == RotationAxis::Y ? "Y" : "Z") << "\",";
@@ -294,19 +292,50 @@ extern "C" {
             printf("ERROR: Texture loader not available\n");
             return;
         }
-        std::string texName(name);
-        std::string dataStr(data);
-
-        GLuint texId = textureLoader->loadTexture(
-            texName,
-            dataStr,
+        bool queued = textureLoader->loadTexture(
+            name,
+            data,
             width,
             height
         );
-        if(texId != 0) {
-            printf("Texture uploaded successfully: %s (%dx%d)\n", name, width, height);
+        if(queued) {
+            printf("Texture queued for decode: %s\n", name);
         } else {
             printf("Failed to upload texture: %s\n", name);
         }
     }
+
+    /*
+     * Chunked Texture Upload
+     */
+    static TextureLoader* getUploadTextureLoader() {
+        if(!g_generatorWrapperController || !g_generatorWrapperController->bufferController) {
+            printf("ERROR: Generator wrapper controller or buffer controller not initialized\n");
+            return nullptr;
+        }
+        return g_generatorWrapperController->bufferController->getTextureLoader();
+    }
+
+    void beginTextureUpload(const char* name, int width, int height) {
+        TextureLoader* textureLoader = getUploadTextureLoader();
+        if(!textureLoader || !name) {
+            printf("ERROR: Invalid texture parameters\n");
+            return;
+        }
+        textureLoader->beginUpload(name, width, height);
+    }
+
+    int appendTextureUpload(const char* chunk) {
+        TextureLoader* textureLoader = getUploadTextureLoader();
+        if(!textureLoader || !chunk) return 0;
+        return textureLoader->appendUpload(chunk) ? 1 : 0;
+    }
+
+    int finishTextureUpload() {
+        TextureLoader* textureLoader = getUploadTextureLoader();
+        if(!textureLoader) return 0;
+        bool queued = textureLoader->finishUpload();
+        if(!queued) printf("Failed to upload texture\n");
+        return queued ? 1 : 0;
+    }
 }
\ No newline at end of file
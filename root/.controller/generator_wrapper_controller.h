@@ -1,6 +1,7 @@
 #pragma once
 #include <emscripten/html5.h>
 
+struct PreviewPlanetPacket;
 class PresetLoader;
 class BufferController;
 class GeneratorWrapperController {
@@ -21,6 +22,7 @@ extern "C" {
     void EMSCRIPTEN_KEEPALIVE appendGeneratorToDOM(const char* html);
     void EMSCRIPTEN_KEEPALIVE startGeneratorPreview();
     void EMSCRIPTEN_KEEPALIVE updatePreviewPlanet(const char* data);
+    int EMSCRIPTEN_KEEPALIVE updatePreviewPacket(const PreviewPlanetPacket* packet);
     void EMSCRIPTEN_KEEPALIVE cleanupPreview();
     void EMSCRIPTEN_KEEPALIVE hideGenerator();
     void EMSCRIPTEN_KEEPALIVE generatePlanetParser(const char* planetData);
@@ -31,6 +33,9 @@ extern "C" {
         int width,
         int height
     );
+    void EMSCRIPTEN_KEEPALIVE beginTextureUpload(const char* name, int width, int height);
+    int EMSCRIPTEN_KEEPALIVE appendTextureUpload(const char* chunk);
+    int EMSCRIPTEN_KEEPALIVE finishTextureUpload();
     void EMSCRIPTEN_KEEPALIVE showGenerator();
 #ifdef __cplusplus
 }
@@ -4,6 +4,9 @@
 #include <iostream>
 #include "../camera.h"
 #include "buffer_controller.h"
+#include "../_utils/profiler.h"
+#include "../_utils/texture_loader.h"
+#include <algorithm>
 
 InfoWrapperController* g_infoWrapperController = nullptr;
 
@@ -75,4 +78,32 @@ extern "C" {
             } 
         });
     }
+
+    /*
+     * Frame Stats
+     */
+    const float* getFrameStats() {
+        const Profiler::Stats& stats = Profiler::get().computeStats();
+        return reinterpret_cast<const float*>(&stats);
+    }
+
+    /*
+     * Texture Upload Stats
+     */
+    const uint32_t* getTextureStats() {
+        if(!g_infoWrapperController || !g_infoWrapperController->bufferController) return nullptr;
+        TextureLoader* textureLoader = g_infoWrapperController->bufferController->getTextureLoader();
+        if(!textureLoader) return nullptr;
+        return reinterpret_cast<const uint32_t*>(&textureLoader->getUploadStats());
+    }
+
+    /*
+     * Texture Upload Budget, 0 for no limit
+     */
+    void setTextureUploadBudget(int kilobytes) {
+        if(!g_infoWrapperController || !g_infoWrapperController->bufferController) return;
+        TextureLoader* textureLoader = g_infoWrapperController->bufferController->getTextureLoader();
+        if(!textureLoader) return;
+        textureLoader->setUploadBudget(static_cast<size_t>(std::max(kilobytes, 0)) << 10);
+    }
 }
\ No newline at end of file
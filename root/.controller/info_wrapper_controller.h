@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <emscripten/html5.h>
 
 class Camera;
@@ -19,6 +20,9 @@ extern "C" {
     void EMSCRIPTEN_KEEPALIVE closeMenu();
     void EMSCRIPTEN_KEEPALIVE deletePlanet();
     void EMSCRIPTEN_KEEPALIVE display(const char* name, const char* info);
+    const float* EMSCRIPTEN_KEEPALIVE getFrameStats();
+    const uint32_t* EMSCRIPTEN_KEEPALIVE getTextureStats();
+    void EMSCRIPTEN_KEEPALIVE setTextureUploadBudget(int kilobytes);
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -112,6 +112,36 @@ void PreviewController::updatePreview(const PlanetData& data) {
     bufferController->buffers->updatePreviewPlanet(previewData);
 }
 
+/*
+ * Edits the preview planet in place. Name, texture and the color text
+ * stay with the JSON path; the preview draws from colorRgb.
+ */
+bool PreviewController::updatePreview(const PreviewPlanetPacket& packet) {
+    if(!isGeneratorActive) return false;
+    if(!bufferController || !bufferController->buffers) return false;
+    Buffers* buffers = bufferController->buffers;
+    if(!buffers->hasPreviewPlanet()) return false;
+
+    if(
+        packet.shape < 0 || packet.shape > static_cast<int32_t>(BufferData::Type::SPHERE) ||
+        packet.rotationDir < 0 || packet.rotationDir > RotationAxis::Z
+    ) {
+        return false;
+    }
+
+    PlanetData& data = buffers->previewPlanet.data;
+    data.size = packet.size;
+    data.colorRgb = glm::vec3(packet.colorRgb[0], packet.colorRgb[1], packet.colorRgb[2]);
+    data.rotationDir = static_cast<RotationAxis>(packet.rotationDir);
+    data.rotationSpeedItself = packet.rotationSpeedItself;
+    data.rotationSpeedCenter = packet.rotationSpeedCenter;
+    data.position = packet.position;
+
+    BufferData::Type shape = static_cast<BufferData::Type>(packet.shape);
+    if(shape != data.shape) buffers->setPreviewShape(shape);
+    return true;
+}
+
 /*
 ** Cleanup Preview
 */
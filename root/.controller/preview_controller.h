@@ -1,6 +1,22 @@
 #pragma once
 #include "../camera.h"
 #include "buffer_controller.h"
+#include <cstdint>
+
+/*
+** Typed preview update the generator UI writes straight into the wasm
+** heap. Every field is 4 bytes wide; enums use the C++ ordinals.
+*/
+struct PreviewPlanetPacket {
+    int32_t shape;
+    float size;
+    float colorRgb[3];
+    int32_t rotationDir;
+    float rotationSpeedItself;
+    float rotationSpeedCenter;
+    int32_t position;
+};
+static_assert(sizeof(PreviewPlanetPacket) == 36, "generator-controller.ts writes this layout");
 
 class PreviewController {
     private:
@@ -22,6 +38,7 @@ class PreviewController {
 
         void startGeneratorPreview();
         void updatePreview(const PlanetData& data);
+        bool updatePreview(const PreviewPlanetPacket& packet);
         void cleanupPreview();
         bool isInGeneratorMode() const { 
             return isGeneratorActive;
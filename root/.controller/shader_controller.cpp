@@ -2,6 +2,35 @@
 #include <emscripten.h>
 #include <GLES3/gl3.h>
 
+static const char* uniformNames[] = {
+    "model",
+    "view",
+    "projection",
+    "pColor",
+    "uUseTex",
+    "uTex",
+    "isHovered",
+    "uInstanced",
+    "uUvRect"
+};
+static_assert(
+    sizeof(uniformNames) / sizeof(uniformNames[0]) == static_cast<size_t>(ShaderController::Uniform::COUNT),
+    "uniformNames must match ShaderController::Uniform"
+);
+
+static const char* attribNames[] = {
+    "aPos",
+    "aTexCoord",
+    "aInstanceModel",
+    "aInstanceColor",
+    "aInstanceHover",
+    "aInstanceUvRect"
+};
+static_assert(
+    sizeof(attribNames) / sizeof(attribNames[0]) == static_cast<size_t>(ShaderController::Attrib::COUNT),
+    "attribNames must match ShaderController::Attrib"
+);
+
 void ShaderController::checkStatus() {
     GLint success;
     glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
@@ -40,4 +69,17 @@ void ShaderController::initProgram() {
     glAttachShader(shaderProgram, fragShader);
     glLinkProgram(shaderProgram);
     checkStatus();
+    resolveLocations();
+}
+
+/*
+** Resolve Locations
+*/
+void ShaderController::resolveLocations() {
+    for(size_t i = 0; i < static_cast<size_t>(Uniform::COUNT); i++) {
+        uniformLocations[i] = glGetUniformLocation(shaderProgram, uniformNames[i]);
+    }
+    for(size_t i = 0; i < static_cast<size_t>(Attrib::COUNT); i++) {
+        attribLocations[i] = glGetAttribLocation(shaderProgram, attribNames[i]);
+    }
 }
\ No newline at end of file
@@ -4,6 +4,29 @@
 
 class ShaderController {
     public:
+        enum class Uniform {
+            MODEL,
+            VIEW,
+            PROJECTION,
+            P_COLOR,
+            USE_TEX,
+            TEX,
+            IS_HOVERED,
+            INSTANCED,
+            UV_RECT,
+            COUNT
+        };
+
+        enum class Attrib {
+            POS,
+            TEX_COORD,
+            INSTANCE_MODEL,
+            INSTANCE_COLOR,
+            INSTANCE_HOVER,
+            INSTANCE_UV_RECT,
+            COUNT
+        };
+
         GLuint fragShader;
         GLuint vertexShader;
         GLuint shaderProgram;
@@ -11,4 +34,16 @@ class ShaderController {
         void checkStatus();
         void load();
         void initProgram();
+        void resolveLocations();
+
+        GLint getUniform(Uniform uniform) const {
+            return uniformLocations[static_cast<size_t>(uniform)];
+        }
+        GLint getAttrib(Attrib attrib) const {
+            return attribLocations[static_cast<size_t>(attrib)];
+        }
+
+    private:
+        GLint uniformLocations[static_cast<size_t>(Uniform::COUNT)];
+        GLint attribLocations[static_cast<size_t>(Attrib::COUNT)];
 };
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include "preset_binary.h"
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#error "PresetBinary reads records in place and assumes a little-endian host"
+#endif
+
+static_assert(sizeof(PresetBinary::Header) == 40, "Header layout changed");
+static_assert(sizeof(PresetBinary::Record) == 88, "Record layout changed");
+
+namespace {
+    constexpr char MAGIC[4] = { 'P', 'L', 'P', 'B' };
+
+    /*
+     * Appends to the string table, reusing an earlier copy of the
+     * same string; colors repeat across most presets
+     */
+    class StringTable {
+        public:
+            std::string data;
+
+            PresetBinary::StringRef add(const std::string& str) {
+                if(str.empty()) return { 0, 0 };
+                auto it = offsets.find(str);
+                if(it != offsets.end()) {
+                    return { it->second, static_cast<uint32_t>(str.size()) };
+                }
+                uint32_t offset = static_cast<uint32_t>(data.size());
+                data.append(str);
+                offsets.emplace(str, offset);
+                return { offset, static_cast<uint32_t>(str.size()) };
+            }
+
+        private:
+            std::unordered_map<std::string, uint32_t> offsets;
+    };
+
+    bool viewString(std::string_view strings, const PresetBinary::StringRef& ref, std::string_view& out) {
+        if(ref.offset > strings.size() || ref.length > strings.size() - ref.offset) {
+            return false;
+        }
+        out = strings.substr(ref.offset, ref.length);
+        return true;
+    }
+
+    bool readString(std::string_view strings, const PresetBinary::StringRef& ref, std::string& out) {
+        std::string_view view;
+        if(!viewString(strings, ref, view)) return false;
+        out.assign(view.data(), view.size());
+        return true;
+    }
+}
+
+/*
+** Detect
+*/
+bool PresetBinary::isBinary(std::string_view data) {
+    return data.size() >= sizeof(MAGIC) && memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+/*
+** Encode
+*/
+std::string PresetBinary::encode(const PresetData& preset) {
+    StringTable strings;
+    Header header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.recordSize = sizeof(Record);
+    header.planetCount = static_cast<uint32_t>(preset.planets.size());
+    header.flags = preset.isDefault ? static_cast<uint32_t>(IS_DEFAULT) : 0;
+    header.name = strings.add(preset.name);
+    header.description = strings.add(preset.description);
+
+    /* Texture sources can be whole data URLs; dedupe them by handle */
+    std::unordered_map<TextureRegistry::Handle, StringRef> textures;
+
+    size_t recordsSize = preset.planets.size() * sizeof(Record);
+    std::string out(sizeof(Header) + recordsSize, '\0');
+    char* records = &out[sizeof(Header)];
+    for(size_t i = 0; i < preset.planets.size(); i++) {
+        const PlanetData& planet = preset.planets[i];
+        Record record{};
+        record.id = planet.id;
+        record.position = planet.position;
+        record.shape = static_cast<uint8_t>(planet.shape);
+        record.rotationDir = static_cast<uint8_t>(planet.rotationDir);
+        record.size = planet.size;
+        record.rotationSpeedItself = planet.rotationSpeedItself;
+        record.rotationSpeedCenter = planet.rotationSpeedCenter;
+        record.distanceFromCenter = planet.distanceFromCenter;
+        for(int c = 0; c < 3; c++) {
+            record.colorRgb[c] = planet.colorRgb[c];
+            record.currentRotation[c] = planet.currentRotation[c];
+            record.orbitAngle[c] = planet.orbitAngle[c];
+        }
+        record.name = strings.add(planet.name);
+        record.color = strings.add(planet.color);
+        auto texture = textures.find(planet.texture);
+        if(texture == textures.end()) {
+            StringRef ref = strings.add(TextureRegistry::get().source(planet.texture));
+            texture = textures.emplace(planet.texture, ref).first;
+        }
+        record.texture = texture->second;
+        memcpy(records + i * sizeof(Record), &record, sizeof(Record));
+    }
+
+    header.stringsOffset = static_cast<uint32_t>(out.size());
+    header.stringsSize = static_cast<uint32_t>(strings.data.size());
+    memcpy(&out[0], &header, sizeof(Header));
+    out.append(strings.data);
+    return out;
+}
+
+/*
+** Decode
+*/
+bool PresetBinary::decode(std::string_view data, PresetData& preset) {
+    if(data.size() < sizeof(Header) || !isBinary(data)) {
+        std::cerr << "Invalid binary preset: bad header" << std::endl;
+        return false;
+    }
+
+    Header header;
+    memcpy(&header, data.data(), sizeof(Header));
+    if(header.version > VERSION) {
+        std::cerr << "Unsupported binary preset version: " << header.version << std::endl;
+        return false;
+    }
+    if(header.recordSize < sizeof(Record)) {
+        std::cerr << "Invalid binary preset: record size " << header.recordSize << std::endl;
+        return false;
+    }
+
+    uint64_t recordsEnd = sizeof(Header) + static_cast<uint64_t>(header.planetCount) * header.recordSize;
+    uint64_t stringsEnd = static_cast<uint64_t>(header.stringsOffset) + header.stringsSize;
+    if(recordsEnd > header.stringsOffset || stringsEnd > data.size()) {
+        std::cerr << "Invalid binary preset: truncated" << std::endl;
+        return false;
+    }
+
+    std::string_view strings = data.substr(header.stringsOffset, header.stringsSize);
+    if(!readString(strings, header.name, preset.name) ||
+        !readString(strings, header.description, preset.description)) {
+        std::cerr << "Invalid binary preset: bad string reference" << std::endl;
+        return false;
+    }
+    preset.isDefault = (header.flags & IS_DEFAULT) != 0;
+
+    const char* records = data.data() + sizeof(Header);
+    preset.planets.resize(header.planetCount);
+    for(uint32_t i = 0; i < header.planetCount; i++) {
+        Record record;
+        memcpy(&record, records + static_cast<size_t>(i) * header.recordSize, sizeof(Record));
+        if(record.shape > static_cast<uint8_t>(BufferData::Type::SPHERE) || record.rotationDir > RotationAxis::Z) {
+            std::cerr << "Invalid binary preset: bad enum in planet at index: " << i << std::endl;
+            return false;
+        }
+
+        PlanetData& planet = preset.planets[i];
+        planet.id = record.id;
+        planet.position = record.position;
+        planet.shape = static_cast<BufferData::Type>(record.shape);
+        planet.rotationDir = static_cast<RotationAxis>(record.rotationDir);
+        planet.size = record.size;
+        planet.rotationSpeedItself = record.rotationSpeedItself;
+        planet.rotationSpeedCenter = record.rotationSpeedCenter;
+        planet.distanceFromCenter = record.distanceFromCenter;
+        planet.colorRgb = glm::vec3(record.colorRgb[0], record.colorRgb[1], record.colorRgb[2]);
+        planet.currentRotation = glm::vec3(record.currentRotation[0], record.currentRotation[1], record.currentRotation[2]);
+        planet.orbitAngle = glm::vec3(record.orbitAngle[0], record.orbitAngle[1], record.orbitAngle[2]);
+        std::string_view texture;
+        if(!readString(strings, record.name, planet.name) ||
+            !readString(strings, record.color, planet.color) ||
+            !viewString(strings, record.texture, texture)) {
+            std::cerr << "Invalid binary preset: bad string reference in planet at index: " << i << std::endl;
+            return false;
+        }
+        planet.texture = TextureRegistry::get().intern(texture);
+    }
+    return true;
+}
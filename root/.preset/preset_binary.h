@@ -0,0 +1,65 @@
+#pragma once
+#include "preset_data.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/*
+** Versioned little-endian binary preset.
+**
+**   Header      40 bytes, magic "PLPB"
+**   Records     planetCount * recordSize bytes, one Record per planet
+**   Strings     names, colors and texture keys, referenced by
+**               offset/length from the start of the table
+**
+** Every field sits at a fixed offset, so a file copied or mapped into
+** memory in one go is read in place. recordSize is stored so newer
+** versions can append fields to Record without breaking older readers.
+*/
+class PresetBinary {
+    public:
+        static constexpr uint16_t VERSION = 1;
+
+        struct StringRef {
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        struct Header {
+            char magic[4];
+            uint16_t version;
+            uint16_t recordSize;
+            uint32_t planetCount;
+            uint32_t flags;
+            StringRef name;
+            StringRef description;
+            uint32_t stringsOffset;
+            uint32_t stringsSize;
+        };
+
+        struct Record {
+            uint32_t id;
+            int32_t position;
+            uint8_t shape;
+            uint8_t rotationDir;
+            uint16_t reserved;
+            float size;
+            float rotationSpeedItself;
+            float rotationSpeedCenter;
+            float distanceFromCenter;
+            float colorRgb[3];
+            float currentRotation[3];
+            float orbitAngle[3];
+            StringRef name;
+            StringRef color;
+            StringRef texture;
+        };
+
+        enum Flags : uint32_t {
+            IS_DEFAULT = 1u << 0
+        };
+
+        static bool isBinary(std::string_view data);
+        static std::string encode(const PresetData& preset);
+        static bool decode(std::string_view data, PresetData& preset);
+};
@@ -0,0 +1,271 @@
+#include "preset_converter.h"
+#include "../.buffers/buffer_generator.h"
+#include "../_utils/color_converter.h"
+#include "preset_reader.h"
+#include "preset_binary.h"
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+/*
+** Planet To Value
+*/
+DataParser::Value PresetConverter::planetToValue(const PlanetData& data) {
+    using namespace DataParser;
+    
+    std::string shapeStr = BufferGenerator::shapeToString(data.shape);
+    std::string rotationStr = BufferGenerator::rotationToString(data.rotationDir);
+    auto rgb = ColorConverter::parseColor(data.color); 
+    Value colorRgb(ValueType::Object);
+    colorRgb["r"] = Value(rgb.r);
+    colorRgb["g"] = Value(rgb.g);
+    colorRgb["b"] = Value(rgb.b);
+    
+    Value result(ValueType::Object);
+    result["id"] = Value(static_cast<double>(data.id));
+    result["name"] = Value(data.name);
+    result["size"] = Value(data.size);
+    result["color"] = Value(data.color);
+    result["colorRgb"] = colorRgb;
+    result["position"] = Value(static_cast<double>(data.position));
+    result["distanceFromCenter"] = Value(data.distanceFromCenter);
+    result["rotationSpeedItself"] = Value(data.rotationSpeedItself);
+    result["rotationSpeedCenter"] = Value(data.rotationSpeedCenter);
+    result["shape"] = Value(shapeStr);
+    result["rotationDir"] = Value(rotationStr);
+    
+    Value currentRotation(ValueType::Object);
+    currentRotation["x"] = Value(data.currentRotation.x);
+    currentRotation["y"] = Value(data.currentRotation.y);
+    currentRotation["z"] = Value(data.currentRotation.z);
+    result["currentRotation"] = currentRotation;
+    
+    Value orbitAngle(ValueType::Object);
+    orbitAngle["x"] = Value(data.orbitAngle.x);
+    orbitAngle["y"] = Value(data.orbitAngle.y);
+    orbitAngle["z"] = Value(data.orbitAngle.z);
+    result["orbitAngle"] = orbitAngle;
+    
+    return result;
+}
+
+/*
+** Shared by the Value and the arena Node paths, which expose the
+** same accessors
+*/
+template<typename T>
+static void readPlanet(const T& value, PlanetData& data) {
+    data.id = value["id"].asInt();
+    data.name = std::string(value["name"].asString());
+    data.size = value["size"].asFloat();
+    data.color = std::string(value["color"].asString());
+    data.colorRgb = ColorConverter::parseColor(data.color);
+    data.position = value["position"].asInt();
+    data.distanceFromCenter = value["distanceFromCenter"].asFloat();
+    data.rotationSpeedItself = value["rotationSpeedItself"].asFloat();
+    data.rotationSpeedCenter = value["rotationSpeedCenter"].asFloat();
+
+    data.shape = BufferGenerator::shapeToBufferType(std::string(value["shape"].asString()));
+    data.rotationDir = BufferGenerator::rotationToBufferType(std::string(value["rotationDir"].asString()));
+
+    if(value.hasKey("currentRotation")) {
+        const T& rot = value["currentRotation"];
+        data.currentRotation.x = rot["x"].asFloat();
+        data.currentRotation.y = rot["y"].asFloat();
+        data.currentRotation.z = rot["z"].asFloat();
+    }
+    
+    if(value.hasKey("orbitAngle")) {
+        const T& orbit = value["orbitAngle"];
+        data.orbitAngle.x = orbit["x"].asFloat();
+        data.orbitAngle.y = orbit["y"].asFloat();
+        data.orbitAngle.z = orbit["z"].asFloat();
+    }
+}
+
+bool PresetConverter::valueToPlanet(const DataParser::Value& value, PlanetData& data) {
+    try {
+        readPlanet(value, data);
+        return true;
+    } catch(const std::exception& err) {
+        std::cerr << "Error converting value: " << err.what() << std::endl;
+        return false;
+    }
+}
+
+bool PresetConverter::nodeToPlanet(const DataParser::Node& node, PlanetData& data) {
+    try {
+        readPlanet(node, data);
+        return true;
+    } catch(const std::exception& err) {
+        std::cerr << "Error converting value: " << err.what() << std::endl;
+        return false;
+    }
+}
+
+/*
+** Preset To Value
+*/
+DataParser::Value PresetConverter::presetToValue(const PresetData& preset) {
+    using namespace DataParser;
+
+    Value result(ValueType::Object);
+    Value planetsArray(ValueType::Array);
+    for(const auto& planet : preset.planets) {
+        planetsArray.push_back(planetToValue(planet));
+    }
+    
+    result["planets"] = planetsArray;
+    return result;
+}
+
+/*
+** Value to Preset
+*/
+bool PresetConverter::valueToPreset(const DataParser::Value& value, PresetData& preset) {
+    using namespace DataParser;
+
+    try {
+        if(!value.hasKey("planets") || !value["planets"].isArray()) {
+            std::cerr << "Invalid preset format: missing planets array" << std::endl;
+            return false;
+        }
+
+        const Value& planetsArray = value["planets"];
+        preset.planets.clear();
+        for(size_t i = 0; i < planetsArray.size(); i++) {
+            PlanetData planet;
+            if(valueToPlanet(planetsArray[i], planet)) {
+                preset.planets.push_back(planet);
+            } else {
+                std::cerr << "Failed to parse planet at index: " << i << std:: endl;
+                return false;
+            }
+        }
+
+        return true;
+    } catch(const std::exception& err) {
+        std::cerr << "Error converting value to preset: " << err.what() << std::endl;
+        return false;
+    }
+}
+
+bool PresetConverter::nodeToPreset(const DataParser::Node& node, PresetData& preset) {
+    const DataParser::Node* planets = node.find("planets");
+    if(!planets || !planets->isArray()) {
+        std::cerr << "Invalid preset format: missing planets array" << std::endl;
+        return false;
+    }
+
+    preset.planets.clear();
+    preset.planets.reserve(planets->size());
+    for(size_t i = 0; i < planets->size(); i++) {
+        PlanetData planet;
+        if(nodeToPlanet((*planets)[i], planet)) {
+            preset.planets.push_back(std::move(planet));
+        } else {
+            std::cerr << "Failed to parse planet at index: " << i << std:: endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+** Write Planet
+*/
+namespace {
+    /*
+     * Writes every planet field except texture and leaves the object
+     * open, the caller decides whether texture is a source or an index
+     */
+    void writePlanetFields(DataParser::Writer& writer, const PlanetData& data) {
+        /* colorRgb is kept in step with color wherever color is assigned */
+        const glm::vec3& rgb = data.colorRgb;
+
+        writer.startObject();
+        writer.key("id").value(data.id);
+        writer.key("name").value(data.name);
+        writer.key("size").value(data.size);
+        writer.key("color").value(data.color);
+        writer.key("colorRgb").startObject()
+            .key("r").value(rgb.r)
+            .key("g").value(rgb.g)
+            .key("b").value(rgb.b)
+            .endObject();
+        writer.key("position").value(data.position);
+        writer.key("distanceFromCenter").value(data.distanceFromCenter);
+        writer.key("rotationSpeedItself").value(data.rotationSpeedItself);
+        writer.key("rotationSpeedCenter").value(data.rotationSpeedCenter);
+        writer.key("shape").value(BufferGenerator::shapeToString(data.shape));
+        writer.key("rotationDir").value(BufferGenerator::rotationToString(data.rotationDir));
+        writer.key("currentRotation").startObject()
+            .key("x").value(data.currentRotation.x)
+            .key("y").value(data.currentRotation.y)
+            .key("z").value(data.currentRotation.z)
+            .endObject();
+        writer.key("orbitAngle").startObject()
+            .key("x").value(data.orbitAngle.x)
+            .key("y").value(data.orbitAngle.y)
+            .key("z").value(data.orbitAngle.z)
+            .endObject();
+    }
+}
+
+void PresetConverter::writePlanet(DataParser::Writer& writer, const PlanetData& data) {
+    writePlanetFields(writer, data);
+    if(data.texture != TextureRegistry::NONE) {
+        writer.key("texture").value(TextureRegistry::get().source(data.texture));
+    }
+    writer.endObject();
+}
+
+/*
+ * Textures go in a top-level table written once, planets refer to it
+ * by index so a data URL shared by many planets is not repeated
+ */
+void PresetConverter::writePreset(DataParser::Writer& writer, const PresetData& preset) {
+    std::unordered_map<TextureRegistry::Handle, uint32_t> textureIndex;
+    std::vector<TextureRegistry::Handle> textures;
+    for(const auto& planet : preset.planets) {
+        if(planet.texture == TextureRegistry::NONE) continue;
+        if(textureIndex.emplace(planet.texture, static_cast<uint32_t>(textures.size())).second) {
+            textures.push_back(planet.texture);
+        }
+    }
+
+    writer.startObject();
+    if(!textures.empty()) {
+        writer.key("textures").startArray();
+        for(TextureRegistry::Handle texture : textures) {
+            writer.value(TextureRegistry::get().source(texture));
+        }
+        writer.endArray();
+    }
+    writer.key("planets").startArray();
+    for(const auto& planet : preset.planets) {
+        writePlanetFields(writer, planet);
+        if(planet.texture != TextureRegistry::NONE) {
+            writer.key("texture").value(textureIndex[planet.texture]);
+        }
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+}
+
+std::string PresetConverter::presetToData(const PresetData& preset) {
+    /* A compact planet entry is ~330 bytes */
+    std::string data;
+    data.reserve(preset.planets.size() * 384 + 16);
+    {
+        DataParser::Writer writer(data);
+        writePreset(writer, preset);
+    }
+    return data;
+}
+
+bool PresetConverter::convertToPreset(std::string_view data, PresetData& preset) {
+    if(PresetBinary::isBinary(data)) return PresetBinary::decode(data, preset);
+    return PresetReader::read(data, preset, PresetReader::Mode::STRICT);
+}
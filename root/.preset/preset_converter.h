@@ -0,0 +1,25 @@
+#pragma once
+#include "preset_data.h"
+#include "../_data/data_parser.h"
+#include "../_data/data_document.h"
+#include "../_data/data_writer.h"
+
+/*
+** PresetData <-> DataParser::Value/JSON conversion, free of any
+** browser or controller state.
+*/
+class PresetConverter {
+    public:
+        static DataParser::Value planetToValue(const PlanetData& planet);
+        static bool valueToPlanet(const DataParser::Value& val, PlanetData& planet);
+        static DataParser::Value presetToValue(const PresetData& preset);
+        static bool valueToPreset(const DataParser::Value& val, PresetData& preset);
+        static bool nodeToPlanet(const DataParser::Node& node, PlanetData& planet);
+        static bool nodeToPreset(const DataParser::Node& node, PresetData& preset);
+
+        static void writePlanet(DataParser::Writer& writer, const PlanetData& planet);
+        static void writePreset(DataParser::Writer& writer, const PresetData& preset);
+
+        static std::string presetToData(const PresetData& preset);
+        static bool convertToPreset(std::string_view data, PresetData& preset);
+};
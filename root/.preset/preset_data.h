@@ -1,5 +1,6 @@
 #pragma once
 #include "../.buffers/buffer_data.h"
+#include "../_utils/texture_registry.h"
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -16,7 +17,7 @@ struct PlanetData {
     std::string name;
     BufferData::Type shape;
     float size;
-    std::string texture;
+    TextureRegistry::Handle texture;
     std::string color;
     glm::vec3 colorRgb;
     int position;
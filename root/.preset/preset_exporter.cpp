@@ -1,5 +1,6 @@
 #include "preset_exporter.h"
 #include "preset_manager.h"
+#include "preset_converter.h"
 #include <emscripten.h>
 #include <emscripten/html5.h>
 #include <iostream>
@@ -15,14 +16,7 @@ PresetExporter::~PresetExporter() {};
 ** Get Preset Data
 */
 std::string PresetExporter::getPresetData(const PresetData& preset) {
-    if(!presetManager || !presetManager->getPresetSaver()) {
-        std::cerr << "Preset saver not available" << std::endl;
-        return "";
-    }
-
-    return presetManager->
-        getPresetSaver()->
-        presetToData(const_cast<PresetData&>(preset));
+    return PresetConverter::presetToData(preset);
 }
 
 /*
@@ -35,12 +29,13 @@ void PresetExporter::exportPreset(const PresetData& preset) {
         return;
     }
 
-    const char* dataStr = data.c_str();
+    const char* dataStr = data.data();
     const char* fileNameStr = fileName.c_str();
 
     EM_ASM_INT({
         try {
-            const data = UTF8ToString($0);
+            /* A copy, as Blob rejects views of a shared (-pthread) heap */
+            const data = HEAPU8.slice($0, $0 + $2);
             const fileName = UTF8ToString($1);
 
             const blob = new Blob(
@@ -65,5 +60,5 @@ void PresetExporter::exportPreset(const PresetData& preset) {
             console.error('Error exporting preset!', err);
             return 0;
         }
-    }, dataStr, fileNameStr);
+    }, dataStr, fileNameStr, data.size());
 }
\ No newline at end of file
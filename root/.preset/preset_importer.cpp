@@ -1,6 +1,7 @@
 #include "preset_importer.h"
 #include "preset_manager.h"
 #include "preset_saver.h"
+#include "../_utils/profiler.h"
 #include <emscripten.h>
 #include <emscripten/html5.h>
 #include <iostream>
@@ -24,7 +25,7 @@ void PresetImporter::upload() {
     EM_ASM({
         const input = document.createElement('input');
         input.type = 'file';
-        input.accept = '.json,application/json';
+        input.accept = '.json,.preset,application/json,application/octet-stream';
         input.style.display = 'none';
 
         input.addEventListener('change', function(ev) {
@@ -34,13 +35,12 @@ void PresetImporter::upload() {
             const reader = new FileReader();
             reader.onload = function(e) {
                 try {
-                    const content = e.target.result;
+                    const content = new Uint8Array(e.target.result);
                     console.log('file loaded!');
 
-                    const contentLength = lengthBytesUTF8(content) + 1;
-                    const dataPtr = _malloc(contentLength);
-                    stringToUTF8(content, dataPtr, contentLength);
-                    Module._onFileImported(dataPtr);
+                    const dataPtr = _malloc(content.length);
+                    HEAPU8.set(content, dataPtr);
+                    Module._onFileImported(dataPtr, content.length);
                     _free(dataPtr);
                 } catch(err) {
                     console.error('Error reading file:', err);
@@ -49,7 +49,7 @@ void PresetImporter::upload() {
             reader.onerror = function(e) {
                 console.error('File reader err!', e);
             };
-            reader.readAsText(file);
+            reader.readAsArrayBuffer(file);
         });
 
         document.body.appendChild(input);
@@ -65,6 +65,7 @@ void PresetImporter::upload() {
 ** Import Preset
 */
 bool PresetImporter::import(const std::string& data) {
+    PROFILE_ZONE(PRESET_IO);
     if(!presetManager || !presetManager->getPresetSaver()) {
         std::cerr << "Preset manager or saver not available" << std::endl;
         return false;
@@ -104,12 +105,12 @@ void PresetImporter::setImportCallback(std::function<void(const PresetData&)> cb
 }
 
 extern "C" {
-    void onFileImported(const char* data) {
+    void onFileImported(const char* data, size_t size) {
         std::cout << "Import button clicked from TypeScript!" << std::endl;
         if(g_presetManager) {
             PresetImporter* importer = g_presetManager->getPresetImporter();
             if(importer && data) {
-                std::string presetData(data);
+                std::string presetData(data, size);
                 importer->import(presetData);
             }
         }
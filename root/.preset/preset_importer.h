@@ -22,7 +22,7 @@ class PresetImporter {
 #ifdef __cplusplus
 extern "C" {
 #endif
-    void EMSCRIPTEN_KEEPALIVE onFileImported(const char* data);
+    void EMSCRIPTEN_KEEPALIVE onFileImported(const char* data, size_t size);
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
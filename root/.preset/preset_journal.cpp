@@ -0,0 +1,73 @@
+#include "preset_journal.h"
+#include "preset_binary.h"
+#include <cstring>
+
+namespace {
+    constexpr size_t ENTRY_HEADER = 8;
+}
+
+/*
+** Record
+*/
+void PresetJournal::add(size_t index, const PlanetData& planet) {
+    entries.push_back({ Op::ADD, static_cast<uint32_t>(index), planet });
+}
+
+void PresetJournal::remove(size_t index) {
+    entries.push_back({ Op::REMOVE, static_cast<uint32_t>(index), PlanetData{} });
+}
+
+void PresetJournal::clear() {
+    entries.clear();
+}
+
+/*
+** Encode
+*/
+std::string PresetJournal::encode(const Entry& entry) {
+    std::string out(ENTRY_HEADER, '\0');
+    out[0] = static_cast<char>(entry.op);
+    memcpy(&out[4], &entry.index, sizeof(entry.index));
+    if(entry.op != Op::REMOVE) {
+        PresetData single;
+        single.isDefault = false;
+        single.planets.push_back(entry.planet);
+        out.append(PresetBinary::encode(single));
+    }
+    return out;
+}
+
+bool PresetJournal::decode(std::string_view data, Entry& entry) {
+    if(data.size() < ENTRY_HEADER) return false;
+
+    uint8_t op = static_cast<uint8_t>(data[0]);
+    if(op > static_cast<uint8_t>(Op::REMOVE)) return false;
+    entry.op = static_cast<Op>(op);
+    memcpy(&entry.index, data.data() + 4, sizeof(entry.index));
+    if(entry.op == Op::REMOVE) return true;
+
+    PresetData single;
+    if(!PresetBinary::decode(data.substr(ENTRY_HEADER), single) || single.planets.size() != 1) {
+        return false;
+    }
+    entry.planet = std::move(single.planets[0]);
+    return true;
+}
+
+/*
+** Apply
+*/
+bool PresetJournal::apply(const Entry& entry, PresetData& preset) {
+    auto& planets = preset.planets;
+    switch(entry.op) {
+        case Op::ADD:
+            if(entry.index > planets.size()) return false;
+            planets.insert(planets.begin() + entry.index, entry.planet);
+            return true;
+        case Op::REMOVE:
+            if(entry.index >= planets.size()) return false;
+            planets.erase(planets.begin() + entry.index);
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "preset_data.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+** Planet-level edits recorded since the last persisted state. Entries
+** are replayed in order on top of the last snapshot, so indices refer
+** to the preset as it was when each edit happened.
+**
+** Encoded entry: op (u8), 3 bytes padding, index (u32), then for ADD
+** a one-planet PresetBinary blob.
+**
+** Planets are only ever added or removed once placed, so there is no
+** in-place edit record.
+*/
+class PresetJournal {
+    public:
+        enum class Op : uint8_t {
+            ADD,
+            REMOVE
+        };
+
+        struct Entry {
+            Op op;
+            uint32_t index;
+            PlanetData planet;
+        };
+
+        void add(size_t index, const PlanetData& planet);
+        void remove(size_t index);
+        void clear();
+
+        bool empty() const { return entries.empty(); }
+        size_t size() const { return entries.size(); }
+        const std::vector<Entry>& getEntries() const { return entries; }
+
+        static std::string encode(const Entry& entry);
+        static bool decode(std::string_view data, Entry& entry);
+        static bool apply(const Entry& entry, PresetData& preset);
+
+    private:
+        std::vector<Entry> entries;
+};
@@ -1,11 +1,11 @@
 #include "preset_loader.h"
 #include "preset_data.h"
-#include "../_data/data_parser.h"
-#include "../_utils/color_converter.h"
+#include "preset_reader.h"
+#include "preset_binary.h"
+#include "../_utils/profiler.h"
+#include "../_data/asset_cache.h"
 #include "preset_manager.h"
-#include <fstream>
 #include <iostream>
-#include <sstream>
 #include <algorithm>
 
 PresetLoader::PresetLoader(PresetManager* presetManager) :
@@ -25,110 +25,29 @@ void PresetLoader::setPath(std::string& path) {
 *** Parse
 **
 */
-bool PresetLoader::parse(const std::string& data) {
-    try {
-        DataParser::Value root = DataParser::Parser::parse(data);
-        currentPreset.planets.clear();
-
-        if(
-            root.hasKey("name") || 
-            root.hasKey("size") || 
-            root.hasKey("shape")
-        ) {
-            PlanetData data;
-            parseData(root, data);
-            currentPreset.planets.push_back(data);
-        }
-        else if(root.hasKey("planets") && root["planets"].isArray()) {
-            const auto& dataArray = root["planets"].asArray();
-            for(const auto& val : dataArray) {
-                if(!val.isObject()) continue;
-                PlanetData data;
-                parseData(val, data);
-                currentPreset.planets.push_back(data);
-            }
-        } else {
-            std::cerr << "Invalid format!" << std::endl;
-            return false;
-        }
-
-        return validatePreset();
-    } catch(const std::exception& err) {
-        std::cerr << "Error parsing planet: " << err.what() << std::endl;
+bool PresetLoader::parse(std::string_view data) {
+    currentPreset.planets.clear();
+    bool success = PresetBinary::isBinary(data) ?
+        PresetBinary::decode(data, currentPreset) :
+        PresetReader::read(data, currentPreset, PresetReader::Mode::LENIENT);
+    if(!success) {
         return false;
     }
-}
-
-void PresetLoader::parseData(const DataParser::Value& val, PlanetData& data) {
-    /* Props */
-    if(val.hasKey("id")) data.id = val["id"].asInt();
-    if(val.hasKey("name")) data.name = val["name"].asString();
-    if(val.hasKey("size")) data.size = val["size"].asFloat();
-    if(val.hasKey("color")) {
-        data.color = val["color"].asString();
-        data.colorRgb = ColorConverter::parseColor(data.color);
-    }
-    if(val.hasKey("texture")) data.texture = val["texture"].asString();
-    if(val.hasKey("position")) data.position = val["position"].asInt();
-    if(val.hasKey("distanceFromCenter")) 
-        data.distanceFromCenter = val["distanceFromCenter"].asFloat();
-    if(val.hasKey("rotationSpeedItself")) 
-        data.rotationSpeedItself = val["rotationSpeedItself"].asFloat();
-    if(val.hasKey("rotationSpeedCenter")) 
-        data.rotationSpeedCenter = val["rotationSpeedCenter"].asFloat();
-
-    /* Shape */
-    if(val.hasKey("shape")) {
-        std::string shapeStr = val["shape"].asString();
-        if(shapeStr == "SPHERE") data.shape = BufferData::Type::SPHERE;
-        else if(shapeStr == "CUBE") data.shape = BufferData::Type::CUBE;
-        else if(shapeStr == "TRIANGLE") data.shape = BufferData::Type::TRIANGLE;
-        else data.shape = BufferData::Type::SPHERE;
-    }
-
-    /* Rotation */
-    if(val.hasKey("rotationDir")) {
-        std::string rotStr = val["rotationDir"].asString();
-        if(rotStr == "X") data.rotationDir = RotationAxis::X;
-        else if(rotStr == "Y") data.rotationDir = RotationAxis::Y;
-        else if(rotStr == "Z") data.rotationDir = RotationAxis::Z;
-        else data.rotationDir = RotationAxis::Y;
-    }
-    if(val.hasKey("currentRotation") && val["currentRotation"].isObject()) {
-        const auto& rot = val["currentRotation"];
-        if(rot.hasKey("x")) data.currentRotation.x = rot["x"].asFloat();
-        if(rot.hasKey("y")) data.currentRotation.y = rot["y"].asFloat();
-        if(rot.hasKey("z")) data.currentRotation.z = rot["z"].asFloat();
-    }
-
-    /* Orbit Angle */
-    if(val.hasKey("orbitAngle") && val["orbitAngle"].isObject()) {
-        const auto& orbit = val["orbitAngle"];
-        if(orbit.hasKey("x")) data.orbitAngle.x = orbit["x"].asFloat();
-        if(orbit.hasKey("y")) data.orbitAngle.y = orbit["y"].asFloat();
-        if(orbit.hasKey("z")) data.orbitAngle.z = orbit["z"].asFloat();
-    }
+    return validatePreset();
 }
 
 /*
 ** Load Preset
 */
 bool PresetLoader::loadPreset(const std::string& path) {
-    std::ifstream file(path);
-    if(!file.is_open()) {
-        std::cerr << "Failed to open preset file: " << path << std::endl;
-        return false;
-    }
-
-    try {
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        std::string dataStr = buffer.str();
-        return parse(dataStr);
-    } catch(const std::exception& err) {
-        std::cerr << "Error loading preset" << err.what() << std::endl;
+    PROFILE_ZONE(PRESET_IO);
+    std::shared_ptr<const PresetData> preset = AssetCache::get().getPreset(path);
+    if(!preset) {
+        std::cerr << "Failed to load preset file: " << path << std::endl;
         return false;
     }
+    currentPreset = *preset;
+    return validatePreset();
 }
 
 bool PresetLoader::loadDefaultPreset() {
@@ -197,7 +116,7 @@ bool PresetLoader::validatePreset() {
 PresetData& PresetLoader::getCurrentPreset() {
     return currentPreset;
 }
-PresetData PresetLoader::getCurrentPreset() const {
+const PresetData& PresetLoader::getCurrentPreset() const {
     return currentPreset;
 }
 
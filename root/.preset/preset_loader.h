@@ -1,6 +1,6 @@
 #pragma once
 #include "preset_data.h"
-#include "../_data/data_parser.h"
+#include <string_view>
 
 class PresetManager;
 class PresetLoader {
@@ -14,13 +14,12 @@ class PresetLoader {
         ~PresetLoader();
 
         void setPath(std::string& path);
-        bool parse(const std::string& data);
-        void parseData(const DataParser::Value& val, PlanetData& data);
+        bool parse(std::string_view data);
         bool loadPreset(const std::string& filePath);
         bool loadDefaultPreset();
         bool loadDefaultPresetFile();
         bool validatePreset();
-        PresetData getCurrentPreset() const;
+        const PresetData& getCurrentPreset() const;
         PresetData& getCurrentPreset();
         void setCurrentPreset(const PresetData& preset);
 };
\ No newline at end of file
@@ -0,0 +1,316 @@
+#include "preset_reader.h"
+#include "../_utils/color_converter.h"
+#include <iostream>
+
+namespace {
+    /* FNV-1a, evaluated at compile time for the case labels below */
+    constexpr uint32_t hashKey(std::string_view key) {
+        uint32_t hash = 2166136261u;
+        for(char c : key) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    BufferData::Type shapeFromString(std::string_view str) {
+        if(str == "CUBE") return BufferData::Type::CUBE;
+        if(str == "TRIANGLE") return BufferData::Type::TRIANGLE;
+        return BufferData::Type::SPHERE;
+    }
+
+    RotationAxis axisFromString(std::string_view str) {
+        if(str == "X") return RotationAxis::X;
+        if(str == "Z") return RotationAxis::Z;
+        return RotationAxis::Y;
+    }
+}
+
+PresetReader::PresetReader(PresetData& preset, Mode mode) :
+    preset(preset),
+    mode(mode),
+    scopes{},
+    seen{},
+    depth(0),
+    skipDepth(0),
+    field(NONE),
+    rootPlanet{},
+    vector(nullptr),
+    sawPlanets(false)
+{}
+
+/*
+** Read
+*/
+bool PresetReader::read(std::string_view json, PresetData& preset, Mode mode) {
+    PresetReader reader(preset, mode);
+    try {
+        if(!DataParser::Reader::read(json, reader) || !reader.finish()) {
+            std::cerr << "Error reading preset: " << reader.error << std::endl;
+            return false;
+        }
+        return true;
+    } catch(const std::exception& err) {
+        std::cerr << "Error parsing preset: " << err.what() << std::endl;
+        return false;
+    }
+}
+
+bool PresetReader::finish() {
+    if(mode == Mode::LENIENT && (seen[0] & (1u << NAME | 1u << SIZE | 1u << SHAPE))) {
+        preset.planets.assign(1, rootPlanet);
+        return true;
+    }
+    if(!sawPlanets) {
+        return fail(mode == Mode::STRICT ? "Invalid preset format: missing planets array" : "Invalid format!");
+    }
+    return true;
+}
+
+/*
+** Keys
+*/
+PresetReader::Field PresetReader::fieldForKey(std::string_view key) {
+    switch(hashKey(key)) {
+        case hashKey("id"): return key == "id" ? ID : NONE;
+        case hashKey("name"): return key == "name" ? NAME : NONE;
+        case hashKey("size"): return key == "size" ? SIZE : NONE;
+        case hashKey("color"): return key == "color" ? COLOR : NONE;
+        case hashKey("texture"): return key == "texture" ? TEXTURE : NONE;
+        case hashKey("position"): return key == "position" ? POSITION : NONE;
+        case hashKey("distanceFromCenter"): return key == "distanceFromCenter" ? DISTANCE_FROM_CENTER : NONE;
+        case hashKey("rotationSpeedItself"): return key == "rotationSpeedItself" ? ROTATION_SPEED_ITSELF : NONE;
+        case hashKey("rotationSpeedCenter"): return key == "rotationSpeedCenter" ? ROTATION_SPEED_CENTER : NONE;
+        case hashKey("shape"): return key == "shape" ? SHAPE : NONE;
+        case hashKey("rotationDir"): return key == "rotationDir" ? ROTATION_DIR : NONE;
+        case hashKey("currentRotation"): return key == "currentRotation" ? CURRENT_ROTATION : NONE;
+        case hashKey("orbitAngle"): return key == "orbitAngle" ? ORBIT_ANGLE : NONE;
+        case hashKey("planets"): return key == "planets" ? PLANETS : NONE;
+        case hashKey("textures"): return key == "textures" ? TEXTURES : NONE;
+        case hashKey("x"): return key == "x" ? X : NONE;
+        case hashKey("y"): return key == "y" ? Y : NONE;
+        case hashKey("z"): return key == "z" ? Z : NONE;
+        default: return NONE;
+    }
+}
+
+bool PresetReader::onKey(std::string_view key) {
+    if(skipDepth == 0) field = fieldForKey(key);
+    return true;
+}
+
+/*
+** Scopes
+*/
+PlanetData& PresetReader::target() {
+    return scope() == Scope::ROOT ? rootPlanet : preset.planets.back();
+}
+
+bool PresetReader::push(Scope next) {
+    if(depth >= MAX_SCOPES) return fail("Preset nested too deep");
+    scopes[depth] = next;
+    seen[depth] = 0;
+    depth++;
+    return true;
+}
+
+bool PresetReader::pop() {
+    if(depth <= 0) return fail("Unbalanced preset nesting");
+    depth--;
+    return true;
+}
+
+bool PresetReader::fail(const std::string& msg) {
+    error = msg;
+    return false;
+}
+
+bool PresetReader::typeError(const char* expected) {
+    std::string where = scope() == Scope::ROOT ?
+        std::string("root") :
+        "planet at index " + std::to_string(preset.planets.empty() ? 0 : preset.planets.size() - 1);
+    return fail("Expected " + std::string(expected) + " in " + where);
+}
+
+/*
+ * A value of the wrong type for the current key: an error for bound
+ * fields, ignored for anything else
+ */
+bool PresetReader::skipValue() {
+    Scope s = scope();
+    bool planetScope = s == Scope::PLANET || (s == Scope::ROOT && mode == Mode::LENIENT);
+    if(planetScope) {
+        if(field >= ID && field <= ROTATION_DIR) return typeError("a number or string");
+        if((field == CURRENT_ROTATION || field == ORBIT_ANGLE) && mode == Mode::STRICT) return typeError("an object");
+    }
+    if(s == Scope::VECTOR && field >= X) return typeError("a number");
+    if(s == Scope::TEXTURES) return fail("Expected a string in textures");
+    if(s == Scope::PLANETS && mode == Mode::STRICT) {
+        return fail("Failed to parse planet at index: " + std::to_string(preset.planets.size()));
+    }
+    if(s == Scope::NONE) return fail("Invalid format!");
+    return true;
+}
+
+bool PresetReader::onStartObject() {
+    if(skipDepth > 0) {
+        skipDepth++;
+        return true;
+    }
+
+    Scope s = scope();
+    if(s == Scope::NONE) return push(Scope::ROOT);
+    if(s == Scope::PLANETS) {
+        preset.planets.emplace_back();
+        return push(Scope::PLANET);
+    }
+
+    bool planetScope = s == Scope::PLANET || (s == Scope::ROOT && mode == Mode::LENIENT);
+    if(planetScope && (field == CURRENT_ROTATION || field == ORBIT_ANGLE)) {
+        seen[depth - 1] |= 1u << field;
+        PlanetData& planet = target();
+        vector = field == CURRENT_ROTATION ? &planet.currentRotation : &planet.orbitAngle;
+        return push(Scope::VECTOR);
+    }
+
+    if(!skipValue()) return false;
+    skipDepth = 1;
+    return true;
+}
+
+bool PresetReader::onEndObject() {
+    if(skipDepth > 0) {
+        skipDepth--;
+        return true;
+    }
+
+    Scope s = scope();
+    uint32_t mask = depth > 0 ? seen[depth - 1] : 0;
+    if(!pop()) return false;
+    if(mode == Mode::STRICT) {
+        if(s == Scope::PLANET && (mask & REQUIRED_FIELDS) != REQUIRED_FIELDS) {
+            return fail("Failed to parse planet at index: " + std::to_string(preset.planets.size() - 1));
+        }
+        if(s == Scope::VECTOR && (mask & VECTOR_FIELDS) != VECTOR_FIELDS) {
+            return fail("Missing vector component in planet at index: " + std::to_string(preset.planets.size() - 1));
+        }
+    }
+    return true;
+}
+
+bool PresetReader::onStartArray() {
+    if(skipDepth > 0) {
+        skipDepth++;
+        return true;
+    }
+
+    if(scope() == Scope::ROOT && field == PLANETS) {
+        sawPlanets = true;
+        preset.planets.clear();
+        return push(Scope::PLANETS);
+    }
+    if(scope() == Scope::ROOT && field == TEXTURES) {
+        textures.clear();
+        return push(Scope::TEXTURES);
+    }
+
+    if(!skipValue()) return false;
+    skipDepth = 1;
+    return true;
+}
+
+bool PresetReader::onEndArray() {
+    if(skipDepth > 0) {
+        skipDepth--;
+        return true;
+    }
+    return pop();
+}
+
+/*
+** Values
+*/
+bool PresetReader::onNull() {
+    return skipDepth > 0 || skipValue();
+}
+
+bool PresetReader::onBoolean(bool value) {
+    (void)value;
+    return skipDepth > 0 || skipValue();
+}
+
+bool PresetReader::onNumber(double value) {
+    if(skipDepth > 0) return true;
+
+    Scope s = scope();
+    if(s == Scope::VECTOR) {
+        if(field < X) return true;
+        seen[depth - 1] |= 1u << field;
+        (*vector)[field - X] = static_cast<float>(value);
+        return true;
+    }
+    if(s != Scope::PLANET && (s != Scope::ROOT || mode != Mode::LENIENT)) return skipValue();
+
+    PlanetData& planet = target();
+    switch(field) {
+        case ID: planet.id = static_cast<uint32_t>(static_cast<int>(value)); break;
+        case SIZE: planet.size = static_cast<float>(value); break;
+        case POSITION: planet.position = static_cast<int>(value); break;
+        case DISTANCE_FROM_CENTER: planet.distanceFromCenter = static_cast<float>(value); break;
+        case ROTATION_SPEED_ITSELF: planet.rotationSpeedItself = static_cast<float>(value); break;
+        case ROTATION_SPEED_CENTER: planet.rotationSpeedCenter = static_cast<float>(value); break;
+        case TEXTURE: {
+            if(value >= 0 && value < static_cast<double>(textures.size())) {
+                planet.texture = textures[static_cast<size_t>(value)];
+            } else if(mode == Mode::STRICT) {
+                return typeError("a valid texture index");
+            } else {
+                planet.texture = TextureRegistry::NONE;
+            }
+            break;
+        }
+        case NAME:
+        case COLOR:
+        case SHAPE:
+        case ROTATION_DIR:
+            return typeError("a string");
+        default:
+            return skipValue();
+    }
+    seen[depth - 1] |= 1u << field;
+    return true;
+}
+
+bool PresetReader::onString(std::string_view value) {
+    if(skipDepth > 0) return true;
+
+    Scope s = scope();
+    if(s == Scope::TEXTURES) {
+        textures.push_back(TextureRegistry::get().intern(value));
+        return true;
+    }
+    if(s != Scope::PLANET && (s != Scope::ROOT || mode != Mode::LENIENT)) return skipValue();
+
+    PlanetData& planet = target();
+    switch(field) {
+        case NAME: planet.name.assign(value.data(), value.size()); break;
+        case COLOR:
+            planet.color.assign(value.data(), value.size());
+            planet.colorRgb = ColorConverter::parseColor(planet.color);
+            break;
+        case TEXTURE: planet.texture = TextureRegistry::get().intern(value); break;
+        case SHAPE: planet.shape = shapeFromString(value); break;
+        case ROTATION_DIR: planet.rotationDir = axisFromString(value); break;
+        case ID:
+        case SIZE:
+        case POSITION:
+        case DISTANCE_FROM_CENTER:
+        case ROTATION_SPEED_ITSELF:
+        case ROTATION_SPEED_CENTER:
+            return typeError("a number");
+        default:
+            return skipValue();
+    }
+    seen[depth - 1] |= 1u << field;
+    return true;
+}
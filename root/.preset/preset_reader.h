@@ -0,0 +1,105 @@
+#pragma once
+#include "preset_data.h"
+#include "../_data/data_reader.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+** Fills PresetData straight from JSON events, binding keys to
+** PlanetData fields through a precomputed key-hash switch. No
+** intermediate tree is built.
+**
+** STRICT requires every planet field and a planets array, as saved
+** presets do. LENIENT accepts partial planets and a single planet at
+** the root, as hand-written preset files do.
+**
+** A planet texture is either a source string or an index into the
+** top-level textures array, which has to come before planets.
+*/
+class PresetReader : public DataParser::Reader::Handler {
+    public:
+        enum class Mode {
+            STRICT,
+            LENIENT
+        };
+
+        static bool read(std::string_view json, PresetData& preset, Mode mode);
+
+        bool onNull() override;
+        bool onBoolean(bool value) override;
+        bool onNumber(double value) override;
+        bool onString(std::string_view value) override;
+        bool onKey(std::string_view key) override;
+        bool onStartObject() override;
+        bool onEndObject() override;
+        bool onStartArray() override;
+        bool onEndArray() override;
+
+    private:
+        enum Field : uint32_t {
+            NONE,
+            ID,
+            NAME,
+            SIZE,
+            COLOR,
+            TEXTURE,
+            POSITION,
+            DISTANCE_FROM_CENTER,
+            ROTATION_SPEED_ITSELF,
+            ROTATION_SPEED_CENTER,
+            SHAPE,
+            ROTATION_DIR,
+            CURRENT_ROTATION,
+            ORBIT_ANGLE,
+            PLANETS,
+            TEXTURES,
+            X,
+            Y,
+            Z
+        };
+
+        enum class Scope {
+            NONE,
+            ROOT,
+            PLANETS,
+            PLANET,
+            TEXTURES,
+            VECTOR
+        };
+
+        static constexpr int MAX_SCOPES = 8;
+        static constexpr uint32_t REQUIRED_FIELDS =
+            1u << ID | 1u << NAME | 1u << SIZE | 1u << COLOR | 1u << POSITION |
+            1u << DISTANCE_FROM_CENTER | 1u << ROTATION_SPEED_ITSELF |
+            1u << ROTATION_SPEED_CENTER | 1u << SHAPE | 1u << ROTATION_DIR;
+        static constexpr uint32_t VECTOR_FIELDS = 1u << X | 1u << Y | 1u << Z;
+
+        PresetData& preset;
+        Mode mode;
+
+        Scope scopes[MAX_SCOPES];
+        uint32_t seen[MAX_SCOPES];
+        int depth;
+        int skipDepth;
+        Field field;
+
+        PlanetData rootPlanet;
+        glm::vec3* vector;
+        std::vector<TextureRegistry::Handle> textures;
+        bool sawPlanets;
+        std::string error;
+
+        PresetReader(PresetData& preset, Mode mode);
+
+        static Field fieldForKey(std::string_view key);
+
+        Scope scope() const { return depth > 0 ? scopes[depth - 1] : Scope::NONE; }
+        PlanetData& target();
+        bool push(Scope scope);
+        bool pop();
+        bool skipValue();
+        bool fail(const std::string& msg);
+        bool typeError(const char* expected);
+        bool finish();
+};
@@ -33,21 +33,11 @@ void PresetReset::resetToDefault() {
 
         bufferController->planetBuffers.clear();
         for(auto& planetBuffer : newPlanetBuffers) {
-            float orbitRadius = planetBuffer.data.distanceFromCenter;
-            float initialAngle = planetBuffer.data.orbitAngle.y;
-
-            glm::vec3 planetPosition(
-                orbitRadius * cos(glm::radians(initialAngle)),
-                0.0f,
-                orbitRadius * sin(glm::radians(initialAngle))
-            );
-            planetBuffer.worldPos = planetPosition;
             planetBuffer.isPreview = false;
-            bufferController->buffers->createBufferForPlanet(planetBuffer);
-            bufferController->buffers->planetBuffers.push_back(std::move(planetBuffer));
+            bufferController->buffers->addPlanet(std::move(planetBuffer));
         }
+        /* clearBuffers already marked the saver and released textures */
         std::cout << "Reseted to default!" << std::endl;
-        bufferController->presetManager->getPresetSaver()->save();
     } else {
         std::cout << "Failed to reset!" << std::endl;
     }
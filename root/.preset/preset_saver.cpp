@@ -1,7 +1,10 @@
 #include "preset_saver.h"
+#include "preset_converter.h"
+#include "preset_binary.h"
 #include "../.controller/buffer_controller.h"
 #include "preset_manager.h"
-#include "../_utils/color_converter.h"
+#include "../_utils/profiler.h"
+#include "../_platform/platform.h"
 #include <emscripten.h>
 #include <emscripten/html5.h>
 #include <iostream>
@@ -10,219 +13,230 @@
 PresetSaver::PresetSaver(BufferController* bufferController, PresetManager* presetManager) :
     bufferController(bufferController),
     presetManager(presetManager),
-    key("savedPreset")
+    key("savedPreset"),
+    generation(0),
+    storedRecords(0),
+    lastEditMs(0.0),
+    dirty(false),
+    needsSnapshot(true)
 {};
 PresetSaver::~PresetSaver() {};
 
 /*
-** Planet To Value
+** Preset Data
 */
-DataParser::Value PresetSaver::planetToValue(const PlanetData& data) {
-    using namespace DataParser;
-    
-    std::string shapeStr = bufferController->bufferGenerator->shapeToString(data.shape);
-    std::string rotationStr = bufferController->bufferGenerator->rotationToString(data.rotationDir);
-    auto rgb = ColorConverter::parseColor(data.color); 
-    Value colorRgb(ValueType::Object);
-    colorRgb["r"] = Value(rgb.r);
-    colorRgb["g"] = Value(rgb.g);
-    colorRgb["b"] = Value(rgb.b);
-    
-    Value result(ValueType::Object);
-    result["id"] = Value(static_cast<double>(data.id));
-    result["name"] = Value(data.name);
-    result["size"] = Value(data.size);
-    result["color"] = Value(data.color);
-    result["colorRgb"] = colorRgb;
-    result["position"] = Value(static_cast<double>(data.position));
-    result["distanceFromCenter"] = Value(data.distanceFromCenter);
-    result["rotationSpeedItself"] = Value(data.rotationSpeedItself);
-    result["rotationSpeedCenter"] = Value(data.rotationSpeedCenter);
-    result["shape"] = Value(shapeStr);
-    result["rotationDir"] = Value(rotationStr);
-    
-    Value currentRotation(ValueType::Object);
-    currentRotation["x"] = Value(data.currentRotation.x);
-    currentRotation["y"] = Value(data.currentRotation.y);
-    currentRotation["z"] = Value(data.currentRotation.z);
-    result["currentRotation"] = currentRotation;
-    
-    Value orbitAngle(ValueType::Object);
-    orbitAngle["x"] = Value(data.orbitAngle.x);
-    orbitAngle["y"] = Value(data.orbitAngle.y);
-    orbitAngle["z"] = Value(data.orbitAngle.z);
-    result["orbitAngle"] = orbitAngle;
-    
-    return result;
+std::string PresetSaver::presetToData(PresetData& preset) {
+    return PresetConverter::presetToData(preset);
 }
 
-bool PresetSaver::valueToPlanet(const DataParser::Value& value, PlanetData& data) {
-    using namespace DataParser;
-
-    try {
-        data.id = value["id"].asInt();
-        data.name = value["name"].asString();
-        data.size = value["size"].asFloat();
-        data.color = value["color"].asString();
-        data.colorRgb = ColorConverter::parseColor(data.color);
-        data.position = value["position"].asInt();
-        data.distanceFromCenter = value["distanceFromCenter"].asFloat();
-        data.rotationSpeedItself = value["rotationSpeedItself"].asFloat();
-        data.rotationSpeedCenter = value["rotationSpeedCenter"].asFloat();
-
-        std::string shapeStr = value["shape"].asString();
-        if(shapeStr == "SPHERE") {
-            data.shape = BufferData::Type::SPHERE;
-        } else if(shapeStr == "CUBE") {
-            data.shape = BufferData::Type::CUBE;
-        } else if(shapeStr == "TRIANGLE") {
-            data.shape = BufferData::Type::TRIANGLE;
-        } else {
-            data.shape = BufferData::Type::SPHERE;
-        }
+bool PresetSaver::convertToPreset(const std::string& data, PresetData& preset) {
+    return PresetConverter::convertToPreset(data, preset);
+}
 
-        std::string rotationStr = value["rotationDir"].asString();
-        if(rotationStr == "X") {
-            data.rotationDir = RotationAxis::X;
-        } else if(rotationStr == "Y") {
-            data.rotationDir = RotationAxis::Y;
-        } else if(rotationStr == "Z") {
-            data.rotationDir = RotationAxis::Z;
-        } else {
-            data.rotationDir = RotationAxis::Y;
+/*
+** Storage
+*/
+/*
+ * Binary blobs are base64'd since localStorage only holds strings.
+ * Presets saved as JSON by older builds come back unchanged. A non-zero
+ * tag is stored in front as "<tag>:", which base64 never contains.
+ */
+bool PresetSaver::storeBytes(const std::string& storageKey, const std::string& data, uint32_t tag) {
+    return EM_ASM_INT({
+        try {
+            const key = UTF8ToString($0);
+            const bytes = HEAPU8.subarray($1, $1 + $2);
+            let binary = '';
+            for(let i = 0; i < bytes.length; i += 0x8000) {
+                binary += String.fromCharCode.apply(null, bytes.subarray(i, i + 0x8000));
+            }
+            localStorage.setItem(key, ($3 ? $3 + ':' : '') + btoa(binary));
+            return 1;
+        } catch(err) {
+            console.error('Error saving to local storage', err);
+            return 0;
         }
+    }, storageKey.c_str(), data.data(), data.size(), tag) == 1;
+}
 
-        if(value.hasKey("currentRotation")) {
-            const Value& rot = value["currentRotation"];
-            data.currentRotation.x = rot["x"].asFloat();
-            data.currentRotation.y = rot["y"].asFloat();
-            data.currentRotation.z = rot["z"].asFloat();
-        }
-        
-        if(value.hasKey("orbitAngle")) {
-            const Value& orbit = value["orbitAngle"];
-            data.orbitAngle.x = orbit["x"].asFloat();
-            data.orbitAngle.y = orbit["y"].asFloat();
-            data.orbitAngle.z = orbit["z"].asFloat();
+bool PresetSaver::loadBytes(const std::string& storageKey, std::string& out, uint32_t* tag) {
+    uint32_t size = 0;
+    uint32_t storedTag = 0;
+    char* ptr = (char*)EM_ASM_INT({
+        try {
+            let data = localStorage.getItem(UTF8ToString($0));
+            if(!data) return 0;
+
+            const colon = data[0] === '{' ? -1 : data.indexOf(':');
+            if(colon > 0) {
+                HEAPU32[$2 >> 2] = parseInt(data.slice(0, colon), 10) >>> 0;
+                data = data.slice(colon + 1);
+            }
+
+            let ptr;
+            let length;
+            if(data[0] === '{') {
+                length = lengthBytesUTF8(data);
+                ptr = _malloc(length + 1);
+                stringToUTF8(data, ptr, length + 1);
+            } else {
+                const binary = atob(data);
+                length = binary.length;
+                ptr = _malloc(length);
+                for(let i = 0; i < length; i++) {
+                    HEAPU8[ptr + i] = binary.charCodeAt(i);
+                }
+            }
+            HEAPU32[$1 >> 2] = length;
+            return ptr;
+        } catch(err) {
+            console.error('Error loading!', err);
+            return 0;
         }
+    }, storageKey.c_str(), &size, &storedTag);
 
-        return true;
-    } catch(const std::exception& err) {
-        std::cerr << "Error converting value: " << err.what() << std::endl;
-        return false;
-    }
+    if(ptr == 0) return false;
+    out.assign(ptr, size);
+    free(ptr);
+    if(tag) *tag = storedTag;
+    return true;
 }
 
 /*
-** Preset To Value
+** Save to Local Storage
 */
-DataParser::Value PresetSaver::presetToVal(PresetData& preset) {
-    using namespace DataParser;
+/*
+ * Full snapshot, tagged with the next generation so it only picks up
+ * journal records written after it. The old snapshot and its journal
+ * stay in place until the new one is stored; a failed write leaves the
+ * previous state loadable, edits included.
+ */
+bool PresetSaver::saveToLocalStorage(PresetData& preset) {
+    PROFILE_ZONE(PRESET_IO);
+    uint32_t previous = storedGeneration();
+    uint32_t next = previous + 1;
+    clearJournal(next);
+    needsSnapshot = true;
+    if(!storeBytes(key, PresetBinary::encode(preset), next)) return false;
 
-    Value result(ValueType::Object);
-    Value planetsArray(ValueType::Array);
-    for(const auto& planet : preset.planets) {
-        planetsArray.push_back(planetToValue(planet));
-    }
-    
-    result["planets"] = planetsArray;
-    return result;
+    clearJournal(previous);
+    generation = next;
+    storedRecords = 0;
+    needsSnapshot = false;
+    std::cout << "Preset saved to localStorage with key: " << key << std::endl;
+    return true;
 }
 
 /*
-** Value to Preset
+** Load from Local Storage
 */
-bool PresetSaver::valueToPreset(const DataParser::Value& value, PresetData& preset) {
-    using namespace DataParser;
+bool PresetSaver::loadFromLocalStorage(PresetData& preset) {
+    PROFILE_ZONE(PRESET_IO);
+    std::string data;
+    uint32_t stored = 0;
+    if(!loadBytes(key, data, &stored)) {
+        std::cout << "No preset found in local storage!: " << key << std::endl;
+        return false;
+    }
+    if(!convertToPreset(data, preset)) return false;
+    generation = stored;
+    /* Untagged snapshots come from builds without generations; the next
+       flush rewrites them before any record is appended */
+    needsSnapshot = generation == 0;
 
-    try {
-        if(!value.hasKey("planets") || !value["planets"].isArray()) {
-            std::cerr << "Invalid preset format: missing planets array" << std::endl;
-            return false;
+    /* Replay the edits made since the snapshot */
+    storedRecords = generation != 0 ? journalCount(generation) : 0;
+    for(uint32_t i = 0; i < storedRecords; i++) {
+        PresetJournal::Entry entry;
+        if(
+            !loadBytes(journalKey(generation, i), data) ||
+            !PresetJournal::decode(data, entry) ||
+            !PresetJournal::apply(entry, preset)
+        ) {
+            std::cerr << "Dropping preset journal from record " << i << std::endl;
+            needsSnapshot = true;
+            break;
         }
+    }
+    return true;
+}
 
-        const Value& planetsArray = value["planets"];
-        preset.planets.clear();
-        for(size_t i = 0; i < planetsArray.size(); i++) {
-            PlanetData planet;
-            if(valueToPlanet(planetsArray[i], planet)) {
-                preset.planets.push_back(planet);
-            } else {
-                std::cerr << "Failed to parse planet at index: " << i << std:: endl;
-                return false;
-            }
-        }
+/*
+** Journal
+*/
+/*
+ * Records of generation gen live at <key>.journal.<gen>.<i>, with
+ * their count at <key>.journal.<gen>
+ */
+std::string PresetSaver::journalKey(uint32_t gen) const {
+    return key + ".journal." + std::to_string(gen);
+}
 
-        return true;
-    } catch(const std::exception& err) {
-        std::cerr << "Error converting value to preset: " << err.what() << std::endl;
-        return false;
-    }
+std::string PresetSaver::journalKey(uint32_t gen, uint32_t index) const {
+    return journalKey(gen) + "." + std::to_string(index);
 }
 
-std::string PresetSaver::presetToData(PresetData& preset) {
-    DataParser::Value presetValue = presetToVal(preset);
-    return presetValue.toString(false);
+uint32_t PresetSaver::journalCount(uint32_t gen) const {
+    return static_cast<uint32_t>(EM_ASM_INT({
+        try {
+            const count = localStorage.getItem(UTF8ToString($0));
+            return count ? parseInt(count, 10) || 0 : 0;
+        } catch(err) {
+            return 0;
+        }
+    }, journalKey(gen).c_str()));
 }
 
-bool PresetSaver::convertToPreset(const std::string& data, PresetData& preset) {
-    try {
-        DataParser::Value parsedValue = DataParser::Parser::parse(data);
-        return valueToPreset(parsedValue, preset);
-    } catch(const std::exception& err) {
-        std::cerr << "Error parsing JSON: " << err.what() << std::endl;
-        return false;
-    }
+/*
+ * Generation tag of the stored snapshot, 0 when there is none or it
+ * predates the tags
+ */
+uint32_t PresetSaver::storedGeneration() const {
+    return static_cast<uint32_t>(EM_ASM_INT({
+        try {
+            const data = localStorage.getItem(UTF8ToString($0));
+            if(!data || data[0] === '{') return 0;
+            const colon = data.indexOf(':');
+            return colon > 0 ? parseInt(data.slice(0, colon), 10) >>> 0 : 0;
+        } catch(err) {
+            return 0;
+        }
+    }, key.c_str()));
 }
 
 /*
-** Save to Local Storage
-*/
-bool PresetSaver::saveToLocalStorage(PresetData& preset) {
-    std::string jsonData = presetToData(preset);
-    bool success = EM_ASM_INT({
+ * Each record gets its own key, so an append never rewrites earlier
+ * records; the count is bumped only after the record is stored
+ */
+bool PresetSaver::appendJournal(const PresetJournal::Entry& entry) {
+    if(!storeBytes(journalKey(generation, storedRecords), PresetJournal::encode(entry))) return false;
+    bool counted = EM_ASM_INT({
         try {
-            const key = UTF8ToString($0);
-            const dataStr = UTF8ToString($1);
-            localStorage.setItem(key, dataStr);
-            console.log('Preset saved to localStorage with key:', key);
+            localStorage.setItem(UTF8ToString($0), String($1));
             return 1;
         } catch(err) {
-            console.error('Error saving to local storage', err);
+            console.error('Error saving preset journal count:', err);
             return 0;
         }
-    }, key.c_str(), jsonData.c_str());
-    return success == 1;
+    }, journalKey(generation).c_str(), storedRecords + 1) == 1;
+    if(!counted) return false;
+    storedRecords++;
+    return true;
 }
 
-/*
-** Load from Local Storage
-*/
-bool PresetSaver::loadFromLocalStorage(PresetData& preset) {
-    char* str = (char*)EM_ASM_INT({
+void PresetSaver::clearJournal(uint32_t gen) {
+    EM_ASM({
         try {
             const key = UTF8ToString($0);
-            const data = localStorage.getItem(key);
-            if(data) {
-                console.log('Found preset in localstorage with key: ', key);
-                var lengthBytes = lengthBytesUTF8(data) + 1;
-                var strPtr = _malloc(lengthBytes);
-                stringToUTF8(data, strPtr, lengthBytes);
-                return strPtr;
-            } else {
-                console.log('No preset found in local storage!: ', key);
-                return 0;
+            const count = parseInt(localStorage.getItem(key), 10) || 0;
+            for(let i = 0; i < count; i++) {
+                localStorage.removeItem(key + '.' + i);
             }
+            localStorage.removeItem(key);
         } catch(err) {
-            console.error('Error loading!', err);
-            return 0.
+            console.error('Error clearing preset journal:', err);
         }
-    }, key.c_str());
-
-    if(str == 0) return false;
-    std::string dataJson(str);
-    free(str);
-    return convertToPreset(dataJson, preset);
+    }, journalKey(gen).c_str());
 }
 
 bool PresetSaver::hasSavedPreset() {
@@ -238,6 +252,9 @@ bool PresetSaver::hasSavedPreset() {
 }
 
 void PresetSaver::clearLocalStorage() {
+    clearJournal(storedGeneration());
+    storedRecords = 0;
+    needsSnapshot = true;
     EM_ASM({
         try {
             const key = UTF8ToString($0);
@@ -249,6 +266,79 @@ void PresetSaver::clearLocalStorage() {
     }, key.c_str());
 }
 
+/*
+** Dirty Tracking
+*/
+void PresetSaver::markAdded(size_t index, const PlanetData& planet) {
+    if(!needsSnapshot) journal.add(index, planet);
+    touch();
+}
+
+void PresetSaver::markRemoved(size_t index) {
+    if(!needsSnapshot) journal.remove(index);
+    touch();
+}
+
+/*
+ * The whole preset changed; the next flush writes a snapshot
+ */
+void PresetSaver::markReplaced() {
+    journal.clear();
+    needsSnapshot = true;
+    touch();
+}
+
+void PresetSaver::touch() {
+    dirty = true;
+    lastEditMs = Platform::now();
+}
+
+/*
+** Scheduler
+*/
+/*
+ * Called every frame; writes once edits have been quiet for
+ * SAVE_DELAY_MS so a burst of edits lands as one flush
+ */
+void PresetSaver::update(double nowMs) {
+    if(dirty && nowMs - lastEditMs >= SAVE_DELAY_MS) flush();
+}
+
+/*
+ * An empty preset is written too, so deleting the last planet sticks.
+ * A failed write is retried after another SAVE_DELAY_MS rather than
+ * every frame
+ */
+bool PresetSaver::flush() {
+    if(!dirty) return true;
+    if(!bufferController) return false;
+
+    bool success;
+    if(needsSnapshot || storedRecords + journal.size() > COMPACT_RECORDS) {
+        success = saveToLocalStorage(bufferController->currentPreset);
+    } else {
+        PROFILE_ZONE(PRESET_IO);
+        success = true;
+        for(const auto& entry : journal.getEntries()) {
+            if(!appendJournal(entry)) {
+                success = false;
+                break;
+            }
+        }
+        /* A partly written journal is replaced by a snapshot */
+        if(!success) success = saveToLocalStorage(bufferController->currentPreset);
+    }
+
+    if(success) {
+        journal.clear();
+        needsSnapshot = false;
+        dirty = false;
+    } else {
+        lastEditMs = Platform::now();
+    }
+    return success;
+}
+
 /*
 **
 *** Save
@@ -260,13 +350,9 @@ bool PresetSaver::save() {
         return false;
     }
 
-    PresetData currentPreset = bufferController->getCurrentPreset();
-    if (currentPreset.planets.empty()) {
-        std::cerr << "Cannot save: preset has no planets" << std::endl;
-        return false;
-    }
-
-    bool success = saveToLocalStorage(bufferController->currentPreset);
+    /* Nothing pending still writes, so an explicit save always lands */
+    dirty = true;
+    bool success = flush();
     if (success) {
         std::cout << "Preset saved to localStorage successfully!" << std::endl;
     } else {
@@ -1,5 +1,6 @@
 #pragma once
 #include "preset_data.h"
+#include "preset_journal.h"
 #include "../_data/data_parser.h"
 
 class BufferController;
@@ -11,10 +12,28 @@ class PresetSaver {
         
         const std::string key = "savedPreset";
 
-        DataParser::Value presetToVal(PresetData& preset);
-        bool valueToPreset(const DataParser::Value& val, PresetData& preset);
-        DataParser::Value planetToValue(const PlanetData& planet);
-        bool valueToPlanet(const DataParser::Value& val, PlanetData& planet);
+        /* Quiet time before edits are written, and the journal length
+           that triggers compaction into a snapshot */
+        static constexpr double SAVE_DELAY_MS = 500.0;
+        static constexpr size_t COMPACT_RECORDS = 64;
+
+        PresetJournal journal;
+        /* Snapshot the stored journal belongs to */
+        uint32_t generation;
+        uint32_t storedRecords;
+        double lastEditMs;
+        bool dirty;
+        bool needsSnapshot;
+
+        bool storeBytes(const std::string& storageKey, const std::string& data, uint32_t tag = 0);
+        bool loadBytes(const std::string& storageKey, std::string& out, uint32_t* tag = nullptr);
+        std::string journalKey(uint32_t gen) const;
+        std::string journalKey(uint32_t gen, uint32_t index) const;
+        uint32_t journalCount(uint32_t gen) const;
+        uint32_t storedGeneration() const;
+        bool appendJournal(const PresetJournal::Entry& entry);
+        void clearJournal(uint32_t gen);
+        void touch();
 
     public:
         PresetSaver(BufferController* bufferController, PresetManager* presetManager);
@@ -28,6 +47,12 @@ class PresetSaver {
         std::string presetToData(PresetData& preset);
         bool convertToPreset(const std::string& data, PresetData& preset);
 
+        void markAdded(size_t index, const PlanetData& planet);
+        void markRemoved(size_t index);
+        void markReplaced();
+        void update(double nowMs);
+        bool flush();
+
         bool save();
         bool load();
 };
\ No newline at end of file
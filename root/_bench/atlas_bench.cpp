@@ -0,0 +1,177 @@
+#include "bench.h"
+#include "bench_data.h"
+#include "../_utils/texture_atlas.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+static const int PAGE_SIZE = 2048;
+static const int LEVELS = 4;
+
+/*
+** Fills a page with textures of random power-of-two sides from 64 to
+** {max side}, square or 2:1, until one no longer fits. The label gives
+** the textures placed and the share of the page they cover
+*/
+static void BM_AtlasPack(Bench::State& state) {
+    std::mt19937 rng(7);
+    std::vector<std::pair<int, int>> sizes;
+    for(int i = 0; i < 1024; i++) {
+        int side = 64;
+        while(side < state.range(0) && rng() % 2) side *= 2;
+        int width = rng() % 3 == 0 && side * 2 <= state.range(0) ? side * 2 : side;
+        sizes.push_back({ width, side });
+    }
+
+    TextureAtlas atlas(PAGE_SIZE, LEVELS, 4);
+    TextureAtlas::Rect rect;
+    size_t placed = 0;
+    while(state.keepRunning()) {
+        atlas.clear();
+        placed = 0;
+        while(placed < sizes.size() && atlas.insert(sizes[placed].first, sizes[placed].second, rect)) placed++;
+        Bench::doNotOptimize(rect);
+    }
+    state.itemsProcessed = state.getIterations() * static_cast<int64_t>(placed);
+
+    char label[64];
+    snprintf(label, sizeof(label), "%zu textures %.0f%% full", placed, atlas.occupancy() * 100.0);
+    state.label = label;
+}
+BENCHMARK(BM_AtlasPack, {256}, {512});
+
+/*
+** Gutter padding of a decoded texture before it goes on a page,
+** {format, side}; format 0 is RGBA8 with the chain built here, 1 is
+** BC1 with its encoded chain
+*/
+static void BM_AtlasPad(Bench::State& state) {
+    using Format = TextureTranscoder::Format;
+    Format format = state.range(0) ? Format::BC1 : Format::RGBA8;
+    ImageDecoder::Image image;
+    image.width = image.height = static_cast<int>(state.range(1));
+    image.pixels = BenchData::makeTexturePixels(image.width, false);
+    TextureTranscoder::Texture texture;
+    TextureTranscoder::encode(image, format, format != Format::RGBA8, texture);
+
+    TextureAtlas atlas(PAGE_SIZE, LEVELS, TextureTranscoder::isCompressed(format) ? 4 : 1);
+    TextureTranscoder::Texture padded;
+    while(state.keepRunning()) {
+        bool ok = TextureAtlas::pad(texture, atlas.getGutter(), LEVELS, padded);
+        Bench::doNotOptimize(ok);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(padded.data.size());
+    state.label = TextureTranscoder::name(format);
+}
+BENCHMARK(BM_AtlasPad, {0, 512}, {1, 512}, {1, 1024});
+
+/*
+** Checks
+*/
+/*
+ * Random inserts into pages of each block size until they fill: every
+ * padded rect is cell aligned, lies inside the page and overlaps no
+ * other
+ */
+static bool CheckAtlasPlacement() {
+    bool ok = true;
+    std::mt19937 rng(11);
+    for(int blockSize : { 1, 4 }) {
+        TextureAtlas atlas(PAGE_SIZE, LEVELS, blockSize);
+        int gutter = atlas.getGutter();
+        std::vector<TextureAtlas::Rect> padded;
+        TextureAtlas::Rect rect;
+        for(int misses = 0; misses < 64;) {
+            int width = gutter * (1 + rng() % 16);
+            int height = gutter * (1 + rng() % 16);
+            if(!atlas.insert(width, height, rect)) {
+                misses++;
+                continue;
+            }
+            if(rect.width != width || rect.height != height) {
+                printf("  %dx%d placed as %dx%d\n", width, height, rect.width, rect.height);
+                ok = false;
+            }
+            padded.push_back({ rect.x - gutter, rect.y - gutter, rect.width + 2 * gutter, rect.height + 2 * gutter });
+        }
+
+        for(size_t i = 0; i < padded.size(); i++) {
+            const TextureAtlas::Rect& a = padded[i];
+            if(a.x < 0 || a.y < 0 || a.x + a.width > PAGE_SIZE || a.y + a.height > PAGE_SIZE || a.x % gutter || a.y % gutter) {
+                printf("  block %d: padded rect %d,%d %dx%d outside the page grid\n", blockSize, a.x, a.y, a.width, a.height);
+                ok = false;
+            }
+            for(size_t j = i + 1; j < padded.size(); j++) {
+                const TextureAtlas::Rect& b = padded[j];
+                if(a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height) {
+                    printf("  block %d: placements %zu and %zu overlap\n", blockSize, i, j);
+                    ok = false;
+                }
+            }
+        }
+        if(padded.size() < 8) {
+            printf("  block %d: only %zu placements\n", blockSize, padded.size());
+            ok = false;
+        }
+    }
+    return ok;
+}
+BENCH_CHECK(CheckAtlasPlacement);
+
+/*
+ * Decodes each level of the padded texture and of its source, and
+ * checks every padded texel against the source texel it wraps to, so
+ * the gutter equals the opposite edge and the content is untouched
+ */
+static bool padWrapsAtEveryLevel(const TextureTranscoder::Texture& src, const TextureTranscoder::Texture& padded, int gutter) {
+    for(int l = 0; l < LEVELS; l++) {
+        const TextureTranscoder::Level& srcLevel = src.levels[l];
+        const TextureTranscoder::Level& padLevel = padded.levels[l];
+        ImageDecoder::Image a;
+        ImageDecoder::Image b;
+        if(!TextureTranscoder::decode(src.data.data() + srcLevel.offset, srcLevel.size, src.format, srcLevel.width, srcLevel.height, a)
+            || !TextureTranscoder::decode(padded.data.data() + padLevel.offset, padLevel.size, padded.format, padLevel.width, padLevel.height, b)) return false;
+
+        int edge = gutter >> l;
+        if(b.width != a.width + 2 * edge || b.height != a.height + 2 * edge) return false;
+        for(int y = 0; y < b.height; y++) {
+            int sy = (y - edge + a.height) % a.height;
+            for(int x = 0; x < b.width; x++) {
+                int sx = (x - edge + a.width) % a.width;
+                if(memcmp(&b.pixels[(static_cast<size_t>(y) * b.width + x) * 4], &a.pixels[(static_cast<size_t>(sy) * a.width + sx) * 4], 4) != 0) {
+                    printf("  %s level %d: texel %d,%d differs from %d,%d\n", TextureTranscoder::name(src.format), l, x, y, sx, sy);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * pad() on RGBA8 and BC1 textures with full chains, non-square so rows
+ * and columns wrap differently
+ */
+static bool CheckAtlasPad() {
+    using Format = TextureTranscoder::Format;
+    bool ok = true;
+    for(Format format : { Format::RGBA8, Format::BC1 }) {
+        TextureAtlas atlas(PAGE_SIZE, LEVELS, TextureTranscoder::isCompressed(format) ? 4 : 1);
+        ImageDecoder::Image image;
+        image.width = image.height = 256;
+        image.pixels = BenchData::makeTexturePixels(image.width, false);
+        /* Drop the bottom half so the texture is 256x128 */
+        image.height = 128;
+        image.pixels.resize(static_cast<size_t>(image.width) * image.height * 4);
+
+        TextureTranscoder::Texture texture;
+        TextureTranscoder::Texture padded;
+        bool padOk = TextureTranscoder::encode(image, format, true, texture)
+            && TextureAtlas::pad(texture, atlas.getGutter(), LEVELS, padded)
+            && padWrapsAtEveryLevel(texture, padded, atlas.getGutter());
+        if(!padOk) printf("  %s: gutter does not wrap\n", TextureTranscoder::name(format));
+        ok = ok && padOk;
+    }
+    return ok;
+}
+BENCH_CHECK(CheckAtlasPad);
@@ -0,0 +1,47 @@
+#include "bench.h"
+#include "bench_data.h"
+#include "../_utils/base64_decoder.h"
+
+/*
+** Base64Decoder::decode on 1-16 MB payloads, {MB, simd}. The label
+** names the compiled SIMD backend.
+*/
+static void BM_Base64Decode(Bench::State& state) {
+    size_t bytes = static_cast<size_t>(state.range(0)) << 20;
+    bool simd = state.range(1) != 0;
+    std::string encoded = BenchData::makeBase64(bytes);
+    while(state.keepRunning()) {
+        std::vector<unsigned char> decoded = simd ?
+            Base64Decoder::decode(encoded) :
+            Base64Decoder::decodeScalar(encoded);
+        Bench::doNotOptimize(decoded);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(encoded.size());
+    state.label = simd ? Base64Decoder::backend() : "scalar";
+}
+BENCHMARK(BM_Base64Decode, {1, 0}, {1, 1}, {4, 0}, {4, 1}, {16, 0}, {16, 1});
+
+/*
+** Chunked decode as a texture upload feeds it, 16 KiB of input per
+** write into a buffer reserved up front
+*/
+static void BM_Base64DecodeStream(Bench::State& state) {
+    size_t bytes = static_cast<size_t>(state.range(0)) << 20;
+    std::string encoded = BenchData::makeBase64(bytes);
+    std::string_view view(encoded);
+    const size_t chunk = 16 << 10;
+    std::vector<unsigned char> decoded;
+    while(state.keepRunning()) {
+        decoded.clear();
+        decoded.reserve(bytes);
+        Base64Decoder::Stream stream;
+        bool ok = true;
+        for(size_t i = 0; i < view.size() && ok; i += chunk) {
+            ok = stream.write(view.substr(i, chunk), decoded);
+        }
+        ok = ok && stream.finish(decoded);
+        Bench::doNotOptimize(ok);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(encoded.size());
+}
+BENCHMARK(BM_Base64DecodeStream, {4}, {16});
@@ -0,0 +1,244 @@
+#include "bench.h"
+#include "../_platform/platform.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+
+namespace {
+    struct Entry {
+        std::string name;
+        Bench::Function fn;
+        std::vector<int64_t> args;
+    };
+
+    struct Result {
+        std::string name;
+        int64_t iterations;
+        double nsPerIteration;
+        double bytesPerSecond;
+        double itemsPerSecond;
+        std::string label;
+    };
+
+    struct CheckEntry {
+        std::string name;
+        Bench::Check fn;
+    };
+
+    std::vector<Entry>& registry() {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    std::vector<CheckEntry>& checks() {
+        static std::vector<CheckEntry> entries;
+        return entries;
+    }
+
+    std::string entryName(const std::string& base, const std::vector<int64_t>& args) {
+        std::string name = base;
+        for(int64_t arg : args) name += "/" + std::to_string(arg);
+        return name;
+    }
+
+    std::string escape(const std::string& str) {
+        std::string out;
+        for(char c : str) {
+            if(c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+    Result run(const Entry& entry, double minTime) {
+        int64_t iterations = 1;
+        while(true) {
+            Bench::State state(iterations, entry.args);
+            entry.fn(state);
+            double elapsedMs = state.getElapsedMs();
+
+            bool done = 
+                elapsedMs >= minTime * 1000.0 || 
+                iterations >= 1000000000;
+            if(done) {
+                double seconds = elapsedMs / 1000.0;
+                Result result;
+                result.name = entryName(entry.name, entry.args);
+                result.iterations = iterations;
+                result.nsPerIteration = elapsedMs * 1e6 / iterations;
+                result.bytesPerSecond = seconds > 0.0 ? state.bytesProcessed / seconds : 0.0;
+                result.itemsPerSecond = seconds > 0.0 ? state.itemsProcessed / seconds : 0.0;
+                result.label = state.label;
+                return result;
+            }
+
+            /* Aim for the min time with some headroom, growing at most 10x per pass */
+            double scale = elapsedMs > 0.0 ? (minTime * 1000.0 * 1.4) / elapsedMs : 10.0;
+            scale = std::min(std::max(scale, 1.5), 10.0);
+            iterations = static_cast<int64_t>(iterations * scale) + 1;
+        }
+    }
+
+    void writeJson(const std::string& path, const std::vector<Result>& results) {
+        std::ofstream out(path);
+        if(!out.is_open()) {
+            fprintf(stderr, "Failed to open %s\n", path.c_str());
+            return;
+        }
+
+        char date[64];
+        time_t now = time(nullptr);
+        strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+        out.precision(10);
+        out << "{\n  \"context\": {\n";
+        out << "    \"date\": \"" << date << "\",\n";
+        out << "    \"library_build_type\": \"" <<
+#ifdef NDEBUG
+            "release"
+#else
+            "debug"
+#endif
+            << "\"\n  },\n  \"benchmarks\": [\n";
+        for(size_t i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            out << "    {\n";
+            out << "      \"name\": \"" << escape(r.name) << "\",\n";
+            out << "      \"iterations\": " << r.iterations << ",\n";
+            out << "      \"real_time\": " << r.nsPerIteration << ",\n";
+            out << "      \"time_unit\": \"ns\"";
+            if(r.bytesPerSecond > 0.0) out << ",\n      \"bytes_per_second\": " << r.bytesPerSecond;
+            if(r.itemsPerSecond > 0.0) out << ",\n      \"items_per_second\": " << r.itemsPerSecond;
+            if(!r.label.empty()) out << ",\n      \"label\": \"" << escape(r.label) << "\"";
+            out << "\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    std::string humanRate(double value, const char* unit) {
+        const char* prefixes[] = { "", "k", "M", "G", "T" };
+        int p = 0;
+        while(value >= 1000.0 && p < 4) {
+            value /= 1000.0;
+            p++;
+        }
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.2f %s%s/s", value, prefixes[p], unit);
+        return buf;
+    }
+}
+
+/*
+** State
+*/
+Bench::State::State(int64_t iterations, const std::vector<int64_t>& args) :
+    iterations(iterations),
+    remaining(iterations),
+    args(args),
+    started(false),
+    startTime(0.0),
+    elapsedMs(0.0),
+    pausedNs(0.0),
+    pauseStart(0.0),
+    paused(false),
+    bytesProcessed(0),
+    itemsProcessed(0)
+{}
+
+bool Bench::State::keepRunningSlow() {
+    if(!started) {
+        started = true;
+        startTime = Platform::now();
+        if(remaining > 0) {
+            remaining--;
+            return true;
+        }
+    }
+    if(paused) resumeTiming();
+    elapsedMs = Platform::now() - startTime;
+    return false;
+}
+
+void Bench::State::pauseTiming() {
+    if(paused) return;
+    paused = true;
+    pauseStart = Platform::now();
+}
+
+void Bench::State::resumeTiming() {
+    if(!paused) return;
+    paused = false;
+    pausedNs += (Platform::now() - pauseStart) * 1e6;
+}
+
+/*
+** Registry
+*/
+int Bench::add(const char* name, Function fn, std::vector<std::vector<int64_t>> args) {
+    if(args.empty()) args.push_back({});
+    for(const auto& a : args) {
+        registry().push_back({ name, fn, a });
+    }
+    return 0;
+}
+
+int Bench::addCheck(const char* name, Check fn) {
+    checks().push_back({ name, fn });
+    return 0;
+}
+
+/*
+** Run All
+*/
+int Bench::runAll(int argc, char** argv) {
+    std::string filter;
+    std::string jsonPath;
+    double minTime = 0.5;
+    bool checksOnly = false;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--checks-only") == 0) checksOnly = true;
+        else if(strncmp(argv[i], "--filter=", 9) == 0) filter = argv[i] + 9;
+        else if(strncmp(argv[i], "--json=", 7) == 0) jsonPath = argv[i] + 7;
+        else if(strncmp(argv[i], "--min-time=", 11) == 0) minTime = atof(argv[i] + 11);
+        else {
+            fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    int failed = 0;
+    for(const auto& check : checks()) {
+        if(!filter.empty() && check.name.find(filter) == std::string::npos) continue;
+        bool ok = check.fn();
+        printf("%-48s %s\n", check.name.c_str(), ok ? "ok" : "FAILED");
+        if(!ok) failed++;
+    }
+    if(checksOnly) return failed > 0 ? 1 : 0;
+
+    printf("%-48s %14s %12s %16s\n", "Benchmark", "Time", "Iterations", "Throughput");
+    printf("%s\n", std::string(94, '-').c_str());
+
+    std::vector<Result> results;
+    for(const auto& entry : registry()) {
+        std::string name = entryName(entry.name, entry.args);
+        if(!filter.empty() && name.find(filter) == std::string::npos) continue;
+
+        Result r = run(entry, minTime);
+        std::string rate = 
+            r.bytesPerSecond > 0.0 ? humanRate(r.bytesPerSecond, "B") :
+            r.itemsPerSecond > 0.0 ? humanRate(r.itemsPerSecond, "items") : "";
+        printf("%-48s %11.0f ns %12lld %16s %s\n",
+            r.name.c_str(), r.nsPerIteration, (long long)r.iterations, rate.c_str(), r.label.c_str());
+        fflush(stdout);
+        results.push_back(r);
+    }
+
+    if(!jsonPath.empty()) writeJson(jsonPath, results);
+    return failed > 0 ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    return Bench::runAll(argc, argv);
+}
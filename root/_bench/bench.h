@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+** Minimal Google-Benchmark style harness. Benchmarks register with
+** BENCHMARK(fn, {args}...) and loop on state.keepRunning().
+**
+** Correctness checks register with BENCH_CHECK(fn), a bool() that
+** prints its own findings. They run before the timings, under the same
+** filter, and any failure makes the run exit non-zero.
+**
+**   planet_bench [--filter=substr] [--json=out.json] [--min-time=seconds] [--checks-only]
+*/
+namespace Bench {
+    class State {
+        private:
+            int64_t iterations;
+            int64_t remaining;
+            std::vector<int64_t> args;
+            bool started;
+            double startTime;
+            double elapsedMs;
+            double pausedNs;
+            double pauseStart;
+            bool paused;
+
+            bool keepRunningSlow();
+
+        public:
+            State(int64_t iterations, const std::vector<int64_t>& args);
+
+            int64_t bytesProcessed;
+            int64_t itemsProcessed;
+            std::string label;
+
+            /* Setup before the first call and teardown after the last are not timed */
+            bool keepRunning() {
+                if(started && remaining > 0) {
+                    remaining--;
+                    return true;
+                }
+                return keepRunningSlow();
+            }
+            int64_t range(size_t index) const { return index < args.size() ? args[index] : 0; }
+            int64_t getIterations() const { return iterations; }
+            double getElapsedMs() const { return elapsedMs - pausedNs / 1e6; }
+
+            void pauseTiming();
+            void resumeTiming();
+    };
+
+    typedef void (*Function)(State&);
+    typedef bool (*Check)();
+
+    int add(const char* name, Function fn, std::vector<std::vector<int64_t>> args);
+    int addCheck(const char* name, Check fn);
+    int runAll(int argc, char** argv);
+
+    template<typename T>
+    inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T* sink;
+        sink = &value;
+#endif
+    }
+
+    inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#endif
+    }
+}
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+#define BENCHMARK(fn, ...) \
+    static int BENCH_CONCAT(fn##_registered_, __LINE__) = Bench::add(#fn, fn, { __VA_ARGS__ })
+#define BENCH_CHECK(fn) \
+    static int BENCH_CONCAT(fn##_registered_, __LINE__) = Bench::addCheck(#fn, fn)
@@ -0,0 +1,92 @@
+#include "bench_data.h"
+#include "../.preset/preset_converter.h"
+#include "../_utils/color_converter.h"
+#include <cmath>
+
+PresetData BenchData::makePreset(size_t bodies) {
+    static const char* colors[] = { "yellow", "#8c8c8c", "rgb(255, 120, 40)", "blue", "#40a0ff" };
+
+    PresetData preset;
+    preset.name = "bench";
+    preset.isDefault = false;
+    for(size_t i = 0; i < bodies; i++) {
+        PlanetData planet{};
+        planet.id = static_cast<uint32_t>(i);
+        planet.name = "Body " + std::to_string(i);
+        planet.shape = static_cast<BufferData::Type>(i % 3);
+        planet.size = 0.05f + (i % 9) * 0.01f;
+        planet.texture = TextureRegistry::NONE;
+        planet.color = colors[i % 5];
+        planet.colorRgb = ColorConverter::parseColor(planet.color);
+        planet.position = static_cast<int>(i % 15);
+        planet.rotationDir = static_cast<RotationAxis>(i % 3);
+        planet.rotationSpeedItself = 0.01f + (i % 7) * 0.005f;
+        planet.rotationSpeedCenter = i % 15 == 0 ? 0.0f : 0.001f + (i % 11) * 0.0005f;
+        planet.distanceFromCenter = 1.0f + (i % 15) * 0.15f;
+        planet.currentRotation = glm::vec3(0.0f);
+        planet.orbitAngle = glm::vec3(0.0f, static_cast<float>(i % 360), 0.0f);
+        preset.planets.push_back(planet);
+    }
+    return preset;
+}
+
+std::string BenchData::makePresetJson(size_t bodies) {
+    return PresetConverter::presetToData(makePreset(bodies));
+}
+
+/*
+** Presets as saved with uploaded textures: every planet carries an
+** inline base64 data URL
+*/
+std::string BenchData::makeTexturedPresetJson(size_t bodies, size_t textureBytes) {
+    DataParser::Value value = PresetConverter::presetToValue(makePreset(bodies));
+    std::string texture = "data:image/png;base64," + makeBase64(textureBytes);
+    DataParser::Value& planets = value["planets"];
+    for(size_t i = 0; i < planets.size(); i++) {
+        planets[i]["texture"] = DataParser::Value(texture);
+    }
+    return value.toString(false);
+}
+
+std::string BenchData::makeBase64(size_t decodedBytes) {
+    static const char chars[] = 
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string out;
+    out.reserve((decodedBytes + 2) / 3 * 4);
+    uint32_t seed = 0x9e3779b9u;
+    size_t i = 0;
+    for(; i + 3 <= decodedBytes; i += 3) {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t triple = seed >> 8;
+        out += chars[(triple >> 18) & 63];
+        out += chars[(triple >> 12) & 63];
+        out += chars[(triple >> 6) & 63];
+        out += chars[triple & 63];
+    }
+    size_t rest = decodedBytes - i;
+    if(rest == 1) {
+        out += "QQ==";
+    } else if(rest == 2) {
+        out += "QUI=";
+    }
+    return out;
+}
+
+std::vector<unsigned char> BenchData::makeTexturePixels(int side, bool alpha) {
+    std::vector<unsigned char> pixels(static_cast<size_t>(side) * side * 4);
+    uint32_t seed = 0x9e3779b9u;
+    for(int y = 0; y < side; y++) {
+        for(int x = 0; x < side; x++) {
+            seed = seed * 1664525u + 1013904223u;
+            unsigned char* p = &pixels[(static_cast<size_t>(y) * side + x) * 4];
+            float band = 0.5f + 0.5f * std::sin(y * 0.05f + std::sin(x * 0.01f) * 3.0f);
+            int noise = static_cast<int>(seed >> 28);
+            p[0] = static_cast<unsigned char>(band * 180 + noise);
+            p[1] = static_cast<unsigned char>(band * 120 + noise);
+            p[2] = static_cast<unsigned char>(band * 90 + noise);
+            p[3] = alpha ? static_cast<unsigned char>(band * 255) : 255;
+        }
+    }
+    return pixels;
+}
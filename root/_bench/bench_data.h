@@ -0,0 +1,16 @@
+#pragma once
+#include "../.preset/preset_data.h"
+#include <string>
+#include <vector>
+
+/*
+** Deterministic synthetic inputs shared by the benchmarks.
+*/
+namespace BenchData {
+    PresetData makePreset(size_t bodies);
+    std::string makePresetJson(size_t bodies);
+    std::string makeTexturedPresetJson(size_t bodies, size_t textureBytes);
+    std::string makeBase64(size_t decodedBytes);
+    /* Planet-map-like RGBA: smooth bands with a little noise */
+    std::vector<unsigned char> makeTexturePixels(int side, bool alpha);
+}
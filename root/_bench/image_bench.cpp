@@ -0,0 +1,79 @@
+#include "bench.h"
+#include "bench_data.h"
+#include "../_utils/image_decoder.h"
+#include <cstdlib>
+#include <png.h>
+#include <jpeglib.h>
+
+static std::vector<unsigned char> encodePng(const std::vector<unsigned char>& pixels, int side) {
+    png_image image{};
+    image.version = PNG_IMAGE_VERSION;
+    image.width = side;
+    image.height = side;
+    image.format = PNG_FORMAT_RGBA;
+    png_alloc_size_t size = 0;
+    png_image_write_to_memory(&image, nullptr, &size, 0, pixels.data(), 0, nullptr);
+    std::vector<unsigned char> out(size);
+    png_image_write_to_memory(&image, out.data(), &size, 0, pixels.data(), 0, nullptr);
+    out.resize(size);
+    return out;
+}
+
+static std::vector<unsigned char> encodeJpeg(const std::vector<unsigned char>& pixels, int side) {
+    jpeg_compress_struct info;
+    jpeg_error_mgr err;
+    info.err = jpeg_std_error(&err);
+    jpeg_create_compress(&info);
+    unsigned char* buffer = nullptr;
+    unsigned long size = 0;
+    jpeg_mem_dest(&info, &buffer, &size);
+    info.image_width = side;
+    info.image_height = side;
+    info.input_components = 3;
+    info.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&info);
+    jpeg_set_quality(&info, 85, TRUE);
+    jpeg_start_compress(&info, TRUE);
+    std::vector<unsigned char> row(static_cast<size_t>(side) * 3);
+    while(info.next_scanline < info.image_height) {
+        const unsigned char* src = &pixels[static_cast<size_t>(info.next_scanline) * side * 4];
+        for(int x = 0; x < side; x++) {
+            row[x * 3] = src[x * 4];
+            row[x * 3 + 1] = src[x * 4 + 1];
+            row[x * 3 + 2] = src[x * 4 + 2];
+        }
+        unsigned char* rows[1] = { row.data() };
+        jpeg_write_scanlines(&info, rows, 1);
+    }
+    jpeg_finish_compress(&info);
+    jpeg_destroy_compress(&info);
+    std::vector<unsigned char> out(buffer, buffer + size);
+    free(buffer);
+    return out;
+}
+
+/*
+ * Texture-like test images, encoded once per benchmark
+ */
+static std::vector<unsigned char> encodeImage(int format, int side) {
+    std::vector<unsigned char> pixels = BenchData::makeTexturePixels(side, false);
+    return format == 0 ? encodePng(pixels, side) : encodeJpeg(pixels, side);
+}
+
+/*
+** Decode cost per image, {0 png / 1 jpeg, side}; this is the work
+** the decode queue keeps off the render thread
+*/
+static void BM_ImageDecode(Bench::State& state) {
+    int format = static_cast<int>(state.range(0));
+    int side = static_cast<int>(state.range(1));
+    std::vector<unsigned char> encoded = encodeImage(format, side);
+    ImageDecoder::Image image;
+    while(state.keepRunning()) {
+        bool ok = ImageDecoder::decode(encoded.data(), encoded.size(), image);
+        Bench::doNotOptimize(ok);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(image.pixels.size());
+    state.label = std::to_string(encoded.size()) + (format == 0 ? " B png" : " B jpeg");
+}
+BENCHMARK(BM_ImageDecode, {0, 512}, {0, 2048}, {1, 512}, {1, 2048});
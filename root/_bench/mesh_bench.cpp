@@ -0,0 +1,50 @@
+#include "bench.h"
+#include "../.buffers/mesh_generator.h"
+#include "../.buffers/ray_intersection.h"
+
+/*
+** Sphere generation
+*/
+static void BM_CubeSphere(Bench::State& state) {
+    int subdivisions = static_cast<int>(state.range(0));
+    size_t vertices = 0;
+    while(state.keepRunning()) {
+        BufferData::MeshData mesh = MeshGenerator::cubeSphere(subdivisions);
+        vertices = mesh.vertices.size() / BufferData::VERTEX_STRIDE;
+        Bench::doNotOptimize(mesh);
+    }
+    state.label = std::to_string(vertices) + " verts";
+}
+BENCHMARK(BM_CubeSphere, {8}, {16}, {32}, {64});
+
+static void BM_Icosphere(Bench::State& state) {
+    int subdivisions = static_cast<int>(state.range(0));
+    size_t vertices = 0;
+    while(state.keepRunning()) {
+        BufferData::MeshData mesh = MeshGenerator::icosphere(subdivisions);
+        vertices = mesh.vertices.size() / BufferData::VERTEX_STRIDE;
+        Bench::doNotOptimize(mesh);
+    }
+    state.label = std::to_string(vertices) + " verts";
+}
+BENCHMARK(BM_Icosphere, {1}, {3}, {5});
+
+/*
+** Mesh raycast, against the default sphere LOD.
+** Arg 0 = miss (full triangle scan), 1 = hit.
+*/
+static void BM_MeshIntersection(Bench::State& state) {
+    BufferData::GetMeshData(BufferData::Type::SPHERE);
+
+    glm::vec3 origin(0.0f, 0.0f, 5.0f);
+    glm::vec3 planet(0.0f, 0.0f, 0.0f);
+    glm::vec3 dir = state.range(0) ? 
+        glm::vec3(0.0f, 0.0f, -1.0f) : 
+        glm::normalize(glm::vec3(0.5f, 0.0f, -1.0f));
+    while(state.keepRunning()) {
+        bool hit = RayIntersection::mesh(origin, dir, planet, 1.0f, BufferData::Type::SPHERE);
+        Bench::doNotOptimize(hit);
+    }
+    state.itemsProcessed = state.getIterations();
+}
+BENCHMARK(BM_MeshIntersection, {0}, {1});
@@ -0,0 +1,110 @@
+/*
+** Native microbenchmark for the orbital state update. Also checks the
+** SIMD kernels against the scalar reference and exits non-zero when
+** they disagree beyond tolerance.
+**
+**   g++ -O2 -std=c++17 -I. _bench/orbital_bench.cpp .buffers/orbital_state.cpp .buffers/orbital_kernel.cpp -o orbital_bench
+**   ./orbital_bench [bodies] [frames]
+*/
+#include "../.buffers/orbital_state.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+static const float ANGLE_TOLERANCE = 1e-4f;
+static const float POSITION_TOLERANCE = 1e-5f;
+
+static void fill(OrbitalState& state, size_t bodies) {
+    state.reserve(bodies);
+    for(size_t i = 0; i < bodies; i++) {
+        PlanetData data{};
+        data.position = static_cast<int>(i % 15);
+        data.rotationDir = static_cast<RotationAxis>(i % 3);
+        data.rotationSpeedItself = 0.5f + (i % 7) * 0.1f - (i % 5 == 0 ? 1.5f : 0.0f);
+        data.rotationSpeedCenter = 0.001f + (i % 11) * 0.0005f;
+        data.distanceFromCenter = 1.0f + (i % 15) * 0.15f;
+        data.currentRotation = glm::vec3(static_cast<float>(i % 359), 0.0f, 0.0f);
+        data.orbitAngle = glm::vec3(0.0f, static_cast<float>(i % 720) - 360.0f, 0.0f);
+        state.push(data);
+    }
+}
+
+/* Angles may land on either side of a 360 boundary */
+static float angleError(float a, float b) {
+    float diff = fabs(a - b);
+    return fmin(diff, fabs(diff - 360.0f));
+}
+
+static bool verify(size_t bodies) {
+    OrbitalState scalar;
+    OrbitalState simd;
+    fill(scalar, bodies);
+    fill(simd, bodies);
+    scalar.useSimd = false;
+    simd.useSimd = true;
+
+    float maxAngle = 0.0f;
+    float maxPosition = 0.0f;
+    for(int f = 0; f < 4; f++) {
+        scalar.advance(0.37f, 31.0f);
+        simd.advance(0.37f, 31.0f);
+        scalar.updatePositions();
+
+        for(size_t i = 0; i < bodies; i++) {
+            maxAngle = fmax(maxAngle, angleError(scalar.rotationX[i], simd.rotationX[i]));
+            maxAngle = fmax(maxAngle, angleError(scalar.rotationY[i], simd.rotationY[i]));
+            maxAngle = fmax(maxAngle, angleError(scalar.rotationZ[i], simd.rotationZ[i]));
+            maxAngle = fmax(maxAngle, angleError(scalar.orbitAngle[i], simd.orbitAngle[i]));
+        }
+
+        simd.orbitAngle = scalar.orbitAngle;
+        simd.updatePositions();
+        for(size_t i = 0; i < bodies; i++) {
+            float radius = scalar.distanceFromCenter[i];
+            maxPosition = fmax(maxPosition, fabs(scalar.worldX[i] - simd.worldX[i]) / radius);
+            maxPosition = fmax(maxPosition, fabs(scalar.worldZ[i] - simd.worldZ[i]) / radius);
+        }
+    }
+
+    bool ok = maxAngle <= ANGLE_TOLERANCE && maxPosition <= POSITION_TOLERANCE;
+    printf("verify: max angle err %.3g deg, max sin/cos err %.3g -> %s\n",
+        maxAngle, maxPosition, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+static void run(const char* label, bool useSimd, size_t bodies, int frames) {
+    OrbitalState state;
+    fill(state, bodies);
+    state.useSimd = useSimd;
+
+    const float deltaTime = 1.0f / 60.0f;
+    double advanceNs = 0.0;
+    double positionsNs = 0.0;
+    for(int f = 0; f < frames; f++) {
+        auto start = std::chrono::steady_clock::now();
+        state.advance(20.0f * deltaTime, 2000.0f * deltaTime);
+        auto mid = std::chrono::steady_clock::now();
+        state.updatePositions();
+        auto end = std::chrono::steady_clock::now();
+
+        advanceNs += std::chrono::duration<double, std::nano>(mid - start).count();
+        positionsNs += std::chrono::duration<double, std::nano>(end - mid).count();
+    }
+
+    double scale = 100000.0 / static_cast<double>(bodies) / frames / 1e6;
+    printf("%-7s advance %.3f ms, updatePositions %.3f ms / 100k bodies (checksum %f)\n",
+        label, advanceNs * scale, positionsNs * scale,
+        state.worldX[bodies / 2] + state.rotationY[bodies / 3]);
+}
+
+int main(int argc, char** argv) {
+    size_t bodies = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+    int frames = argc > 2 ? atoi(argv[2]) : 200;
+
+    printf("bodies=%zu frames=%d simd=%s\n", bodies, frames, OrbitalKernel::hasSimd() ? "yes" : "no");
+    bool ok = verify(bodies + 3);
+    run("scalar", false, bodies, frames);
+    run("simd", true, bodies, frames);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,310 @@
+#include "bench.h"
+#include "bench_data.h"
+#include "../_data/data_parser.h"
+#include "../_data/data_document.h"
+#include "../_data/structural_index.h"
+#include "../_data/data_writer.h"
+#include "../.preset/preset_converter.h"
+#include "../.preset/preset_binary.h"
+#include "../.preset/preset_journal.h"
+#include "../_platform/file_source.h"
+#include <fstream>
+#include <sstream>
+
+/*
+** DataParser::Parser::parse on presets of increasing size
+*/
+static void BM_ParserParse(Bench::State& state) {
+    std::string json = BenchData::makePresetJson(state.range(0));
+    while(state.keepRunning()) {
+        DataParser::Value root = DataParser::Parser::parse(json);
+        Bench::doNotOptimize(root);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(json.size());
+}
+BENCHMARK(BM_ParserParse, {10}, {100}, {1000}, {10000});
+
+/*
+** Arena document, reused across iterations as a loader would
+*/
+static void BM_DocumentParse(Bench::State& state) {
+    std::string json = BenchData::makePresetJson(state.range(0));
+    DataParser::Document doc;
+    while(state.keepRunning()) {
+        const DataParser::Node& root = doc.parse(json);
+        Bench::doNotOptimize(root);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(json.size());
+    state.label = std::to_string(doc.getArenaBlocks()) + " arena blocks";
+}
+BENCHMARK(BM_DocumentParse, {10}, {100}, {1000}, {10000});
+
+/*
+** Presets with inline base64 textures, {bodies, texture bytes}
+*/
+static void BM_ParserParseTextured(Bench::State& state) {
+    std::string json = BenchData::makeTexturedPresetJson(state.range(0), state.range(1));
+    while(state.keepRunning()) {
+        DataParser::Value root = DataParser::Parser::parse(json);
+        Bench::doNotOptimize(root);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(json.size());
+}
+BENCHMARK(BM_ParserParseTextured, {8, 256 << 10}, {8, 1 << 20}, {100, 64 << 10});
+
+static void BM_DocumentParseTextured(Bench::State& state) {
+    std::string json = BenchData::makeTexturedPresetJson(state.range(0), state.range(1));
+    DataParser::Document doc;
+    while(state.keepRunning()) {
+        const DataParser::Node& root = doc.parse(json);
+        Bench::doNotOptimize(root);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(json.size());
+}
+BENCHMARK(BM_DocumentParseTextured, {8, 256 << 10}, {8, 1 << 20}, {100, 64 << 10});
+
+/*
+** Stage one alone, scalar table against the SIMD classifier
+*/
+static void BM_StructuralIndex(Bench::State& state) {
+    std::string json = state.range(0) == 0 ?
+        BenchData::makePresetJson(10000) :
+        BenchData::makeTexturedPresetJson(8, 1 << 20);
+    std::vector<uint32_t> index;
+    bool simd = state.range(1) != 0;
+    while(state.keepRunning()) {
+        bool ok = simd ?
+            StructuralIndex::buildSimd(json, index) :
+            StructuralIndex::buildScalar(json, index);
+        Bench::doNotOptimize(ok);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(json.size());
+    state.label = std::string(state.range(0) == 0 ? "plain" : "textured") + 
+        (simd ? std::string(" ") + StructuralIndex::backend() : " scalar");
+}
+BENCHMARK(BM_StructuralIndex, {0, 0}, {0, 1}, {1, 0}, {1, 1});
+
+/*
+** Preset round-trips
+*/
+static void BM_PresetToData(Bench::State& state) {
+    PresetData preset = BenchData::makePreset(state.range(0));
+    size_t bytes = 0;
+    while(state.keepRunning()) {
+        std::string data = PresetConverter::presetToData(preset);
+        bytes = data.size();
+        Bench::doNotOptimize(data);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(bytes);
+}
+BENCHMARK(BM_PresetToData, {10}, {100}, {1000}, {10000});
+
+/*
+** Writer into a fixed sink buffer, and the Value tree path for comparison
+*/
+static void countSink(void* user, const char* data, size_t size) {
+    (void)data;
+    *static_cast<size_t*>(user) += size;
+}
+
+static void BM_PresetWriteSink(Bench::State& state) {
+    PresetData preset = BenchData::makePreset(state.range(0));
+    size_t bytes = 0;
+    while(state.keepRunning()) {
+        size_t written = 0;
+        {
+            DataParser::Writer writer(countSink, &written);
+            PresetConverter::writePreset(writer, preset);
+        }
+        bytes = written;
+        Bench::doNotOptimize(written);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(bytes);
+}
+BENCHMARK(BM_PresetWriteSink, {1000}, {10000});
+
+static void BM_PresetValueToString(Bench::State& state) {
+    PresetData preset = BenchData::makePreset(state.range(0));
+    size_t bytes = 0;
+    while(state.keepRunning()) {
+        std::string data = PresetConverter::presetToValue(preset).toString(false);
+        bytes = data.size();
+        Bench::doNotOptimize(data);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(bytes);
+}
+BENCHMARK(BM_PresetValueToString, {1000}, {10000});
+
+static void BM_ConvertToPreset(Bench::State& state) {
+    std::string json = BenchData::makePresetJson(state.range(0));
+    while(state.keepRunning()) {
+        PresetData preset;
+        bool ok = PresetConverter::convertToPreset(json, preset);
+        Bench::doNotOptimize(ok);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(json.size());
+}
+BENCHMARK(BM_ConvertToPreset, {10}, {100}, {1000}, {10000});
+
+/*
+** Preset import through the arena document, for comparison with the
+** streaming reader behind convertToPreset
+*/
+static void BM_DocumentToPreset(Bench::State& state) {
+    std::string json = BenchData::makePresetJson(state.range(0));
+    DataParser::Document doc;
+    while(state.keepRunning()) {
+        PresetData preset;
+        bool ok = PresetConverter::nodeToPreset(doc.parse(json), preset);
+        Bench::doNotOptimize(ok);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(json.size());
+}
+BENCHMARK(BM_DocumentToPreset, {10}, {100}, {1000}, {10000});
+
+static void BM_PresetRoundTrip(Bench::State& state) {
+    PresetData preset = BenchData::makePreset(state.range(0));
+    while(state.keepRunning()) {
+        PresetData out;
+        bool ok = PresetConverter::convertToPreset(PresetConverter::presetToData(preset), out);
+        Bench::doNotOptimize(ok);
+    }
+    state.itemsProcessed = state.getIterations() * state.range(0);
+}
+BENCHMARK(BM_PresetRoundTrip, {10}, {100}, {1000});
+
+/*
+** Binary preset against JSON, as a startup load would see it. The
+** label carries the stored size of each format.
+*/
+static void BM_PresetBinaryEncode(Bench::State& state) {
+    PresetData preset = BenchData::makePreset(state.range(0));
+    size_t bytes = 0;
+    while(state.keepRunning()) {
+        std::string data = PresetBinary::encode(preset);
+        bytes = data.size();
+        Bench::doNotOptimize(data);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(bytes);
+    state.label = std::to_string(bytes) + " B binary, " +
+        std::to_string(PresetConverter::presetToData(preset).size()) + " B json";
+}
+BENCHMARK(BM_PresetBinaryEncode, {10}, {1000}, {10000});
+
+static void BM_PresetBinaryDecode(Bench::State& state) {
+    std::string data = PresetBinary::encode(BenchData::makePreset(state.range(0)));
+    while(state.keepRunning()) {
+        PresetData preset;
+        bool ok = PresetBinary::decode(data, preset);
+        Bench::doNotOptimize(ok);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(data.size());
+    state.itemsProcessed = state.getIterations() * state.range(0);
+}
+BENCHMARK(BM_PresetBinaryDecode, {10}, {1000}, {10000});
+
+/*
+** Preset load from disk: stream copy into a string against the mapped
+** FileSource view, both parsed by the streaming reader
+*/
+static std::string writePresetFile(size_t bodies) {
+    std::string path = "/tmp/planet_bench_preset_" + std::to_string(bodies) + ".json";
+    std::ofstream file(path, std::ios::binary);
+    file << BenchData::makePresetJson(bodies);
+    return path;
+}
+
+static void BM_PresetLoadStream(Bench::State& state) {
+    std::string path = writePresetFile(state.range(0));
+    size_t bytes = 0;
+    while(state.keepRunning()) {
+        std::ifstream file(path);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        std::string data = buffer.str();
+        PresetData preset;
+        bool ok = PresetConverter::convertToPreset(data, preset);
+        bytes = data.size();
+        Bench::doNotOptimize(ok);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(bytes);
+}
+BENCHMARK(BM_PresetLoadStream, {1000}, {10000});
+
+static void BM_PresetLoadMapped(Bench::State& state) {
+    std::string path = writePresetFile(state.range(0));
+    size_t bytes = 0;
+    while(state.keepRunning()) {
+        FileSource file(path);
+        PresetData preset;
+        bool ok = PresetConverter::convertToPreset(file.view(), preset);
+        bytes = file.size();
+        Bench::doNotOptimize(ok);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(bytes);
+}
+BENCHMARK(BM_PresetLoadMapped, {1000}, {10000});
+
+/*
+** Persisting one planet edit in a 2k-planet system: full JSON and
+** binary snapshots against a single journal record
+*/
+static void BM_PresetSaveSnapshot(Bench::State& state) {
+    PresetData preset = BenchData::makePreset(2000);
+    bool binary = state.range(0) != 0;
+    size_t bytes = 0;
+    while(state.keepRunning()) {
+        preset.planets[7].size += 0.001f;
+        std::string data = binary ?
+            PresetBinary::encode(preset) :
+            PresetConverter::presetToData(preset);
+        bytes = data.size();
+        Bench::doNotOptimize(data);
+    }
+    state.label = std::to_string(bytes) + (binary ? " B binary" : " B json");
+}
+BENCHMARK(BM_PresetSaveSnapshot, {0}, {1});
+
+static void BM_PresetSaveJournal(Bench::State& state) {
+    PresetData preset = BenchData::makePreset(2000);
+    PresetJournal journal;
+    size_t bytes = 0;
+    while(state.keepRunning()) {
+        preset.planets[7].size += 0.001f;
+        journal.add(preset.planets.size(), preset.planets[7]);
+        std::string data = PresetJournal::encode(journal.getEntries().back());
+        journal.clear();
+        bytes = data.size();
+        Bench::doNotOptimize(data);
+    }
+    state.label = std::to_string(bytes) + " B record";
+}
+BENCHMARK(BM_PresetSaveJournal, {0});
+
+/*
+** Presets where every planet uses the same uploaded texture: copying
+** the preset and saving it, {bodies, texture bytes}
+*/
+static void BM_PresetCopyTextured(Bench::State& state) {
+    PresetData preset;
+    PresetConverter::convertToPreset(BenchData::makeTexturedPresetJson(state.range(0), state.range(1)), preset);
+    while(state.keepRunning()) {
+        PresetData copy = preset;
+        Bench::doNotOptimize(copy);
+    }
+    state.itemsProcessed = state.getIterations() * state.range(0);
+}
+BENCHMARK(BM_PresetCopyTextured, {100, 64 << 10}, {1000, 64 << 10});
+
+static void BM_PresetSaveTextured(Bench::State& state) {
+    PresetData preset;
+    PresetConverter::convertToPreset(BenchData::makeTexturedPresetJson(state.range(0), state.range(1)), preset);
+    size_t bytes = 0;
+    while(state.keepRunning()) {
+        std::string data = PresetConverter::presetToData(preset);
+        bytes = data.size();
+        Bench::doNotOptimize(data);
+    }
+    state.label = std::to_string(bytes) + " B json";
+}
+BENCHMARK(BM_PresetSaveTextured, {100, 64 << 10}, {1000, 64 << 10});
@@ -0,0 +1,31 @@
+#include "bench.h"
+#include "bench_data.h"
+#include "../.buffers/buffer_generator.h"
+#include "../.buffers/orbital_state.h"
+
+/*
+** updatePlanetRotation + updatePositions per frame.
+** Arg 0 = bodies, arg 1 = 1 for the SIMD kernel.
+*/
+static void BM_UpdatePlanetRotation(Bench::State& state) {
+    PresetData preset = BenchData::makePreset(state.range(0));
+    OrbitalState orbitalState;
+    orbitalState.reserve(preset.planets.size());
+    for(const auto& planet : preset.planets) {
+        orbitalState.push(planet);
+    }
+    orbitalState.useSimd = state.range(1) != 0;
+
+    BufferGenerator generator(nullptr);
+    while(state.keepRunning()) {
+        generator.updatePlanetRotation(orbitalState, 1.0f / 60.0f);
+        orbitalState.updatePositions();
+        Bench::clobberMemory();
+    }
+    state.itemsProcessed = state.getIterations() * state.range(0);
+}
+BENCHMARK(
+    BM_UpdatePlanetRotation, 
+    {10, 0}, {1000, 0}, {100000, 0},
+    {10, 1}, {1000, 1}, {100000, 1}
+);
@@ -0,0 +1,214 @@
+#include "bench.h"
+#include "bench_data.h"
+#include "../_utils/texture_transcoder.h"
+#include "../_utils/ktx2_reader.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+using Format = TextureTranscoder::Format;
+
+static const Format FORMATS[] = { Format::BC1, Format::BC3, Format::ETC2_RGB8, Format::ETC2_RGBA8 };
+
+static bool hasAlpha(Format format) {
+    return format == Format::BC3 || format == Format::ETC2_RGBA8;
+}
+
+/*
+ * PSNR of level 0 after a round trip, over the channels the format keeps
+ */
+static double roundTripPsnr(const ImageDecoder::Image& image, const TextureTranscoder::Texture& texture) {
+    ImageDecoder::Image decoded;
+    const TextureTranscoder::Level& level = texture.levels[0];
+    if(!TextureTranscoder::decode(texture.data.data() + level.offset, level.size, texture.format, level.width, level.height, decoded)) return 0.0;
+    int channels = hasAlpha(texture.format) ? 4 : 3;
+    double sum = 0;
+    for(size_t i = 0; i < image.pixels.size(); i += 4) {
+        for(int c = 0; c < channels; c++) {
+            double d = static_cast<double>(image.pixels[i + c]) - decoded.pixels[i + c];
+            sum += d * d;
+        }
+    }
+    double mse = sum / (image.pixels.size() / 4 * channels);
+    return mse > 0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0;
+}
+
+/*
+** Encode with the full mip chain, {format, side}; formats are BC1,
+** BC3, ETC2, ETC2+EAC. The label gives the memory saved against RGBA8
+** with mips and the round-trip PSNR
+*/
+static void BM_TextureEncode(Bench::State& state) {
+    Format format = FORMATS[state.range(0)];
+    ImageDecoder::Image image;
+    image.width = image.height = static_cast<int>(state.range(1));
+    image.pixels = BenchData::makeTexturePixels(image.width, hasAlpha(format));
+    TextureTranscoder::Texture texture;
+    while(state.keepRunning()) {
+        bool ok = TextureTranscoder::encode(image, format, true, texture);
+        Bench::doNotOptimize(ok);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(image.pixels.size());
+
+    TextureTranscoder::Texture rgba;
+    TextureTranscoder::encode(image, Format::RGBA8, true, rgba);
+    char label[64];
+    snprintf(label, sizeof(label), "%s %.1fx %.1f dB",
+        TextureTranscoder::name(format),
+        static_cast<double>(rgba.data.size()) / texture.data.size(),
+        roundTripPsnr(image, texture));
+    state.label = label;
+}
+BENCHMARK(BM_TextureEncode, {0, 512}, {0, 2048}, {1, 2048}, {2, 512}, {2, 2048}, {3, 2048});
+
+/*
+** CPU fallback for a KTX2 level the context cannot sample, {format, side}
+*/
+static void BM_TextureDecode(Bench::State& state) {
+    Format format = FORMATS[state.range(0)];
+    ImageDecoder::Image image;
+    image.width = image.height = static_cast<int>(state.range(1));
+    image.pixels = BenchData::makeTexturePixels(image.width, true);
+    TextureTranscoder::Texture texture;
+    TextureTranscoder::encode(image, format, false, texture);
+    ImageDecoder::Image decoded;
+    while(state.keepRunning()) {
+        bool ok = TextureTranscoder::decode(texture.data.data(), texture.data.size(), format, image.width, image.height, decoded);
+        Bench::doNotOptimize(ok);
+    }
+    state.bytesProcessed = state.getIterations() * static_cast<int64_t>(decoded.pixels.size());
+    state.label = TextureTranscoder::name(format);
+}
+BENCHMARK(BM_TextureDecode, {0, 2048}, {1, 2048}, {2, 2048}, {3, 2048});
+
+/*
+** Checks
+*/
+/* Floor under the round trip of the smooth bench texture; the encoders land at 40-42 dB */
+static const double MIN_PSNR = 36.0;
+static const int CHECK_SIDE = 256;
+
+/*
+ * Every format round-trips level 0 above the PSNR floor, and the mip
+ * chain halves down to 1x1 with levels packed back to back
+ */
+static bool CheckTextureRoundTrip() {
+    bool ok = true;
+    for(Format format : FORMATS) {
+        ImageDecoder::Image image;
+        image.width = image.height = CHECK_SIDE;
+        image.pixels = BenchData::makeTexturePixels(image.width, hasAlpha(format));
+        TextureTranscoder::Texture texture;
+        if(!TextureTranscoder::encode(image, format, true, texture)) {
+            printf("  %s: encode failed\n", TextureTranscoder::name(format));
+            ok = false;
+            continue;
+        }
+
+        size_t offset = 0;
+        bool chain = texture.levels.size() == 9;
+        for(size_t l = 0; chain && l < texture.levels.size(); l++) {
+            const TextureTranscoder::Level& level = texture.levels[l];
+            int side = std::max(1, CHECK_SIDE >> l);
+            chain = level.width == side && level.height == side && level.offset == offset
+                && level.size == TextureTranscoder::levelSize(format, side, side);
+            offset += level.size;
+        }
+        chain = chain && offset == texture.data.size();
+        if(!chain) printf("  %s: malformed mip chain\n", TextureTranscoder::name(format));
+
+        double psnr = roundTripPsnr(image, texture);
+        if(psnr < MIN_PSNR) printf("  %s: %.1f dB, below %.1f dB\n", TextureTranscoder::name(format), psnr, MIN_PSNR);
+        ok = ok && chain && psnr >= MIN_PSNR;
+    }
+    return ok;
+}
+BENCH_CHECK(CheckTextureRoundTrip);
+
+static void putU32(unsigned char* p, uint32_t value) {
+    for(int i = 0; i < 4; i++) p[i] = static_cast<unsigned char>(value >> (i * 8));
+}
+
+static void putU64(unsigned char* p, uint64_t value) {
+    putU32(p, static_cast<uint32_t>(value));
+    putU32(p + 4, static_cast<uint32_t>(value >> 32));
+}
+
+/*
+ * Minimal KTX2 file for a texture: header, level index, then the
+ * levels in chain order. vkFormat and the supercompression scheme are
+ * taken as given
+ */
+static std::vector<unsigned char> makeKtx2(const TextureTranscoder::Texture& texture, uint32_t vkFormat, uint32_t supercompression) {
+    static const unsigned char SIGNATURE[12] = {
+        0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+    };
+    size_t indexEnd = 80 + texture.levels.size() * 24;
+    std::vector<unsigned char> out(indexEnd, 0);
+    memcpy(out.data(), SIGNATURE, sizeof(SIGNATURE));
+    putU32(&out[12], vkFormat);
+    putU32(&out[16], 1);
+    putU32(&out[20], static_cast<uint32_t>(texture.width));
+    putU32(&out[24], static_cast<uint32_t>(texture.height));
+    putU32(&out[36], 1);
+    putU32(&out[40], static_cast<uint32_t>(texture.levels.size()));
+    putU32(&out[44], supercompression);
+    for(size_t l = 0; l < texture.levels.size(); l++) {
+        const TextureTranscoder::Level& level = texture.levels[l];
+        putU64(&out[80 + l * 24], indexEnd + level.offset);
+        putU64(&out[80 + l * 24 + 8], level.size);
+        putU64(&out[80 + l * 24 + 16], level.size);
+    }
+    out.insert(out.end(), texture.data.begin(), texture.data.end());
+    return out;
+}
+
+/*
+ * A BC1 file written here reads back byte for byte; every truncation of
+ * it, Basis payloads (vkFormat 0) and supercompressed files are
+ * rejected. The reader's complaints are muted for the truncations
+ */
+static bool CheckKtx2Reader() {
+    ImageDecoder::Image image;
+    image.width = image.height = 64;
+    image.pixels = BenchData::makeTexturePixels(image.width, false);
+    TextureTranscoder::Texture texture;
+    TextureTranscoder::encode(image, Format::BC1, true, texture);
+    std::vector<unsigned char> file = makeKtx2(texture, 131, 0);
+
+    bool ok = true;
+    TextureTranscoder::Texture read;
+    if(!Ktx2Reader::read(file.data(), file.size(), read) || read.format != Format::BC1
+        || read.width != texture.width || read.height != texture.height
+        || read.levels.size() != texture.levels.size() || read.data != texture.data) {
+        printf("  valid file did not read back\n");
+        ok = false;
+    }
+
+    size_t accepted = 0;
+    std::streambuf* log = std::cerr.rdbuf(nullptr);
+    for(size_t size = 0; size < file.size(); size++) {
+        std::vector<unsigned char> truncated(file.begin(), file.begin() + size);
+        if(Ktx2Reader::read(truncated.data(), truncated.size(), read)) accepted++;
+    }
+    std::cerr.rdbuf(log);
+    if(accepted > 0) {
+        printf("  %zu truncated files accepted\n", accepted);
+        ok = false;
+    }
+
+    std::vector<unsigned char> basis = makeKtx2(texture, 0, 0);
+    std::vector<unsigned char> supercompressed = makeKtx2(texture, 131, 2);
+    if(Ktx2Reader::read(basis.data(), basis.size(), read)) {
+        printf("  vkFormat 0 accepted\n");
+        ok = false;
+    }
+    if(Ktx2Reader::read(supercompressed.data(), supercompressed.size(), read)) {
+        printf("  supercompressed file accepted\n");
+        ok = false;
+    }
+    return ok;
+}
+BENCH_CHECK(CheckKtx2Reader);
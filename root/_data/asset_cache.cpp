@@ -0,0 +1,113 @@
+#include "asset_cache.h"
+#include "data_document.h"
+#include "../.preset/preset_binary.h"
+#include "../.preset/preset_reader.h"
+#include "../_platform/file_source.h"
+#include "../_platform/platform.h"
+#include <iostream>
+
+AssetCache& AssetCache::get() {
+    static AssetCache cache;
+    return cache;
+}
+
+/*
+** Lookup
+*/
+std::shared_ptr<const PresetData> AssetCache::getPreset(const std::string& path) {
+    auto it = presets.find(path);
+    if(it != presets.end()) return it->second;
+
+    std::shared_ptr<const PresetData> preset = loadPreset(path);
+    if(preset) presets.emplace(path, preset);
+    return preset;
+}
+
+std::shared_ptr<const AssetCache::DistanceMap> AssetCache::getDistances(const std::string& path) {
+    auto it = distances.find(path);
+    if(it != distances.end()) return it->second;
+
+    std::shared_ptr<const DistanceMap> map = loadDistances(path);
+    if(map) distances.emplace(path, map);
+    return map;
+}
+
+/*
+** Invalidate
+*/
+/*
+ * Holders of a previous view keep it alive; only the next lookup
+ * re-reads the file
+ */
+void AssetCache::invalidate(const std::string& path) {
+    presets.erase(path);
+    distances.erase(path);
+}
+
+void AssetCache::clear() {
+    presets.clear();
+    distances.clear();
+}
+
+void AssetCache::collectTextures(std::unordered_set<TextureRegistry::Handle>& live) const {
+    for(const auto& entry : presets) {
+        for(const auto& planet : entry.second->planets) live.insert(planet.texture);
+    }
+}
+
+/*
+** Load
+*/
+std::shared_ptr<const PresetData> AssetCache::loadPreset(const std::string& path) {
+    FileSource file(Platform::resolve(path));
+    if(!file.isOpen()) {
+        std::cerr << "Failed to open data file: " << Platform::resolve(path) << std::endl;
+        return nullptr;
+    }
+
+    auto preset = std::make_shared<PresetData>();
+    bool success = PresetBinary::isBinary(file.view()) ?
+        PresetBinary::decode(file.view(), *preset) :
+        PresetReader::read(file.view(), *preset, PresetReader::Mode::LENIENT);
+    if(!success) {
+        std::cerr << "Failed to parse data file: " << path << std::endl;
+        return nullptr;
+    }
+    return preset;
+}
+
+std::shared_ptr<const AssetCache::DistanceMap> AssetCache::loadDistances(const std::string& path) {
+    FileSource file(Platform::resolve(path));
+    if(!file.isOpen()) {
+        std::cerr << "Failed to open " << Platform::resolve(path) << std::endl;
+        return nullptr;
+    }
+
+    try {
+        DataParser::Document doc;
+        const DataParser::Node& root = doc.parse(file.view());
+        if(!root.hasKey("distances") || !root["distances"].isArray()) {
+            std::cerr << "Invalid " << path << " format: missing distances array" << std::endl;
+            return nullptr;
+        }
+
+        auto map = std::make_shared<DistanceMap>();
+        for(const auto& distanceValue : root["distances"]) {
+            if(!distanceValue.isObject()) continue;
+            if(distanceValue.hasKey("index") && distanceValue.hasKey("distance")) {
+                int i = distanceValue["index"].asInt();
+                std::string_view distanceStr = distanceValue["distance"].asString();
+                if(!distanceStr.empty() && distanceStr.back() == 'f') {
+                    distanceStr.remove_suffix(1);
+                }
+                (*map)[i] = std::stof(std::string(distanceStr));
+            }
+        }
+
+        std::cout << "Loaded " << map->size() << " distance mappings" << std::endl;
+        return map;
+    } catch(const std::exception& err) {
+        std::cerr << "Error loading distance map: " << err.what() << std::endl;
+        return nullptr;
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "../.preset/preset_data.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+** Parse-once store for the data files under /_data. Each file is read
+** and parsed on first request and handed out as a shared const view;
+** later requests for the same path never touch the filesystem or the
+** parser until the entry is invalidated. Failed loads are not cached.
+** Paths are opened through Platform::resolve but cached as given.
+*/
+class AssetCache {
+    public:
+        using DistanceMap = std::unordered_map<int, float>;
+
+        static AssetCache& get();
+
+        std::shared_ptr<const PresetData> getPreset(const std::string& path);
+        std::shared_ptr<const DistanceMap> getDistances(const std::string& path);
+
+        void invalidate(const std::string& path);
+        void clear();
+
+        /* Texture handles of cached presets, which loads hand out again */
+        void collectTextures(std::unordered_set<TextureRegistry::Handle>& live) const;
+
+    private:
+        std::unordered_map<std::string, std::shared_ptr<const PresetData>> presets;
+        std::unordered_map<std::string, std::shared_ptr<const DistanceMap>> distances;
+
+        AssetCache() = default;
+
+        static std::shared_ptr<const PresetData> loadPreset(const std::string& path);
+        static std::shared_ptr<const DistanceMap> loadDistances(const std::string& path);
+};
@@ -0,0 +1,366 @@
+#include "data_document.h"
+#include "structural_index.h"
+#include "data_scan.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace DataParser {
+    /*
+    ** Arena
+    */
+    Arena::Arena() : current(0) {}
+
+    Arena::~Arena() {
+        for(auto& block : blocks) {
+            delete[] block.data;
+        }
+    }
+
+    void Arena::addBlock(size_t size) {
+        size = std::max(size, MIN_BLOCK_SIZE);
+        if(!blocks.empty()) size = std::max(size, blocks.back().size * 2);
+        blocks.push_back({ new char[size], size, 0 });
+        current = blocks.size() - 1;
+    }
+
+    void Arena::reserve(size_t size) {
+        if(blocks.empty() || blocks[current].size - blocks[current].used < size) {
+            addBlock(size);
+        }
+    }
+
+    void* Arena::allocate(size_t size, size_t align) {
+        while(current < blocks.size()) {
+            Block& block = blocks[current];
+            size_t offset = (block.used + align - 1) & ~(align - 1);
+            if(offset + size <= block.size) {
+                block.used = offset + size;
+                return block.data + offset;
+            }
+            if(current + 1 == blocks.size()) break;
+            current++;
+        }
+        addBlock(size + align);
+        return allocate(size, align);
+    }
+
+    /*
+     * Overflow blocks are folded into one, so reparsing a document
+     * of similar size allocates nothing
+     */
+    void Arena::reset() {
+        if(blocks.size() > 1) {
+            size_t total = 0;
+            for(auto& block : blocks) {
+                total += block.size;
+                delete[] block.data;
+            }
+            blocks.clear();
+            addBlock(total);
+            return;
+        }
+        if(!blocks.empty()) blocks[0].used = 0;
+        current = 0;
+    }
+
+    /*
+    ** Node
+    */
+    bool Node::asBoolean() const {
+        if(type != ValueType::Boolean) {
+            throw std::runtime_error("Value is not a boolean");
+        }
+        return boolValue;
+    }
+
+    double Node::asNumber() const {
+        if(type != ValueType::Number) {
+            throw std::runtime_error("Value is not a number");
+        }
+        return numberValue;
+    }
+
+    int Node::asInt() const {
+        return static_cast<int>(asNumber());
+    }
+
+    float Node::asFloat() const {
+        return static_cast<float>(asNumber());
+    }
+
+    std::string_view Node::asString() const {
+        if(type != ValueType::String) {
+            throw std::runtime_error("Value is not a string");
+        }
+        return std::string_view(stringValue, length);
+    }
+
+    const Node& Node::operator[](size_t index) const {
+        if(type != ValueType::Array) {
+            throw std::runtime_error("Value is not an array");
+        }
+        if(index >= length) {
+            throw std::runtime_error("Index out of range");
+        }
+        return elementsValue[index];
+    }
+
+    const Node& Node::operator[](std::string_view key) const {
+        if(type != ValueType::Object) {
+            throw std::runtime_error("Value is not an object");
+        }
+        const Node* node = find(key);
+        if(!node) {
+            throw std::runtime_error("Key not found: " + std::string(key));
+        }
+        return *node;
+    }
+
+    const Node* Node::find(std::string_view key) const {
+        if(type != ValueType::Object) return nullptr;
+
+        const Member* first = membersValue;
+        const Member* last = membersValue + length;
+        const Member* it = std::upper_bound(first, last, key,
+            [](std::string_view k, const Member& m) { return k < m.key; }
+        );
+        return it != first && (it - 1)->key == key ? &(it - 1)->value : nullptr;
+    }
+
+    const Node* Node::begin() const {
+        return type == ValueType::Array ? elementsValue : nullptr;
+    }
+
+    const Node* Node::end() const {
+        return type == ValueType::Array ? elementsValue + length : nullptr;
+    }
+
+    const Member* Node::members() const {
+        return type == ValueType::Object ? membersValue : nullptr;
+    }
+
+    /*
+    ** Document
+    */
+    Document::Document() :
+        begin(nullptr),
+        end(nullptr),
+        cursor(0)
+    {
+        root.type = ValueType::Null;
+        root.length = 0;
+        root.numberValue = 0.0;
+    }
+
+    const Node& Document::parse(std::string_view json) {
+        arena.reset();
+        /* Members dominate the node count; ~2x the source covers a preset */
+        arena.reserve(json.size() * 2);
+        nodeStack.clear();
+        memberStack.clear();
+
+        begin = json.data();
+        end = begin + json.size();
+        cursor = 0;
+        if(!StructuralIndex::build(json, structurals)) {
+            fail("Unterminated string", end);
+        }
+
+        parseValue(root);
+        if(cursor < structurals.size()) {
+            fail("Unexpected character after data", begin + structurals[cursor]);
+        }
+        return root;
+    }
+
+    void Document::fail(const char* msg, const char* at) const {
+        throw ParseException(msg, static_cast<size_t>(at - begin));
+    }
+
+    const char* Document::next() {
+        if(cursor >= structurals.size()) fail("Unexpected end of data", end);
+        return begin + structurals[cursor++];
+    }
+
+    static bool isSeparator(char c) {
+        switch(c) {
+            case ' ': case '\t': case '\n': case '\r':
+            case ',': case ':': case ']': case '}':
+            case '[': case '{': case '"':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void Document::parseValue(Node& out) {
+        const char* p = next();
+        const char* scalarEnd = nullptr;
+
+        char c = *p;
+        if(c == '{') {
+            parseObject(out);
+        } else if(c == '[') {
+            parseArray(out);
+        } else if(c == '"') {
+            std::string_view str = parseString(p);
+            out.type = ValueType::String;
+            out.length = static_cast<uint32_t>(str.size());
+            out.stringValue = str.data();
+        } else if(c == '-' || (c >= '0' && c <= '9')) {
+            scalarEnd = parseNumber(p, out);
+        } else if(c == 't' || c == 'f' || c == 'n') {
+            scalarEnd = parseKeyword(p, out);
+        } else {
+            fail("Unexpected character", p);
+        }
+
+        if(scalarEnd && scalarEnd < end && !isSeparator(*scalarEnd)) {
+            fail("Unexpected character", scalarEnd);
+        }
+    }
+
+    /*
+     * Stable, so a repeated key resolves to its last occurrence as it
+     * does in Value. Insertion sort keeps small objects off the heap
+     */
+    static void sortMembers(Member* members, size_t count) {
+        auto less = [](const Member& a, const Member& b) { return a.key < b.key; };
+        if(count > 32) {
+            std::stable_sort(members, members + count, less);
+            return;
+        }
+        for(size_t i = 1; i < count; i++) {
+            Member m = members[i];
+            size_t j = i;
+            while(j > 0 && less(m, members[j - 1])) {
+                members[j] = members[j - 1];
+                j--;
+            }
+            members[j] = m;
+        }
+    }
+
+    /*
+     * Children are collected on a reused scratch stack and copied into
+     * the arena in one block once the count is known
+     */
+    void Document::parseObject(Node& out) {
+        size_t mark = memberStack.size();
+        const char* p = next();
+        if(*p != '}') {
+            while(true) {
+                if(*p != '"') fail("Expected string key", p);
+                std::string_view key = parseString(p);
+
+                p = next();
+                if(*p != ':') fail("Expected ':' after key", p);
+
+                Node value;
+                parseValue(value);
+                memberStack.push_back({ key, value });
+
+                p = next();
+                if(*p == '}') {
+                    break;
+                } else if(*p == ',') {
+                    p = next();
+                } else {
+                    fail("Expected ',' or '}'", p);
+                }
+            }
+        }
+
+        size_t count = memberStack.size() - mark;
+        Member* members = static_cast<Member*>(arena.allocate(count * sizeof(Member), alignof(Member)));
+        std::copy(memberStack.begin() + mark, memberStack.end(), members);
+        memberStack.resize(mark);
+        sortMembers(members, count);
+
+        out.type = ValueType::Object;
+        out.length = static_cast<uint32_t>(count);
+        out.membersValue = members;
+    }
+
+    void Document::parseArray(Node& out) {
+        size_t mark = nodeStack.size();
+        if(cursor < structurals.size() && begin[structurals[cursor]] == ']') {
+            cursor++;
+        } else {
+            while(true) {
+                Node value;
+                parseValue(value);
+                nodeStack.push_back(value);
+
+                const char* p = next();
+                if(*p == ']') {
+                    break;
+                } else if(*p != ',') {
+                    fail("Expected ',' or ']'", p);
+                }
+            }
+        }
+
+        size_t count = nodeStack.size() - mark;
+        Node* elements = static_cast<Node*>(arena.allocate(count * sizeof(Node), alignof(Node)));
+        std::copy(nodeStack.begin() + mark, nodeStack.end(), elements);
+        nodeStack.resize(mark);
+
+        out.type = ValueType::Array;
+        out.length = static_cast<uint32_t>(count);
+        out.elementsValue = elements;
+    }
+
+    /*
+     * The closing quote is the next structural. Returns a view into the
+     * source when the string has no escapes, otherwise the unescaped
+     * copy lives in the arena
+     */
+    std::string_view Document::parseString(const char* open) {
+        const char* start = open + 1;
+        const char* close = next();
+        if(*close != '"') fail("Unterminated string", close);
+
+        size_t length = static_cast<size_t>(close - start);
+        const char* pos = static_cast<const char*>(memchr(start, '\\', length));
+        if(!pos) return std::string_view(start, length);
+
+        /* Escapes never expand, so the raw length bounds the output */
+        char* buffer = static_cast<char*>(arena.allocate(length, 1));
+        size_t prefix = static_cast<size_t>(pos - start);
+        memcpy(buffer, start, prefix);
+        char* out = buffer + prefix;
+
+        out = Scan::unescape(pos, close, out);
+        if(!out) fail("Invalid escape sequence", pos);
+        return std::string_view(buffer, static_cast<size_t>(out - buffer));
+    }
+
+    const char* Document::parseNumber(const char* p, Node& out) {
+        out.type = ValueType::Number;
+        out.length = 0;
+        const char* next = Scan::number(p, end, out.numberValue);
+        if(!next) fail("Invalid number format", p);
+        return next;
+    }
+
+    const char* Document::parseKeyword(const char* p, Node& out) {
+        size_t remaining = static_cast<size_t>(end - p);
+        out.length = 0;
+        if(remaining >= 4 && memcmp(p, "true", 4) == 0) {
+            out.type = ValueType::Boolean;
+            out.boolValue = true;
+            return p + 4;
+        } else if(remaining >= 5 && memcmp(p, "false", 5) == 0) {
+            out.type = ValueType::Boolean;
+            out.boolValue = false;
+            return p + 5;
+        } else if(remaining >= 4 && memcmp(p, "null", 4) == 0) {
+            out.type = ValueType::Null;
+            out.numberValue = 0.0;
+            return p + 4;
+        }
+        fail("Unexpected keyword", p);
+    }
+}
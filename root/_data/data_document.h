@@ -0,0 +1,127 @@
+#pragma once
+#include "data_parser.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/*
+** Arena-backed, read-only document. All nodes of a parse live in a
+** bump allocator owned by the Document; strings are views into the
+** source buffer unless they needed unescaping, and object members are
+** kept sorted by key for binary search lookups.
+**
+** Parsing runs in two stages: StructuralIndex finds every structural
+** offset with SIMD, then the nodes are built by walking those offsets.
+**
+** The source passed to parse() must outlive the document.
+*/
+namespace DataParser {
+    class Arena {
+        public:
+            Arena();
+            ~Arena();
+            Arena(const Arena&) = delete;
+            Arena& operator=(const Arena&) = delete;
+
+            void* allocate(size_t size, size_t align);
+            void reserve(size_t size);
+            void reset();
+
+            size_t blockCount() const { return blocks.size(); }
+
+        private:
+            static constexpr size_t MIN_BLOCK_SIZE = 4096;
+
+            struct Block {
+                char* data;
+                size_t size;
+                size_t used;
+            };
+            std::vector<Block> blocks;
+            size_t current;
+
+            void addBlock(size_t size);
+    };
+
+    struct Member;
+    class Node {
+        public:
+            ValueType getType() const { return type; }
+
+            bool isNull() const { return type == ValueType::Null; }
+            bool isBoolean() const { return type == ValueType::Boolean; }
+            bool isNumber() const { return type == ValueType::Number; }
+            bool isString() const { return type == ValueType::String; }
+            bool isArray() const { return type == ValueType::Array; }
+            bool isObject() const { return type == ValueType::Object; }
+
+            bool asBoolean() const;
+            double asNumber() const;
+            int asInt() const;
+            float asFloat() const;
+            std::string_view asString() const;
+
+            size_t size() const { return length; }
+            const Node& operator[](size_t index) const;
+            const Node& operator[](std::string_view key) const;
+            const Node* find(std::string_view key) const;
+            bool hasKey(std::string_view key) const { return find(key) != nullptr; }
+
+            const Node* begin() const;
+            const Node* end() const;
+            const Member* members() const;
+
+        private:
+            friend class Document;
+
+            ValueType type;
+            uint32_t length;
+            union {
+                bool boolValue;
+                double numberValue;
+                const char* stringValue;
+                const Node* elementsValue;
+                const Member* membersValue;
+            };
+    };
+
+    struct Member {
+        std::string_view key;
+        Node value;
+    };
+
+    class Document {
+        public:
+            Document();
+            Document(const Document&) = delete;
+            Document& operator=(const Document&) = delete;
+
+            /* Throws ParseException on malformed input */
+            const Node& parse(std::string_view json);
+            const Node& getRoot() const { return root; }
+
+            size_t getArenaBlocks() const { return arena.blockCount(); }
+
+        private:
+            Arena arena;
+            Node root;
+
+            const char* begin;
+            const char* end;
+            std::vector<uint32_t> structurals;
+            size_t cursor;
+            std::vector<Node> nodeStack;
+            std::vector<Member> memberStack;
+
+            const char* next();
+            void parseValue(Node& out);
+            void parseObject(Node& out);
+            void parseArray(Node& out);
+            std::string_view parseString(const char* open);
+            const char* parseNumber(const char* p, Node& out);
+            const char* parseKeyword(const char* p, Node& out);
+
+            [[noreturn]] void fail(const char* msg, const char* at) const;
+    };
+}
@@ -1,22 +1,12 @@
 #include "data_parser.h"
-#include <fstream>
-#include <sstream>
+#include "data_writer.h"
+#include "../_platform/file_source.h"
 #include <cctype>
 #include <cmath>
 #include <algorithm>
+#include <cstdlib>
 
 namespace DataParser {
-    static std::string readFile(const std::string& filename) {
-        std::ifstream file(filename);
-        if(!file.is_open()) {
-            throw std::runtime_error("Cannot open file: " + filename);
-        }
-        
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return buffer.str();
-    }
-    
     Value::Value(std::initializer_list<std::pair<std::string, Value>> init) 
         : type(ValueType::Object) {
         object_value = new std::unordered_map<std::string, Value>();
@@ -250,98 +240,22 @@ namespace DataParser {
         }
         array_value->push_back(value);
     }
+
+    void Value::push_back(Value&& value) {
+        if(type != ValueType::Array) {
+            throw std::runtime_error("Value is not an array");
+        }
+        array_value->push_back(std::move(value));
+    }
     
     std::string Value::toString(bool pretty, int indent) const {
         std::string result;
-        std::string indentStr(pretty ? indent * 2 : 0, ' ');
-        
-        switch (type) {
-            case ValueType::Null:
-                result = "null";
-                break;
-            case ValueType::Boolean:
-                result = bool_value ? "true" : "false";
-                break;
-            case ValueType::Number:
-                if(std::isnan(number_value)) {
-                    result = "null";
-                } else if(std::isinf(number_value)) {
-                    result = "null";
-                } else {
-                    double intPart;
-                    if(std::modf(number_value, &intPart) == 0.0) {
-                        result = std::to_string(static_cast<int>(number_value));
-                    } else {
-                        result = std::to_string(number_value);
-                        while(!result.empty() && result.back() == '0') {
-                            result.pop_back();
-                        }
-                        if(!result.empty() && result.back() == '.') {
-                            result.pop_back();
-                        }
-                    }
-                }
-                break;
-            case ValueType::String:
-                result = "\"" + Parser::encodeString(*string_value) + "\"";
-                break;
-            case ValueType::Array: {
-                result = "[";
-                if(pretty && !array_value->empty()) {
-                    result += "\n";
-                }
-                for(size_t i = 0; i < array_value->size(); ++i) {
-                    if(pretty) {
-                        result += std::string((indent + 1) * 2, ' ');
-                    }
-                    result += (*array_value)[i].toString(pretty, indent + 1);
-                    if(i < array_value->size() - 1) {
-                        result += ",";
-                    }
-                    if(pretty) {
-                        result += "\n";
-                    }
-                }
-                if(pretty && !array_value->empty()) {
-                    result += indentStr;
-                }
-                result += "]";
-                break;
-            }
-            case ValueType::Object: {
-                result = "{";
-                if(pretty && !object_value->empty()) {
-                    result += "\n";
-                }
-                size_t i = 0;
-                for(const auto& pair : *object_value) {
-                    if(pretty) {
-                        result += std::string((indent + 1) * 2, ' ');
-                    }
-                    result += "\"" + Parser::encodeString(pair.first) + "\":";
-                    if(pretty) {
-                        result += " ";
-                    }
-                    result += pair.second.toString(pretty, indent + 1);
-                    if(++i < object_value->size()) {
-                        result += ",";
-                    }
-                    if(pretty) {
-                        result += "\n";
-                    }
-                }
-                if(pretty && !object_value->empty()) {
-                    result += indentStr;
-                }
-                result += "}";
-                break;
-            }
-        }
-        
+        Writer writer(result, pretty, indent);
+        writer.value(*this);
         return result;
     }
     
-    Value Parser::parse(const std::string& data) {
+    Value Parser::parse(std::string_view data) {
         size_t pos = 0;
         skipWhitespace(data, pos);
         Value result = parseValue(data, pos);
@@ -354,11 +268,14 @@ namespace DataParser {
     }
     
     Value Parser::parseFile(const std::string& filename) {
-        std::string content = readFile(filename);
-        return parse(content);
+        FileSource file(filename);
+        if(!file.isOpen()) {
+            throw std::runtime_error("Cannot open file: " + filename);
+        }
+        return parse(file.view());
     }
     
-    Value Parser::parseValue(const std::string& data, size_t& pos) {
+    Value Parser::parseValue(std::string_view data, size_t& pos) {
         skipWhitespace(data, pos);
         if(pos >= data.length()) {
             throw ParseException("Unexpected end of data", pos);
@@ -380,7 +297,7 @@ namespace DataParser {
         }
     }
     
-    Value Parser::parseObject(const std::string& data, size_t& pos) {
+    Value Parser::parseObject(std::string_view data, size_t& pos) {
         Value result(ValueType::Object);
         pos++;
         skipWhitespace(data, pos);
@@ -404,7 +321,7 @@ namespace DataParser {
             
             skipWhitespace(data, pos);
             Value value = parseValue(data, pos);
-            result[keyStr] = value;
+            result[keyStr] = std::move(value);
             
             skipWhitespace(data, pos);
             if(data[pos] == '}') {
@@ -421,7 +338,7 @@ namespace DataParser {
         return result;
     }
     
-    Value Parser::parseArray(const std::string& data, size_t& pos) {
+    Value Parser::parseArray(std::string_view data, size_t& pos) {
         Value result(ValueType::Array);
         pos++;
         skipWhitespace(data, pos);
@@ -431,8 +348,7 @@ namespace DataParser {
         }
         
         while(pos < data.length()) {
-            Value value = parseValue(data, pos);
-            result.push_back(value);
+            result.push_back(parseValue(data, pos));
             
             skipWhitespace(data, pos);
             if(data[pos] == ']') {
@@ -449,15 +365,23 @@ namespace DataParser {
         return result;
     }
     
-    Value Parser::parseString(const std::string& data, size_t& pos) {
+    /*
+     * Unescaped runs are appended in one go; escapes are already
+     * resolved here, so the result is not decoded a second time
+     */
+    Value Parser::parseString(std::string_view data, size_t& pos) {
         pos++;
         std::string result;
         
         while(pos < data.length()) {
+            size_t run = data.find_first_of("\"\\", pos);
+            if(run == std::string::npos) break;
+            result.append(data, pos, run - pos);
+            pos = run;
+
             char c = data[pos++];
-            
             if(c == '"') {
-                return Value(decodeString(result));
+                return Value(std::move(result));
             } else if(c == '\\') {
                 if(pos >= data.length()) {
                     throw ParseException("Incomplete escape sequence", pos);
@@ -478,22 +402,20 @@ namespace DataParser {
                             throw ParseException("Incomplete Unicode escape", pos);
                         }
                         result += "\\u";
-                        result += data.substr(pos, 4);
+                        result.append(data, pos, 4);
                         pos += 4;
                         break;
                     }
                     default:
                         throw ParseException("Invalid escape sequence", pos - 1);
                 }
-            } else {
-                result += c;
             }
         }
         
         throw ParseException("Unterminated string", pos);
     }
     
-    Value Parser::parseNumber(const std::string& data, size_t& pos) {
+    Value Parser::parseNumber(std::string_view data, size_t& pos) {
         size_t start = pos;
         if(data[pos] == '-') {
             pos++;
@@ -518,23 +440,30 @@ namespace DataParser {
             }
         }
         
-        std::string numStr = data.substr(start, pos - start);
-        try {
-            double value = std::stod(numStr);
-            return Value(value);
-        } catch (...) {
+        char buffer[64];
+        size_t len = pos - start;
+        if(len == 0 || len >= sizeof(buffer)) {
+            throw ParseException("Invalid number format", start);
+        }
+        data.copy(buffer, len, start);
+        buffer[len] = '\0';
+
+        char* parsed = nullptr;
+        double value = strtod(buffer, &parsed);
+        if(parsed == buffer) {
             throw ParseException("Invalid number format", start);
         }
+        return Value(value);
     }
     
-    Value Parser::parseKeyword(const std::string& data, size_t& pos) {
-        if(data.substr(pos, 4) == "true") {
+    Value Parser::parseKeyword(std::string_view data, size_t& pos) {
+        if(data.compare(pos, 4, "true") == 0) {
             pos += 4;
             return Value(true);
-        } else if(data.substr(pos, 5) == "false") {
+        } else if(data.compare(pos, 5, "false") == 0) {
             pos += 5;
             return Value(false);
-        } else if(data.substr(pos, 4) == "null") {
+        } else if(data.compare(pos, 4, "null") == 0) {
             pos += 4;
             return Value();
         } else {
@@ -542,13 +471,13 @@ namespace DataParser {
         }
     }
     
-    void Parser::skipWhitespace(const std::string& data, size_t& pos) {
+    void Parser::skipWhitespace(std::string_view data, size_t& pos) {
         while(pos < data.length() && std::isspace(static_cast<unsigned char>(data[pos]))) {
             pos++;
         }
     }
     
-    char Parser::getNextChar(const std::string& data, size_t& pos) {
+    char Parser::getNextChar(std::string_view data, size_t& pos) {
         skipWhitespace(data, pos);
         if(pos >= data.length()) {
             throw ParseException("Unexpected end of data", pos);
@@ -1,9 +1,11 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <memory>
 #include <stdexcept>
+#include <utility>
 
 namespace DataParser {
     enum class ValueType {
@@ -21,6 +23,7 @@ namespace DataParser {
             Value(bool b) : type(ValueType::Boolean), bool_value(b) {}
             Value(double d) : type(ValueType::Number), number_value(d) {}
             Value(const std::string& s) : type(ValueType::String), string_value(new std::string(s)) {}
+            Value(std::string&& s) : type(ValueType::String), string_value(new std::string(std::move(s))) {}
             Value(ValueType t) : type(t) {
                 switch (t) {
                     case ValueType::String:
@@ -73,6 +76,7 @@ namespace DataParser {
             
             size_t size() const;
             void push_back(const Value& value);
+            void push_back(Value&& value);
             
             std::string toString(bool pretty = false, int indent = 0) const;
             
@@ -92,21 +96,21 @@ namespace DataParser {
 
     class Parser {
         public:
-            static Value parse(const std::string& json);
+            static Value parse(std::string_view json);
             static Value parseFile(const std::string& filename);
             
             static std::string decodeString(const std::string& str);
             static std::string encodeString(const std::string& str);
         private:
-            static Value parseValue(const std::string& json, size_t& pos);
-            static Value parseObject(const std::string& json, size_t& pos);
-            static Value parseArray(const std::string& json, size_t& pos);
-            static Value parseString(const std::string& json, size_t& pos);
-            static Value parseNumber(const std::string& json, size_t& pos);
-            static Value parseKeyword(const std::string& json, size_t& pos);
+            static Value parseValue(std::string_view json, size_t& pos);
+            static Value parseObject(std::string_view json, size_t& pos);
+            static Value parseArray(std::string_view json, size_t& pos);
+            static Value parseString(std::string_view json, size_t& pos);
+            static Value parseNumber(std::string_view json, size_t& pos);
+            static Value parseKeyword(std::string_view json, size_t& pos);
             
-            static void skipWhitespace(const std::string& json, size_t& pos);
-            static char getNextChar(const std::string& json, size_t& pos);
+            static void skipWhitespace(std::string_view json, size_t& pos);
+            static char getNextChar(std::string_view json, size_t& pos);
     };
     class ParseException : public std::runtime_error {
         public:
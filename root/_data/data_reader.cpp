@@ -0,0 +1,175 @@
+#include "data_reader.h"
+#include "data_scan.h"
+#include <cstring>
+
+namespace DataParser {
+    Reader::Reader(std::string_view json, Handler& handler) :
+        begin(json.data()),
+        end(json.data() + json.size()),
+        pos(json.data()),
+        handler(handler)
+    {}
+
+    bool Reader::read(std::string_view json, Handler& handler) {
+        Reader reader(json, handler);
+        if(!reader.readValue(0)) return false;
+
+        reader.skipWhitespace();
+        if(reader.pos < reader.end) reader.fail("Unexpected character after data");
+        return true;
+    }
+
+    void Reader::fail(const char* msg) const {
+        throw ParseException(msg, static_cast<size_t>(pos - begin));
+    }
+
+    void Reader::skipWhitespace() {
+        while(pos < end && (*pos == ' ' || *pos == '\n' || *pos == '\r' || *pos == '\t')) {
+            pos++;
+        }
+    }
+
+    bool Reader::readValue(int depth) {
+        skipWhitespace();
+        if(pos >= end) fail("Unexpected end of data");
+
+        char c = *pos;
+        if(c == '{') {
+            return readObject(depth + 1);
+        } else if(c == '[') {
+            return readArray(depth + 1);
+        } else if(c == '"') {
+            return handler.onString(readString());
+        } else if(c == '-' || (c >= '0' && c <= '9')) {
+            double value;
+            const char* next = Scan::number(pos, end, value);
+            if(!next) fail("Invalid number format");
+            pos = next;
+            return handler.onNumber(value);
+        } else if(c == 't' || c == 'f' || c == 'n') {
+            return readKeyword();
+        }
+        fail("Unexpected character");
+    }
+
+    bool Reader::readObject(int depth) {
+        if(depth > MAX_DEPTH) fail("Nesting too deep");
+        if(!handler.onStartObject()) return false;
+
+        pos++;
+        skipWhitespace();
+        if(pos < end && *pos == '}') {
+            pos++;
+            return handler.onEndObject();
+        }
+
+        while(true) {
+            if(pos >= end || *pos != '"') fail("Expected string key");
+            if(!handler.onKey(readString())) return false;
+
+            skipWhitespace();
+            if(pos >= end || *pos != ':') fail("Expected ':' after key");
+            pos++;
+
+            if(!readValue(depth)) return false;
+
+            skipWhitespace();
+            if(pos >= end) fail("Expected ',' or '}'");
+            if(*pos == '}') {
+                pos++;
+                return handler.onEndObject();
+            } else if(*pos == ',') {
+                pos++;
+                skipWhitespace();
+            } else {
+                fail("Expected ',' or '}'");
+            }
+        }
+    }
+
+    bool Reader::readArray(int depth) {
+        if(depth > MAX_DEPTH) fail("Nesting too deep");
+        if(!handler.onStartArray()) return false;
+
+        pos++;
+        skipWhitespace();
+        if(pos < end && *pos == ']') {
+            pos++;
+            return handler.onEndArray();
+        }
+
+        while(true) {
+            if(!readValue(depth)) return false;
+
+            skipWhitespace();
+            if(pos >= end) fail("Expected ',' or ']'");
+            if(*pos == ']') {
+                pos++;
+                return handler.onEndArray();
+            } else if(*pos == ',') {
+                pos++;
+            } else {
+                fail("Expected ',' or ']'");
+            }
+        }
+    }
+
+    /*
+     * Views the source directly unless the string has escapes, which
+     * are resolved into the reused scratch buffer
+     */
+    std::string_view Reader::readString() {
+        const char* start = ++pos;
+        const char* p = start;
+        const char* firstEscape = nullptr;
+        while(true) {
+            const char* quote = static_cast<const char*>(memchr(p, '"', static_cast<size_t>(end - p)));
+            if(!quote) fail("Unterminated string");
+
+            /* A quote preceded by an odd run of backslashes is escaped */
+            const char* b = quote;
+            while(b > start && b[-1] == '\\') b--;
+            if(((quote - b) & 1) == 0) {
+                pos = quote;
+                break;
+            }
+            if(!firstEscape) firstEscape = b;
+            p = quote + 1;
+        }
+
+        const char* close = pos;
+        size_t length = static_cast<size_t>(close - start);
+        if(!firstEscape) {
+            firstEscape = static_cast<const char*>(memchr(start, '\\', length));
+        }
+        pos = close + 1;
+        if(!firstEscape) return std::string_view(start, length);
+
+        scratch.resize(length);
+        size_t prefix = static_cast<size_t>(firstEscape - start);
+        memcpy(&scratch[0], start, prefix);
+
+        const char* in = firstEscape;
+        char* out = Scan::unescape(in, close, &scratch[0] + prefix);
+        if(!out) {
+            pos = in;
+            fail("Invalid escape sequence");
+        }
+        return std::string_view(scratch.data(), static_cast<size_t>(out - scratch.data()));
+    }
+
+    bool Reader::readKeyword() {
+        size_t remaining = static_cast<size_t>(end - pos);
+        if(remaining >= 4 && memcmp(pos, "true", 4) == 0) {
+            pos += 4;
+            return handler.onBoolean(true);
+        } else if(remaining >= 5 && memcmp(pos, "false", 5) == 0) {
+            pos += 5;
+            return handler.onBoolean(false);
+        } else if(remaining >= 4 && memcmp(pos, "null", 4) == 0) {
+            pos += 4;
+            return handler.onNull();
+        }
+        fail("Unexpected keyword");
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "data_parser.h"
+#include <string>
+#include <string_view>
+
+/*
+** Event-driven (SAX) reader. Walks the input once and reports each
+** value to a Handler without building any tree. String views handed
+** to the handler are only valid for the duration of the callback.
+*/
+namespace DataParser {
+    class Reader {
+        public:
+            class Handler {
+                public:
+                    virtual ~Handler() {}
+
+                    /* Returning false stops the read */
+                    virtual bool onNull() { return true; }
+                    virtual bool onBoolean(bool value) { (void)value; return true; }
+                    virtual bool onNumber(double value) { (void)value; return true; }
+                    virtual bool onString(std::string_view value) { (void)value; return true; }
+                    virtual bool onKey(std::string_view key) { (void)key; return true; }
+                    virtual bool onStartObject() { return true; }
+                    virtual bool onEndObject() { return true; }
+                    virtual bool onStartArray() { return true; }
+                    virtual bool onEndArray() { return true; }
+            };
+
+            /*
+             * Throws ParseException on malformed input; returns false if
+             * the handler stopped the read
+             */
+            static bool read(std::string_view json, Handler& handler);
+
+        private:
+            static constexpr int MAX_DEPTH = 256;
+
+            const char* begin;
+            const char* end;
+            const char* pos;
+            Handler& handler;
+            std::string scratch;
+
+            Reader(std::string_view json, Handler& handler);
+
+            bool readValue(int depth);
+            bool readObject(int depth);
+            bool readArray(int depth);
+            std::string_view readString();
+            bool readKeyword();
+
+            void skipWhitespace();
+            [[noreturn]] void fail(const char* msg) const;
+    };
+}
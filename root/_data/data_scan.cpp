@@ -0,0 +1,142 @@
+#include "data_scan.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace DataParser {
+    namespace Scan {
+        static int hexValue(char c) {
+            if(c >= '0' && c <= '9') return c - '0';
+            if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        static bool readHex4(const char* p, uint32_t& out) {
+            out = 0;
+            for(int i = 0; i < 4; i++) {
+                int h = hexValue(p[i]);
+                if(h < 0) return false;
+                out = (out << 4) | static_cast<uint32_t>(h);
+            }
+            return true;
+        }
+
+        static char* appendUtf8(char* out, uint32_t cp) {
+            if(cp < 0x80) {
+                *out++ = static_cast<char>(cp);
+            } else if(cp < 0x800) {
+                *out++ = static_cast<char>(0xC0 | (cp >> 6));
+                *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+            } else if(cp < 0x10000) {
+                *out++ = static_cast<char>(0xE0 | (cp >> 12));
+                *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+            } else {
+                *out++ = static_cast<char>(0xF0 | (cp >> 18));
+                *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            return out;
+        }
+
+        /*
+        ** Number
+        */
+        const char* number(const char* p, const char* end, double& out) {
+            const char* start = p;
+            bool negative = false;
+            if(p < end && *p == '-') {
+                negative = true;
+                p++;
+            }
+
+            /* Plain integers are accumulated directly */
+            uint64_t integer = 0;
+            const char* digits = p;
+            while(p < end && *p >= '0' && *p <= '9') {
+                integer = integer * 10 + static_cast<uint64_t>(*p - '0');
+                p++;
+            }
+            if(p == digits) return nullptr;
+            bool simple = p - digits <= 15;
+
+            if(p < end && *p == '.') {
+                simple = false;
+                p++;
+                while(p < end && *p >= '0' && *p <= '9') p++;
+            }
+            if(p < end && (*p == 'e' || *p == 'E')) {
+                simple = false;
+                p++;
+                if(p < end && (*p == '+' || *p == '-')) p++;
+                while(p < end && *p >= '0' && *p <= '9') p++;
+            }
+
+            if(simple) {
+                double value = static_cast<double>(integer);
+                out = negative ? -value : value;
+                return p;
+            }
+
+            /* Fractions and exponents go through strtod on a stack copy */
+            char buffer[64];
+            size_t len = static_cast<size_t>(p - start);
+            if(len >= sizeof(buffer)) return nullptr;
+            memcpy(buffer, start, len);
+            buffer[len] = '\0';
+            out = strtod(buffer, nullptr);
+            return p;
+        }
+
+        /*
+        ** Unescape
+        */
+        char* unescape(const char*& p, const char* end, char* out) {
+            while(p < end) {
+                char c = *p;
+                if(c != '\\') {
+                    *out++ = c;
+                    p++;
+                    continue;
+                }
+                if(end - p < 2) return nullptr;
+
+                switch(p[1]) {
+                    case '"': *out++ = '"'; break;
+                    case '\\': *out++ = '\\'; break;
+                    case '/': *out++ = '/'; break;
+                    case 'b': *out++ = '\b'; break;
+                    case 'f': *out++ = '\f'; break;
+                    case 'n': *out++ = '\n'; break;
+                    case 'r': *out++ = '\r'; break;
+                    case 't': *out++ = '\t'; break;
+                    case 'u': {
+                        uint32_t cp;
+                        if(end - p < 6 || !readHex4(p + 2, cp)) return nullptr;
+                        p += 6;
+
+                        uint32_t low;
+                        if(
+                            cp >= 0xD800 && cp <= 0xDBFF &&
+                            end - p >= 6 &&
+                            p[0] == '\\' && p[1] == 'u' &&
+                            readHex4(p + 2, low) &&
+                            low >= 0xDC00 && low <= 0xDFFF
+                        ) {
+                            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                            p += 6;
+                        }
+                        out = appendUtf8(out, cp);
+                        continue;
+                    }
+                    default:
+                        return nullptr;
+                }
+                p += 2;
+            }
+            return out;
+        }
+    }
+}
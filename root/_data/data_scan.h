@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+
+/*
+** Byte-level helpers shared by Document and Reader.
+*/
+namespace DataParser {
+    namespace Scan {
+        /*
+         * Parses a JSON number starting at p. Returns the first byte
+         * past it, or nullptr if p does not start a valid number
+         */
+        const char* number(const char* p, const char* end, double& out);
+
+        /*
+         * Resolves the escapes in [p, end) into out, which must hold
+         * end - p bytes; escapes never expand. Returns the end of the
+         * output, or nullptr with p left on the bad escape
+         */
+        char* unescape(const char*& p, const char* end, char* out);
+    }
+}
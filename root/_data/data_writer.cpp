@@ -0,0 +1,249 @@
+#include "data_writer.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace DataParser {
+    Writer::Writer(std::string& out, bool pretty, int indent) :
+        out(&out),
+        sink(nullptr),
+        user(nullptr),
+        buffer(nullptr),
+        used(0),
+        pretty(pretty),
+        baseIndent(indent),
+        depth(0),
+        hasItems{},
+        afterKey(false)
+    {}
+
+    Writer::Writer(Sink sink, void* user, bool pretty) :
+        out(nullptr),
+        sink(sink),
+        user(user),
+        buffer(new char[SINK_BUFFER_SIZE]),
+        used(0),
+        pretty(pretty),
+        baseIndent(0),
+        depth(0),
+        hasItems{},
+        afterKey(false)
+    {}
+
+    Writer::~Writer() {
+        flush();
+        delete[] buffer;
+    }
+
+    void Writer::flush() {
+        if(sink && used > 0) {
+            sink(user, buffer, used);
+            used = 0;
+        }
+    }
+
+    /*
+    ** Output
+    */
+    void Writer::putLarge(const char* data, size_t size) {
+        flush();
+        if(size >= SINK_BUFFER_SIZE) {
+            sink(user, data, size);
+            return;
+        }
+        memcpy(buffer, data, size);
+        used = size;
+    }
+
+    void Writer::putEscaped(std::string_view str) {
+        put('"');
+        const char* p = str.data();
+        const char* end = p + str.size();
+        const char* run = p;
+        for(; p < end; p++) {
+            unsigned char c = static_cast<unsigned char>(*p);
+            if(c >= 0x20 && c != '"' && c != '\\') continue;
+
+            put(run, static_cast<size_t>(p - run));
+            run = p + 1;
+            switch(c) {
+                case '"': put("\\\"", 2); break;
+                case '\\': put("\\\\", 2); break;
+                case '\b': put("\\b", 2); break;
+                case '\f': put("\\f", 2); break;
+                case '\n': put("\\n", 2); break;
+                case '\r': put("\\r", 2); break;
+                case '\t': put("\\t", 2); break;
+                default: {
+                    static const char hex[] = "0123456789abcdef";
+                    char esc[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+                    put(esc, sizeof(esc));
+                    break;
+                }
+            }
+        }
+        put(run, static_cast<size_t>(end - run));
+        put('"');
+    }
+
+    void Writer::putNumber(const char* data, size_t size) {
+        beforeValue();
+        put(data, size);
+    }
+
+    /*
+    ** Structure
+    */
+    void Writer::newline(int level) {
+        put('\n');
+        for(int i = 0; i < level; i++) {
+            put("  ", 2);
+        }
+    }
+
+    void Writer::beforeValue() {
+        if(afterKey) {
+            afterKey = false;
+            return;
+        }
+        if(depth == 0) return;
+
+        if(scopeHasItems(depth - 1)) put(',');
+        if(pretty) newline(baseIndent + depth);
+        setScopeItems(depth - 1, true);
+    }
+
+    void Writer::open(char c) {
+        if(depth >= MAX_DEPTH) {
+            throw std::runtime_error("Writer nested too deep");
+        }
+        beforeValue();
+        put(c);
+        depth++;
+        setScopeItems(depth - 1, false);
+    }
+
+    void Writer::close(char c) {
+        bool items = scopeHasItems(depth - 1);
+        depth--;
+        if(pretty && items) newline(baseIndent + depth);
+        put(c);
+    }
+
+    Writer& Writer::startObject() {
+        open('{');
+        return *this;
+    }
+
+    Writer& Writer::endObject() {
+        close('}');
+        return *this;
+    }
+
+    Writer& Writer::startArray() {
+        open('[');
+        return *this;
+    }
+
+    Writer& Writer::endArray() {
+        close(']');
+        return *this;
+    }
+
+    Writer& Writer::key(std::string_view name) {
+        beforeValue();
+        putEscaped(name);
+        if(pretty) {
+            put(": ", 2);
+        } else {
+            put(':');
+        }
+        afterKey = true;
+        return *this;
+    }
+
+    /*
+    ** Values
+    */
+    Writer& Writer::null() {
+        putNumber("null", 4);
+        return *this;
+    }
+
+    Writer& Writer::value(bool b) {
+        if(b) {
+            putNumber("true", 4);
+        } else {
+            putNumber("false", 5);
+        }
+        return *this;
+    }
+
+    Writer& Writer::value(int i) {
+        char buf[16];
+        auto res = std::to_chars(buf, buf + sizeof(buf), i);
+        putNumber(buf, static_cast<size_t>(res.ptr - buf));
+        return *this;
+    }
+
+    Writer& Writer::value(uint32_t i) {
+        char buf[16];
+        auto res = std::to_chars(buf, buf + sizeof(buf), i);
+        putNumber(buf, static_cast<size_t>(res.ptr - buf));
+        return *this;
+    }
+
+    Writer& Writer::value(float f) {
+        if(!std::isfinite(f)) return null();
+        char buf[32];
+        auto res = std::to_chars(buf, buf + sizeof(buf), f);
+        putNumber(buf, static_cast<size_t>(res.ptr - buf));
+        return *this;
+    }
+
+    Writer& Writer::value(double d) {
+        if(!std::isfinite(d)) return null();
+        char buf[32];
+        auto res = std::to_chars(buf, buf + sizeof(buf), d);
+        putNumber(buf, static_cast<size_t>(res.ptr - buf));
+        return *this;
+    }
+
+    Writer& Writer::value(std::string_view str) {
+        beforeValue();
+        putEscaped(str);
+        return *this;
+    }
+
+    Writer& Writer::value(const Value& val) {
+        switch(val.getType()) {
+            case ValueType::Null:
+                return null();
+            case ValueType::Boolean:
+                return value(val.asBoolean());
+            case ValueType::Number: {
+                /* Numbers that came in as floats are written in float precision */
+                double d = val.asNumber();
+                float f = static_cast<float>(d);
+                if(std::isfinite(f) && static_cast<double>(f) == d) return value(f);
+                return value(d);
+            }
+            case ValueType::String:
+                return value(std::string_view(val.asString()));
+            case ValueType::Array:
+                startArray();
+                for(const Value& item : val.asArray()) {
+                    value(item);
+                }
+                return endArray();
+            case ValueType::Object:
+                startObject();
+                for(const auto& pair : val.asObject()) {
+                    key(pair.first);
+                    value(pair.second);
+                }
+                return endObject();
+        }
+        return *this;
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "data_parser.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+/*
+** Streaming JSON writer. Appends straight into one growable string,
+** or into a fixed buffer that is handed to a caller-provided sink
+** whenever it fills. Numbers are formatted with std::to_chars in
+** shortest round-trip form; no temporaries are built per field.
+*/
+namespace DataParser {
+    class Writer {
+        public:
+            using Sink = void(*)(void* user, const char* data, size_t size);
+
+            explicit Writer(std::string& out, bool pretty = false, int indent = 0);
+            Writer(Sink sink, void* user, bool pretty = false);
+            ~Writer();
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+
+            Writer& startObject();
+            Writer& endObject();
+            Writer& startArray();
+            Writer& endArray();
+            Writer& key(std::string_view name);
+
+            Writer& null();
+            Writer& value(bool b);
+            Writer& value(int i);
+            Writer& value(uint32_t i);
+            Writer& value(float f);
+            Writer& value(double d);
+            Writer& value(std::string_view str);
+            Writer& value(const char* str) { return value(std::string_view(str)); }
+            Writer& value(const std::string& str) { return value(std::string_view(str)); }
+            Writer& value(const Value& val);
+
+            void flush();
+
+        private:
+            static constexpr size_t SINK_BUFFER_SIZE = 16 * 1024;
+            /* Matches Reader::MAX_DEPTH, so anything the reader accepts writes back */
+            static constexpr int MAX_DEPTH = 256;
+
+            std::string* out;
+            Sink sink;
+            void* user;
+            char* buffer;
+            size_t used;
+
+            bool pretty;
+            int baseIndent;
+            int depth;
+            /* One bit per open scope: it already holds an item */
+            uint64_t hasItems[MAX_DEPTH / 64];
+            bool afterKey;
+
+            bool scopeHasItems(int scope) const { return (hasItems[scope >> 6] >> (scope & 63)) & 1; }
+            void setScopeItems(int scope, bool items) {
+                uint64_t bit = 1ull << (scope & 63);
+                hasItems[scope >> 6] = items ? hasItems[scope >> 6] | bit : hasItems[scope >> 6] & ~bit;
+            }
+
+            void put(char c) {
+                if(out) {
+                    out->push_back(c);
+                    return;
+                }
+                if(used == SINK_BUFFER_SIZE) flush();
+                buffer[used++] = c;
+            }
+            void put(const char* data, size_t size) {
+                if(out) {
+                    out->append(data, size);
+                    return;
+                }
+                if(used + size > SINK_BUFFER_SIZE) {
+                    putLarge(data, size);
+                    return;
+                }
+                memcpy(buffer + used, data, size);
+                used += size;
+            }
+            void putLarge(const char* data, size_t size);
+            void putEscaped(std::string_view str);
+            void putNumber(const char* data, size_t size);
+            void beforeValue();
+            void newline(int level);
+            void open(char c);
+            void close(char c);
+    };
+}
@@ -0,0 +1,269 @@
+#include "structural_index.h"
+#include <cstring>
+
+#if defined(STRUCTURAL_INDEX_WASM)
+    #include <wasm_simd128.h>
+#elif defined(STRUCTURAL_INDEX_AVX2)
+    #include <immintrin.h>
+#elif defined(STRUCTURAL_INDEX_SSE)
+    #include <emmintrin.h>
+#endif
+
+namespace {
+    constexpr size_t BLOCK_SIZE = 64;
+
+    struct BlockMasks {
+        uint64_t quote;
+        uint64_t backslash;
+        uint64_t whitespace;
+        uint64_t op;
+    };
+
+    inline int lowestBit(uint64_t mask) {
+        return __builtin_ctzll(mask);
+    }
+
+    /*
+    ** Scalar classification
+    */
+    enum : uint8_t {
+        CLASS_QUOTE = 1,
+        CLASS_BACKSLASH = 2,
+        CLASS_WHITESPACE = 4,
+        CLASS_OP = 8
+    };
+
+    struct ClassTable {
+        uint8_t table[256];
+
+        ClassTable() : table{} {
+            table[static_cast<uint8_t>('"')] = CLASS_QUOTE;
+            table[static_cast<uint8_t>('\\')] = CLASS_BACKSLASH;
+            for(char c : { ' ', '\t', '\n', '\r' }) {
+                table[static_cast<uint8_t>(c)] = CLASS_WHITESPACE;
+            }
+            for(char c : { '{', '}', '[', ']', ':', ',' }) {
+                table[static_cast<uint8_t>(c)] = CLASS_OP;
+            }
+        }
+    };
+    const ClassTable classTable;
+
+    void classifyScalar(const char* block, BlockMasks& m) {
+        m = {};
+        for(size_t i = 0; i < BLOCK_SIZE; i++) {
+            uint8_t c = classTable.table[static_cast<uint8_t>(block[i])];
+            uint64_t bit = 1ull << i;
+            if(c & CLASS_QUOTE) m.quote |= bit;
+            if(c & CLASS_BACKSLASH) m.backslash |= bit;
+            if(c & CLASS_WHITESPACE) m.whitespace |= bit;
+            if(c & CLASS_OP) m.op |= bit;
+        }
+    }
+
+    /*
+    ** SIMD classification
+    */
+#if defined(STRUCTURAL_INDEX_WASM)
+    void classifySimd(const char* block, BlockMasks& m) {
+        m = {};
+        for(size_t i = 0; i < BLOCK_SIZE; i += 16) {
+            v128_t v = wasm_v128_load(block + i);
+            v128_t ws = wasm_v128_or(
+                wasm_v128_or(wasm_i8x16_eq(v, wasm_i8x16_splat(' ')), wasm_i8x16_eq(v, wasm_i8x16_splat('\t'))),
+                wasm_v128_or(wasm_i8x16_eq(v, wasm_i8x16_splat('\n')), wasm_i8x16_eq(v, wasm_i8x16_splat('\r')))
+            );
+            v128_t op = wasm_v128_or(
+                wasm_v128_or(wasm_i8x16_eq(v, wasm_i8x16_splat('{')), wasm_i8x16_eq(v, wasm_i8x16_splat('}'))),
+                wasm_v128_or(
+                    wasm_v128_or(wasm_i8x16_eq(v, wasm_i8x16_splat('[')), wasm_i8x16_eq(v, wasm_i8x16_splat(']'))),
+                    wasm_v128_or(wasm_i8x16_eq(v, wasm_i8x16_splat(':')), wasm_i8x16_eq(v, wasm_i8x16_splat(',')))
+                )
+            );
+            m.quote |= static_cast<uint64_t>(wasm_i8x16_bitmask(wasm_i8x16_eq(v, wasm_i8x16_splat('"')))) << i;
+            m.backslash |= static_cast<uint64_t>(wasm_i8x16_bitmask(wasm_i8x16_eq(v, wasm_i8x16_splat('\\')))) << i;
+            m.whitespace |= static_cast<uint64_t>(wasm_i8x16_bitmask(ws)) << i;
+            m.op |= static_cast<uint64_t>(wasm_i8x16_bitmask(op)) << i;
+        }
+    }
+#elif defined(STRUCTURAL_INDEX_AVX2)
+    inline uint64_t movemask(__m256i v) {
+        return static_cast<uint32_t>(_mm256_movemask_epi8(v));
+    }
+
+    void classifySimd(const char* block, BlockMasks& m) {
+        m = {};
+        for(size_t i = 0; i < BLOCK_SIZE; i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+            __m256i ws = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')))
+            );
+            __m256i op = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('}'))),
+                _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('[')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(']'))),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(',')))
+                )
+            );
+            m.quote |= movemask(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'))) << i;
+            m.backslash |= movemask(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))) << i;
+            m.whitespace |= movemask(ws) << i;
+            m.op |= movemask(op) << i;
+        }
+    }
+#elif defined(STRUCTURAL_INDEX_SSE)
+    inline uint64_t movemask(__m128i v) {
+        return static_cast<uint32_t>(_mm_movemask_epi8(v));
+    }
+
+    void classifySimd(const char* block, BlockMasks& m) {
+        m = {};
+        for(size_t i = 0; i < BLOCK_SIZE; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+            __m128i ws = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')))
+            );
+            __m128i op = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('{')), _mm_cmpeq_epi8(v, _mm_set1_epi8('}'))),
+                _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('[')), _mm_cmpeq_epi8(v, _mm_set1_epi8(']'))),
+                    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(',')))
+                )
+            );
+            m.quote |= movemask(_mm_cmpeq_epi8(v, _mm_set1_epi8('"'))) << i;
+            m.backslash |= movemask(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))) << i;
+            m.whitespace |= movemask(ws) << i;
+            m.op |= movemask(op) << i;
+        }
+    }
+#endif
+
+    /*
+    ** Block state carried between 64-byte blocks
+    */
+    class Scanner {
+        private:
+            bool prevEscaped;
+            uint64_t prevInString;
+            uint64_t prevScalar;
+
+            /* Marks every byte preceded by an odd run of backslashes */
+            uint64_t escapedMask(uint64_t backslash) {
+                uint64_t escaped = prevEscaped ? 1 : 0;
+                prevEscaped = false;
+
+                uint64_t pending = backslash & ~escaped;
+                while(pending) {
+                    int i = lowestBit(pending);
+                    pending &= pending - 1;
+                    if(i == 63) {
+                        prevEscaped = true;
+                        break;
+                    }
+                    uint64_t next = 1ull << (i + 1);
+                    escaped |= next;
+                    pending &= ~next;
+                }
+                return escaped;
+            }
+
+            static uint64_t prefixXor(uint64_t x) {
+                x ^= x << 1;
+                x ^= x << 2;
+                x ^= x << 4;
+                x ^= x << 8;
+                x ^= x << 16;
+                x ^= x << 32;
+                return x;
+            }
+
+        public:
+            Scanner() :
+                prevEscaped(false),
+                prevInString(0),
+                prevScalar(0)
+            {}
+
+            bool inString() const { return prevInString != 0; }
+
+            void process(const BlockMasks& m, uint32_t base, std::vector<uint32_t>& out) {
+                uint64_t escaped = escapedMask(m.backslash);
+
+                /* Opening quotes are inside the mask, closing ones are not */
+                uint64_t quote = m.quote & ~escaped;
+                uint64_t inString = prefixXor(quote) ^ prevInString;
+                prevInString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+                uint64_t scalar = ~(m.whitespace | m.op | m.quote | inString);
+                uint64_t scalarStart = scalar & ~((scalar << 1) | prevScalar);
+                prevScalar = scalar >> 63;
+
+                uint64_t structurals = (m.op & ~inString) | quote | scalarStart;
+                if(!structurals) return;
+
+                size_t n = out.size();
+                out.resize(n + static_cast<size_t>(__builtin_popcountll(structurals)));
+                uint32_t* dst = out.data() + n;
+                while(structurals) {
+                    *dst++ = base + static_cast<uint32_t>(lowestBit(structurals));
+                    structurals &= structurals - 1;
+                }
+            }
+    };
+
+    template<typename Classify>
+    bool run(std::string_view json, std::vector<uint32_t>& out, Classify classify) {
+        out.clear();
+        Scanner scanner;
+        BlockMasks masks;
+
+        const char* data = json.data();
+        size_t size = json.size();
+        size_t i = 0;
+        for(; i + BLOCK_SIZE <= size; i += BLOCK_SIZE) {
+            classify(data + i, masks);
+            scanner.process(masks, static_cast<uint32_t>(i), out);
+        }
+        if(i < size) {
+            char tail[BLOCK_SIZE];
+            memset(tail, ' ', BLOCK_SIZE);
+            memcpy(tail, data + i, size - i);
+            classify(tail, masks);
+            scanner.process(masks, static_cast<uint32_t>(i), out);
+        }
+        return !scanner.inString();
+    }
+}
+
+/*
+** Build
+*/
+bool StructuralIndex::buildScalar(std::string_view json, std::vector<uint32_t>& out) {
+    return run(json, out, classifyScalar);
+}
+
+bool StructuralIndex::buildSimd(std::string_view json, std::vector<uint32_t>& out) {
+#if STRUCTURAL_INDEX_SIMD
+    return run(json, out, classifySimd);
+#else
+    return buildScalar(json, out);
+#endif
+}
+
+bool StructuralIndex::build(std::string_view json, std::vector<uint32_t>& out) {
+    return hasSimd() ? buildSimd(json, out) : buildScalar(json, out);
+}
+
+const char* StructuralIndex::backend() {
+#if defined(STRUCTURAL_INDEX_WASM)
+    return "wasm-simd128";
+#elif defined(STRUCTURAL_INDEX_AVX2)
+    return "avx2";
+#elif defined(STRUCTURAL_INDEX_SSE)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#if defined(__wasm_simd128__)
+    #define STRUCTURAL_INDEX_SIMD 1
+    #define STRUCTURAL_INDEX_WASM 1
+#elif defined(__AVX2__)
+    #define STRUCTURAL_INDEX_SIMD 1
+    #define STRUCTURAL_INDEX_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64)
+    #define STRUCTURAL_INDEX_SIMD 1
+    #define STRUCTURAL_INDEX_SSE 1
+#else
+    #define STRUCTURAL_INDEX_SIMD 0
+#endif
+
+/*
+** First stage of the document parser. Classifies the input 64 bytes
+** at a time and records the offset of every structural character
+** outside strings, every unescaped quote (opening and closing) and the
+** first byte of every number/keyword. The second stage then jumps
+** between these offsets instead of scanning byte by byte.
+**
+** build() returns false if the input ends inside a string.
+*/
+class StructuralIndex {
+    public:
+        static bool build(std::string_view json, std::vector<uint32_t>& out);
+        static bool buildScalar(std::string_view json, std::vector<uint32_t>& out);
+        static bool buildSimd(std::string_view json, std::vector<uint32_t>& out);
+
+        static bool hasSimd() { return STRUCTURAL_INDEX_SIMD != 0; }
+        static const char* backend();
+};
@@ -0,0 +1,121 @@
+#include "file_source.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <utility>
+
+#ifndef __EMSCRIPTEN__
+    #include <sys/mman.h>
+#endif
+
+FileSource::FileSource() :
+    bytes(nullptr),
+    length(0),
+    mapped(false),
+    opened(false)
+{}
+
+FileSource::FileSource(const std::string& path) : FileSource() {
+    open(path);
+}
+
+FileSource::~FileSource() {
+    close();
+}
+
+FileSource::FileSource(FileSource&& other) noexcept :
+    bytes(std::exchange(other.bytes, nullptr)),
+    length(std::exchange(other.length, 0)),
+    mapped(std::exchange(other.mapped, false)),
+    opened(std::exchange(other.opened, false))
+{}
+
+FileSource& FileSource::operator=(FileSource&& other) noexcept {
+    if(this != &other) {
+        close();
+        bytes = std::exchange(other.bytes, nullptr);
+        length = std::exchange(other.length, 0);
+        mapped = std::exchange(other.mapped, false);
+        opened = std::exchange(other.opened, false);
+    }
+    return *this;
+}
+
+/*
+** Open
+*/
+bool FileSource::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    length = static_cast<size_t>(info.st_size);
+
+#ifndef __EMSCRIPTEN__
+    /* MEMFS in the browser would copy on mmap anyway, so only map natively */
+    if(length > 0) {
+        void* map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(map != MAP_FAILED) {
+            madvise(map, length, MADV_SEQUENTIAL);
+            bytes = static_cast<const char*>(map);
+            mapped = true;
+            opened = true;
+            ::close(fd);
+            return true;
+        }
+    }
+#endif
+
+    opened = readWhole(fd);
+    ::close(fd);
+    if(!opened) close();
+    return opened;
+}
+
+/*
+ * One allocation and one read loop, no stream buffering
+ */
+bool FileSource::readWhole(int fd) {
+    if(length == 0) return true;
+
+    char* buffer = new char[length];
+    size_t done = 0;
+    while(done < length) {
+        ssize_t n = ::read(fd, buffer + done, length - done);
+        if(n < 0 && errno == EINTR) continue;
+        if(n <= 0) {
+            delete[] buffer;
+            return false;
+        }
+        done += static_cast<size_t>(n);
+    }
+    bytes = buffer;
+    return true;
+}
+
+/*
+** Close
+*/
+void FileSource::close() {
+    if(bytes) {
+#ifndef __EMSCRIPTEN__
+        if(mapped) {
+            munmap(const_cast<char*>(bytes), length);
+        } else {
+            delete[] bytes;
+        }
+#else
+        delete[] bytes;
+#endif
+    }
+    bytes = nullptr;
+    length = 0;
+    mapped = false;
+    opened = false;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/*
+** Read-only view of a whole file. Native builds map the file, so
+** parsers read straight from the page cache; the browser reads the
+** preloaded FS file into one buffer. Either way the caller gets a
+** contiguous view that lives as long as the FileSource.
+*/
+class FileSource {
+    public:
+        FileSource();
+        explicit FileSource(const std::string& path);
+        ~FileSource();
+        FileSource(FileSource&& other) noexcept;
+        FileSource& operator=(FileSource&& other) noexcept;
+        FileSource(const FileSource&) = delete;
+        FileSource& operator=(const FileSource&) = delete;
+
+        bool open(const std::string& path);
+        void close();
+
+        bool isOpen() const { return opened; }
+        bool isMapped() const { return mapped; }
+        const char* data() const { return bytes; }
+        size_t size() const { return length; }
+        std::string_view view() const { return std::string_view(bytes, length); }
+
+    private:
+        const char* bytes;
+        size_t length;
+        bool mapped;
+        bool opened;
+
+        bool readWhole(int fd);
+};
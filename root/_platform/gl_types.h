@@ -0,0 +1,14 @@
+#pragma once
+
+/*
+** GL scalar types for headers shared with the native core, which
+** links no GL implementation.
+*/
+#ifdef __EMSCRIPTEN__
+    #include <GLES3/gl3.h>
+#else
+    typedef unsigned int GLuint;
+    typedef int GLint;
+    typedef unsigned int GLenum;
+    typedef float GLfloat;
+#endif
@@ -0,0 +1,47 @@
+#include "platform.h"
+#include <chrono>
+
+#ifndef PLANET_DATA_ROOT
+    #define PLANET_DATA_ROOT ""
+#endif
+
+namespace {
+    std::string& dataRoot() {
+        static std::string root = PLANET_DATA_ROOT;
+        return root;
+    }
+}
+
+double Platform::now() {
+#ifdef __EMSCRIPTEN__
+    return emscripten_get_now();
+#else
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+bool Platform::isBrowser() {
+#ifdef __EMSCRIPTEN__
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+** Data Root
+*/
+void Platform::setDataRoot(const std::string& root) {
+    dataRoot() = root;
+    while(!dataRoot().empty() && dataRoot().back() == '/') dataRoot().pop_back();
+}
+
+/*
+ * Only absolute paths are rebased; relative ones stay relative to the
+ * working directory
+ */
+std::string Platform::resolve(const std::string& path) {
+    if(dataRoot().empty() || path.empty() || path[0] != '/') return path;
+    return dataRoot() + path;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+/*
+** Browser/native seam. Code that must build into the native core
+** library includes this instead of <emscripten.h> directly.
+*/
+#ifdef __EMSCRIPTEN__
+    #include <emscripten.h>
+#else
+    #ifndef EMSCRIPTEN_KEEPALIVE
+        #define EMSCRIPTEN_KEEPALIVE
+    #endif
+#endif
+#include <string>
+
+namespace Platform {
+    /* Monotonic time in milliseconds */
+    double now();
+    bool isBrowser();
+
+    /* Directory that absolute asset paths like /_data/... resolve
+       against: the preload FS root in the browser, PLANET_DATA_ROOT
+       (the source tree) natively */
+    void setDataRoot(const std::string& root);
+    std::string resolve(const std::string& path);
+}
@@ -1,6 +1,7 @@
 precision mediump float;
 
 varying vec3 vColor;
+varying float vHover;
 uniform float isHovered;
 
 varying vec2 vTexCoord;
@@ -15,6 +16,6 @@ void main() {
         base = vColor;
     }
     vec3 hoverColor = vec3(1.0, 1.0, 1.0);
-    vec3 finalColor = mix(base, hoverColor, isHovered);
+    vec3 finalColor = mix(base, hoverColor, max(isHovered, vHover));
     gl_FragColor = vec4(finalColor, 1.0);
 }
\ No newline at end of file
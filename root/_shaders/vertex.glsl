@@ -1,16 +1,27 @@
 attribute vec3 aPos;
 attribute vec2 aTexCoord;
 
+attribute mat4 aInstanceModel;
+attribute vec3 aInstanceColor;
+attribute float aInstanceHover;
+attribute vec4 aInstanceUvRect;
+
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
+uniform bool uInstanced;
+uniform vec4 uUvRect;
 
 uniform vec3 pColor;
 varying vec3 vColor;
 varying vec2 vTexCoord;
+varying float vHover;
 
 void main() {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
-    vColor = pColor;
-    vTexCoord = aTexCoord;
+    mat4 m = uInstanced ? aInstanceModel : model;
+    gl_Position = projection * view * m * vec4(aPos, 1.0);
+    vColor = uInstanced ? aInstanceColor : pColor;
+    vHover = uInstanced ? aInstanceHover : 0.0;
+    vec4 rect = uInstanced ? aInstanceUvRect : uUvRect;
+    vTexCoord = rect.xy + aTexCoord * rect.zw;
 }
\ No newline at end of file
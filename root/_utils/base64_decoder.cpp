@@ -1,82 +1,372 @@
 #include "base64_decoder.h"
 #include <stdexcept>
-#include <algorithm>
-#include <cctype>
-
-const std::string Base64Decoder::chars =
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-    "abcdefghijklmnopqrstuvwxyz"
-    "0123456789+/";
-
-bool Base64Decoder::isBase64(unsigned char c) {
-    return (isalnum(c) ||
-        (c == '+') ||
-        (c == '/')
-    );
+
+#if defined(BASE64_WASM)
+    #include <wasm_simd128.h>
+#elif defined(BASE64_AVX2)
+    #include <immintrin.h>
+#elif defined(BASE64_SSSE3)
+    #include <tmmintrin.h>
+#endif
+
+namespace {
+    /*
+    ** Scalar decoding
+    */
+    enum : uint8_t {
+        VALUE_WHITESPACE = 0x80,
+        VALUE_PADDING = 0x81,
+        VALUE_INVALID = 0xFF
+    };
+
+    struct DecodeTable {
+        uint8_t table[256];
+
+        DecodeTable() {
+            for(int i = 0; i < 256; i++) table[i] = VALUE_INVALID;
+            const char* chars =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                "abcdefghijklmnopqrstuvwxyz"
+                "0123456789+/";
+            for(uint8_t i = 0; i < 64; i++) {
+                table[static_cast<uint8_t>(chars[i])] = i;
+            }
+            for(char c : { ' ', '\t', '\n', '\r', '\f', '\v' }) {
+                table[static_cast<uint8_t>(c)] = VALUE_WHITESPACE;
+            }
+            table[static_cast<uint8_t>('=')] = VALUE_PADDING;
+        }
+    };
+    const DecodeTable decodeTable;
+
+    /*
+     * Whole quads of alphabet characters; stops at the first quad
+     * holding whitespace, padding or an invalid byte
+     */
+    void decodeQuads(const unsigned char*& in, const unsigned char* end, unsigned char*& out) {
+        const uint8_t* table = decodeTable.table;
+        while(end - in >= 4) {
+            uint32_t a = table[in[0]];
+            uint32_t b = table[in[1]];
+            uint32_t c = table[in[2]];
+            uint32_t d = table[in[3]];
+            if((a | b | c | d) & 0x80) break;
+            uint32_t v = a << 18 | b << 12 | c << 6 | d;
+            out[0] = static_cast<unsigned char>(v >> 16);
+            out[1] = static_cast<unsigned char>(v >> 8);
+            out[2] = static_cast<unsigned char>(v);
+            in += 4;
+            out += 3;
+        }
+    }
+
+    /*
+    ** SIMD decoding
+    **
+    ** Bytes are validated and mapped to 6-bit values with lookups on
+    ** their low and high nibbles (W. Mula, D. Lemire), then each 4 x 6
+    ** bits are packed into 3 bytes. A vector holding anything but
+    ** alphabet characters is left to the scalar loop. Stores write a
+    ** full vector, so the loop also stops a vector short of the end of
+    ** the output.
+    */
+#if defined(BASE64_SSSE3) || defined(BASE64_AVX2)
+    inline bool translate(__m128i& v) {
+        const __m128i lutLo = _mm_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m128i lutHi = _mm_setr_epi8(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m128i lutRoll = _mm_setr_epi8(
+            0, 16, 19, 4, -65, -65, -71, -71,
+            0, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i mask2F = _mm_set1_epi8(0x2F);
+
+        __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(v, 4), mask2F);
+        __m128i loNibbles = _mm_and_si128(v, mask2F);
+        __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+        __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+        __m128i valid = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+        if(_mm_movemask_epi8(valid) != 0xFFFF) return false;
+
+        __m128i eq2F = _mm_cmpeq_epi8(v, mask2F);
+        __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles));
+        v = _mm_add_epi8(v, roll);
+        return true;
+    }
+
+    inline __m128i pack(__m128i v) {
+        __m128i pairs = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+        __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        return _mm_shuffle_epi8(quads, _mm_setr_epi8(
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    }
+
+    void decodeVectors128(const unsigned char*& in, const unsigned char* end, unsigned char*& out, const unsigned char* outEnd) {
+        while(end - in >= 16 && outEnd - out >= 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            if(!translate(v)) return;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), pack(v));
+            in += 16;
+            out += 12;
+        }
+    }
+#endif
+
+#if defined(BASE64_AVX2)
+    inline bool translate(__m256i& v) {
+        const __m256i lutLo = _mm256_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m256i lutHi = _mm256_setr_epi8(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m256i lutRoll = _mm256_setr_epi8(
+            0, 16, 19, 4, -65, -65, -71, -71,
+            0, 0, 0, 0, 0, 0, 0, 0,
+            0, 16, 19, 4, -65, -65, -71, -71,
+            0, 0, 0, 0, 0, 0, 0, 0);
+        const __m256i mask2F = _mm256_set1_epi8(0x2F);
+
+        __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(v, 4), mask2F);
+        __m256i loNibbles = _mm256_and_si256(v, mask2F);
+        __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+        __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+        if(!_mm256_testz_si256(lo, hi)) return false;
+
+        __m256i eq2F = _mm256_cmpeq_epi8(v, mask2F);
+        __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles));
+        v = _mm256_add_epi8(v, roll);
+        return true;
+    }
+
+    inline __m256i pack(__m256i v) {
+        __m256i pairs = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+        __m256i quads = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        __m256i lanes = _mm256_shuffle_epi8(quads, _mm256_setr_epi8(
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        /* 12 bytes at the bottom of each lane; join them */
+        return _mm256_permutevar8x32_epi32(lanes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+    }
+
+    void decodeVectors(const unsigned char*& in, const unsigned char* end, unsigned char*& out, const unsigned char* outEnd) {
+        while(end - in >= 32 && outEnd - out >= 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+            if(!translate(v)) break;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), pack(v));
+            in += 32;
+            out += 24;
+        }
+        decodeVectors128(in, end, out, outEnd);
+    }
+#elif defined(BASE64_SSSE3)
+    void decodeVectors(const unsigned char*& in, const unsigned char* end, unsigned char*& out, const unsigned char* outEnd) {
+        decodeVectors128(in, end, out, outEnd);
+    }
+#elif defined(BASE64_WASM)
+    inline bool translate(v128_t& v) {
+        const v128_t lutLo = wasm_i8x16_make(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const v128_t lutHi = wasm_i8x16_make(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const v128_t lutRoll = wasm_i8x16_make(
+            0, 16, 19, 4, -65, -65, -71, -71,
+            0, 0, 0, 0, 0, 0, 0, 0);
+
+        /* swizzle zeroes out-of-range lanes, so nibbles must be exact */
+        v128_t hiNibbles = wasm_u8x16_shr(v, 4);
+        v128_t loNibbles = wasm_v128_and(v, wasm_i8x16_splat(0x0F));
+        v128_t lo = wasm_i8x16_swizzle(lutLo, loNibbles);
+        v128_t hi = wasm_i8x16_swizzle(lutHi, hiNibbles);
+        if(wasm_v128_any_true(wasm_v128_and(lo, hi))) return false;
+
+        v128_t eq2F = wasm_i8x16_eq(v, wasm_i8x16_splat(0x2F));
+        v128_t roll = wasm_i8x16_swizzle(lutRoll, wasm_i8x16_add(eq2F, hiNibbles));
+        v = wasm_i8x16_add(v, roll);
+        return true;
+    }
+
+    inline v128_t pack(v128_t v) {
+        v128_t pairs = wasm_v128_or(
+            wasm_i16x8_shl(wasm_v128_and(v, wasm_i16x8_splat(0x00FF)), 6),
+            wasm_u16x8_shr(v, 8));
+        v128_t quads = wasm_v128_or(
+            wasm_i32x4_shl(wasm_v128_and(pairs, wasm_i32x4_splat(0xFFFF)), 12),
+            wasm_u32x4_shr(pairs, 16));
+        return wasm_i8x16_swizzle(quads, wasm_i8x16_make(
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    }
+
+    void decodeVectors(const unsigned char*& in, const unsigned char* end, unsigned char*& out, const unsigned char* outEnd) {
+        while(end - in >= 16 && outEnd - out >= 16) {
+            v128_t v = wasm_v128_load(in);
+            if(!translate(v)) return;
+            wasm_v128_store(out, pack(v));
+            in += 16;
+            out += 12;
+        }
+    }
+#endif
 }
 
-bool Base64Decoder::isValid(const std::string& str) {
-    if(str.length() % 4 != 0) return false;
-    for(char c : str) {
-        if(!isBase64(static_cast<unsigned char>(c)) && c != '=') {
-            return false;
+/*
+** Stream
+*/
+Base64Decoder::Stream::Stream(bool simd) :
+    bits(0),
+    pending(0),
+    padding(0),
+    failed(false),
+    simd(simd)
+{}
+
+void Base64Decoder::Stream::reset() {
+    bits = 0;
+    pending = 0;
+    padding = 0;
+    failed = false;
+}
+
+bool Base64Decoder::Stream::write(std::string_view chunk, std::vector<unsigned char>& out) {
+    if(failed) return false;
+
+    /* Upper bound for this chunk; trimmed to what was written below */
+    size_t start = out.size();
+    out.resize(start + (pending + chunk.size()) / 4 * 3);
+
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(chunk.data());
+    const unsigned char* end = in + chunk.size();
+    unsigned char* dst = out.data() + start;
+#if BASE64_SIMD
+    const unsigned char* dstEnd = out.data() + out.size();
+#endif
+    while(in < end) {
+        if(pending == 0 && padding == 0) {
+#if BASE64_SIMD
+            if(simd) decodeVectors(in, end, dst, dstEnd);
+#endif
+            decodeQuads(in, end, dst);
+            if(in == end) break;
+        }
+
+        uint8_t value = decodeTable.table[*in++];
+        if(value < 64) {
+            if(padding != 0) {
+                failed = true;
+                break;
+            }
+            bits = bits << 6 | value;
+            if(++pending == 4) {
+                dst[0] = static_cast<unsigned char>(bits >> 16);
+                dst[1] = static_cast<unsigned char>(bits >> 8);
+                dst[2] = static_cast<unsigned char>(bits);
+                dst += 3;
+                bits = 0;
+                pending = 0;
+            }
+        } else if(value == VALUE_PADDING) {
+            if(pending < 2 || pending + ++padding > 4) {
+                failed = true;
+                break;
+            }
+        } else if(value != VALUE_WHITESPACE) {
+            failed = true;
+            break;
         }
     }
-    return true;
+    out.resize(dst - out.data());
+    return !failed;
+}
+
+/*
+ * Flushes a padded final quad. Input that stops mid-quad without
+ * padding is rejected, as isValid() does.
+ */
+bool Base64Decoder::Stream::finish(std::vector<unsigned char>& out) {
+    bool ok = !failed && (pending == 0 || pending + padding == 4);
+    if(ok && pending == 3) {
+        out.push_back(static_cast<unsigned char>(bits >> 10));
+        out.push_back(static_cast<unsigned char>(bits >> 2));
+    } else if(ok && pending == 2) {
+        out.push_back(static_cast<unsigned char>(bits >> 4));
+    }
+    reset();
+    return ok;
 }
 
-std::vector<unsigned char> Base64Decoder::decode(const std::string& encoded) {
-    std::string clean_encoded = encoded;
-    
-    size_t pos = clean_encoded.find("base64,");
-    if(pos != std::string::npos) {
-        clean_encoded = clean_encoded.substr(pos + 7);
-    }
-    
-    clean_encoded.erase(std::remove_if(clean_encoded.begin(), clean_encoded.end(), 
-        [](char c) { return std::isspace(c); }), clean_encoded.end());
-    
-    if(!isValid(clean_encoded)) {
+/*
+** Decode
+*/
+std::vector<unsigned char> Base64Decoder::decode(std::string_view encoded) {
+    std::string_view data = payload(encoded);
+    std::vector<unsigned char> out;
+    out.reserve(decodedSize(data));
+
+    Stream stream;
+    if(!stream.write(data, out) || !stream.finish(out)) {
         throw std::runtime_error("Invalid base64 string");
     }
-    
-    int in_len = clean_encoded.size();
-    int i = 0;
-    int j = 0;
-    int in_ = 0;
-    unsigned char char_array_4[4], char_array_3[3];
-    std::vector<unsigned char> ret;
-    
-    while(in_len-- && (clean_encoded[in_] != '=') && isBase64(clean_encoded[in_])) {
-        char_array_4[i++] = clean_encoded[in_]; in_++;
-        if(i == 4) {
-            for (i = 0; i < 4; i++)
-                char_array_4[i] = chars.find(char_array_4[i]);
-            
-            char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-            char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-            char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
-            
-            for (i = 0; (i < 3); i++)
-                ret.push_back(char_array_3[i]);
-            i = 0;
-        }
+    return out;
+}
+
+std::vector<unsigned char> Base64Decoder::decodeScalar(std::string_view encoded) {
+    std::string_view data = payload(encoded);
+    std::vector<unsigned char> out;
+    out.reserve(decodedSize(data));
+
+    Stream stream(false);
+    if(!stream.write(data, out) || !stream.finish(out)) {
+        throw std::runtime_error("Invalid base64 string");
+    }
+    return out;
+}
+
+/*
+ * Skips a "data:<type>;base64," prefix. Only a leading "data:" is
+ * looked at, so plain base64 is never scanned for the marker.
+ */
+std::string_view Base64Decoder::payload(std::string_view encoded) {
+    if(encoded.compare(0, 5, "data:") != 0) return encoded;
+    size_t comma = encoded.find(',');
+    if(comma == std::string_view::npos) return encoded;
+    std::string_view header = encoded.substr(0, comma);
+    if(header.size() < 7 || header.compare(header.size() - 7, 7, ";base64") != 0) return encoded;
+    return encoded.substr(comma + 1);
+}
+
+/*
+ * Room decode() needs for a payload; exact for unwrapped, unpadded
+ * input and at most two bytes over otherwise
+ */
+size_t Base64Decoder::decodedSize(std::string_view payload) {
+    return payload.size() / 4 * 3;
+}
+
+bool Base64Decoder::isValid(std::string_view str) {
+    if(str.size() % 4 != 0) return false;
+    for(char c : str) {
+        uint8_t value = decodeTable.table[static_cast<uint8_t>(c)];
+        if(value >= 64 && value != VALUE_PADDING) return false;
     }
-    
-    if(i) {
-        for (j = i; j < 4; j++)
-            char_array_4[j] = 0;
-        
-        for (j = 0; j < 4; j++)
-            char_array_4[j] = chars.find(char_array_4[j]);
-        
-        char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-        char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-        char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
-        
-        for (j = 0; (j < i - 1); j++)
-            ret.push_back(char_array_3[j]);
-    }
-    
-    return ret;
-}
\ No newline at end of file
+    return true;
+}
+
+const char* Base64Decoder::backend() {
+#if defined(BASE64_WASM)
+    return "wasm-simd128";
+#elif defined(BASE64_AVX2)
+    return "avx2";
+#elif defined(BASE64_SSSE3)
+    return "ssse3";
+#else
+    return "scalar";
+#endif
+}
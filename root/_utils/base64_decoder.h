@@ -1,13 +1,56 @@
 #pragma once
-#include <string>
+#include <cstdint>
+#include <string_view>
 #include <vector>
 
-class Base64Decoder {
-    private:
-        static const std::string chars;
-        static inline bool isBase64(unsigned char c);
+#if defined(__wasm_simd128__)
+    #define BASE64_SIMD 1
+    #define BASE64_WASM 1
+#elif defined(__AVX2__)
+    #define BASE64_SIMD 1
+    #define BASE64_AVX2 1
+#elif defined(__SSSE3__)
+    #define BASE64_SIMD 1
+    #define BASE64_SSSE3 1
+#else
+    #define BASE64_SIMD 0
+#endif
 
+/*
+** Table-driven base64 decoding. Runs of plain alphabet characters are
+** decoded a vector at a time; whitespace, padding and invalid bytes
+** drop to the scalar loop. A "data:...;base64," prefix is skipped by
+** decode().
+*/
+class Base64Decoder {
     public:
-        static std::vector<unsigned char> decode(const std::string& encoded);
-        static bool isValid(const std::string& str);
-};
\ No newline at end of file
+        /*
+         * Incremental decoder for input that arrives in chunks. Partial
+         * quads are carried across write() calls, so chunks can split
+         * the input anywhere. Decoded bytes are appended to out.
+         */
+        class Stream {
+            public:
+                explicit Stream(bool simd = true);
+
+                bool write(std::string_view chunk, std::vector<unsigned char>& out);
+                bool finish(std::vector<unsigned char>& out);
+                void reset();
+
+            private:
+                uint32_t bits;
+                int pending;
+                int padding;
+                bool failed;
+                bool simd;
+        };
+
+        static std::vector<unsigned char> decode(std::string_view encoded);
+        static std::vector<unsigned char> decodeScalar(std::string_view encoded);
+        static std::string_view payload(std::string_view encoded);
+        static size_t decodedSize(std::string_view payload);
+        static bool isValid(std::string_view str);
+
+        static bool hasSimd() { return BASE64_SIMD != 0; }
+        static const char* backend();
+};
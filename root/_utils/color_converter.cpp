@@ -3,6 +3,7 @@
 #include <iomanip>
 #include <algorithm>
 #include <regex>
+#include <unordered_map>
 #include <cmath>
 #include <iostream>
 
@@ -1,65 +1,50 @@
 #include "default_data.h"
-#include "../.preset/preset_manager.h"
-#include "../_utils/color_converter.h"
-#include <fstream>
-#include <sstream>
-#include <emscripten.h>
+#include "../_data/asset_cache.h"
+#include <iostream>
 
-DefaultData::DefaultData(PresetManager* presetManager) :
-    presetManager(presetManager)
-{};
+const std::string DefaultData::PATH = "/_data/default_planet_data.json";
+
+DefaultData::DefaultData() {};
 DefaultData::~DefaultData() {};
 
+/*
+ * Idempotent: the file is parsed once by the asset cache, and the
+ * entries are only rebuilt when the cache hands back a new view
+ */
 void DefaultData::init() {
-    setPath();
-    setData();
-}
+    std::shared_ptr<const PresetData> preset = AssetCache::get().getPreset(PATH);
+    if(!preset || preset->planets.empty()) {
+        std::cerr << "Failed to parse default data!" << std::endl;
+        return;
+    }
+    if(preset == source) return;
 
-void DefaultData::setPath() {
-    path = "/_data/default_planet_data.json";
-    presetManager->getPresetLoader()->setPath(path);
-}
+    source = preset;
+    defaultData.clear();
+    for(const auto& planet : preset->planets) {
+        DefaultData::Data data;
+        data.id = planet.id;
+        data.name = planet.name;
+        data.shape = planet.shape;
+        data.size = planet.size;
+        data.color = planet.color;
+        data.colorRgb = planet.colorRgb;
+        data.texture = planet.texture;
+        data.position = planet.position;
+        data.rotationDir = planet.rotationDir;
+        data.rotationSpeedItself = planet.rotationSpeedItself;
+        data.rotationSpeedCenter = planet.rotationSpeedCenter;
+        data.distanceFromCenter = planet.distanceFromCenter;
+        data.currentRotation = planet.currentRotation;
+        data.orbitAngle = planet.orbitAngle;
 
-bool DefaultData::setData() {
-    std::ifstream file(path);
-    if(!file.is_open()) {
-        std::cerr << "Failed to open default data file: " << path << std::endl;
-        return false;
+        defaultData.push_back(data);
     }
+}
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string data = buffer.str();    
-    bool res = presetManager->getPresetLoader()->parse(data);
-    
-    if(res) {
-        const auto& planets = presetManager->getPresetLoader()->getCurrentPreset().planets;
-        defaultData.clear();
-        
-        for(const auto& planet : planets) {
-            DefaultData::Data data;
-            data.id = planet.id;
-            data.name = planet.name;
-            data.shape = planet.shape;
-            data.size = planet.size;
-            data.color = planet.color;
-            data.colorRgb = planet.colorRgb;
-            data.texture = planet.texture;
-            data.position = planet.position;
-            data.rotationDir = planet.rotationDir;
-            data.rotationSpeedItself = planet.rotationSpeedItself;
-            data.rotationSpeedCenter = planet.rotationSpeedCenter;
-            data.distanceFromCenter = planet.distanceFromCenter;
-            data.currentRotation = planet.currentRotation;
-            data.orbitAngle = planet.orbitAngle;
-            
-            defaultData.push_back(data);
-        }
-    } else {
-        std::cerr << "Failed to parse default data!" << std::endl;
-    }
-    
-    return res;
+void DefaultData::reload() {
+    AssetCache::get().invalidate(PATH);
+    init();
 }
 
 PlanetData DefaultData::Data::toPlanetData() const {
@@ -1,8 +1,8 @@
 #pragma once
 #include "../.preset/preset_data.h"
 #include <glm/glm.hpp>
+#include <memory>
 
-class PresetManager;
 class DefaultData {
     public:
         struct Data {
@@ -10,7 +10,7 @@ class DefaultData {
             std::string name;
             BufferData::Type shape;
             float size;
-            std::string texture;
+            TextureRegistry::Handle texture;
             std::string color;
             glm::vec3 colorRgb;
             int position;
@@ -24,18 +24,16 @@ class DefaultData {
             PlanetData toPlanetData() const;
         };
 
-        DefaultData(PresetManager* presetManager);
+        DefaultData();
         ~DefaultData();
 
         const std::vector<Data>& getAllData() const;
         void init();
+        void reload();
 
     private:
-        PresetManager* presetManager;
-        std::vector<Data> defaultData;
-
-        std::string path;
+        static const std::string PATH;
 
-        void setPath();
-        bool setData();
+        std::shared_ptr<const PresetData> source;
+        std::vector<Data> defaultData;
 };
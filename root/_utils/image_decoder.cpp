@@ -0,0 +1,138 @@
+#include "image_decoder.h"
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <png.h>
+#include <jpeglib.h>
+
+namespace {
+    constexpr unsigned char PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    constexpr unsigned char JPEG_SIGNATURE[3] = { 0xFF, 0xD8, 0xFF };
+
+    /* Anything larger is rejected before the pixel buffer is sized */
+    constexpr size_t MAX_PIXELS = 8192 * 8192;
+
+    /*
+     * libjpeg's default error handler exits the process; jump back
+     * into decodeJpeg instead
+     */
+    struct JpegError {
+        jpeg_error_mgr mgr;
+        jmp_buf jump;
+    };
+
+    void onJpegError(j_common_ptr info) {
+        JpegError* err = reinterpret_cast<JpegError*>(info->err);
+        char msg[JMSG_LENGTH_MAX];
+        (*info->err->format_message)(info, msg);
+        std::cerr << "JPEG decode error: " << msg << std::endl;
+        longjmp(err->jump, 1);
+    }
+
+    void onJpegMessage(j_common_ptr info) {
+        (void)info;
+    }
+}
+
+/*
+** Detect
+*/
+ImageDecoder::Format ImageDecoder::detect(const unsigned char* data, size_t size) {
+    if(size >= sizeof(PNG_SIGNATURE) && memcmp(data, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) == 0) {
+        return Format::PNG;
+    }
+    if(size >= sizeof(JPEG_SIGNATURE) && memcmp(data, JPEG_SIGNATURE, sizeof(JPEG_SIGNATURE)) == 0) {
+        return Format::JPEG;
+    }
+    return Format::UNKNOWN;
+}
+
+/*
+** Decode
+*/
+bool ImageDecoder::decode(const unsigned char* data, size_t size, Image& out) {
+    switch(detect(data, size)) {
+        case Format::PNG: return decodePng(data, size, out);
+        case Format::JPEG: return decodeJpeg(data, size, out);
+        case Format::UNKNOWN: break;
+    }
+    std::cerr << "Unknown image format" << std::endl;
+    return false;
+}
+
+bool ImageDecoder::decodePng(const unsigned char* data, size_t size, Image& out) {
+    png_image image;
+    memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+    if(!png_image_begin_read_from_memory(&image, data, size)) {
+        std::cerr << "PNG decode error: " << image.message << std::endl;
+        return false;
+    }
+    if(static_cast<size_t>(image.width) * image.height > MAX_PIXELS) {
+        std::cerr << "PNG too large: " << image.width << "x" << image.height << std::endl;
+        png_image_free(&image);
+        return false;
+    }
+
+    image.format = PNG_FORMAT_RGBA;
+    out.pixels.resize(PNG_IMAGE_SIZE(image));
+    if(!png_image_finish_read(&image, nullptr, out.pixels.data(), 0, nullptr)) {
+        std::cerr << "PNG decode error: " << image.message << std::endl;
+        return false;
+    }
+    out.width = static_cast<int>(image.width);
+    out.height = static_cast<int>(image.height);
+    return true;
+}
+
+/*
+ * Decoded as RGB one scanline at a time and widened to RGBA in
+ * place, which every libjpeg version supports
+ */
+bool ImageDecoder::decodeJpeg(const unsigned char* data, size_t size, Image& out) {
+    jpeg_decompress_struct info;
+    JpegError err;
+    info.err = jpeg_std_error(&err.mgr);
+    err.mgr.error_exit = onJpegError;
+    err.mgr.output_message = onJpegMessage;
+    if(setjmp(err.jump)) {
+        jpeg_destroy_decompress(&info);
+        return false;
+    }
+
+    jpeg_create_decompress(&info);
+    jpeg_mem_src(&info, const_cast<unsigned char*>(data), static_cast<unsigned long>(size));
+    jpeg_read_header(&info, TRUE);
+    info.out_color_space = JCS_RGB;
+    jpeg_start_decompress(&info);
+
+    size_t width = info.output_width;
+    size_t height = info.output_height;
+    if(width * height > MAX_PIXELS || info.output_components != 3) {
+        std::cerr << "Unsupported JPEG: " << width << "x" << height << std::endl;
+        jpeg_destroy_decompress(&info);
+        return false;
+    }
+
+    out.pixels.resize(width * height * 4);
+    size_t stride = width * 4;
+    while(info.output_scanline < info.output_height) {
+        unsigned char* row = out.pixels.data() + info.output_scanline * stride;
+        /* RGB lands in the tail of the row so widening never overlaps */
+        unsigned char* rgb = row + width;
+        jpeg_read_scanlines(&info, &rgb, 1);
+        for(size_t x = 0; x < width; x++) {
+            row[x * 4] = rgb[x * 3];
+            row[x * 4 + 1] = rgb[x * 3 + 1];
+            row[x * 4 + 2] = rgb[x * 3 + 2];
+            row[x * 4 + 3] = 255;
+        }
+    }
+    jpeg_finish_decompress(&info);
+    jpeg_destroy_decompress(&info);
+
+    out.width = static_cast<int>(width);
+    out.height = static_cast<int>(height);
+    return true;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/*
+** Decodes PNG and JPEG files to tightly packed RGBA8 rows, top row
+** first. decode() writes into the image's existing pixel buffer, so a
+** caller that keeps Image objects around reuses their allocations.
+*/
+class ImageDecoder {
+    public:
+        enum class Format {
+            UNKNOWN,
+            PNG,
+            JPEG
+        };
+
+        struct Image {
+            int width = 0;
+            int height = 0;
+            std::vector<unsigned char> pixels;
+        };
+
+        static Format detect(const unsigned char* data, size_t size);
+        static bool decode(const unsigned char* data, size_t size, Image& out);
+        static bool decodePng(const unsigned char* data, size_t size, Image& out);
+        static bool decodeJpeg(const unsigned char* data, size_t size, Image& out);
+};
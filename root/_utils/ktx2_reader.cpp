@@ -0,0 +1,128 @@
+#include "ktx2_reader.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    constexpr unsigned char KTX2_SIGNATURE[12] = {
+        0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+    };
+
+    /* Identifier, nine header words, then the index (4 x u32, 2 x u64) */
+    constexpr size_t HEADER_SIZE = 80;
+    constexpr size_t LEVEL_ENTRY_SIZE = 24;
+    constexpr uint32_t MAX_LEVELS = 16;
+
+    /* VkFormat values */
+    constexpr uint32_t VK_UNDEFINED = 0;
+    constexpr uint32_t VK_R8G8B8A8_UNORM = 37;
+    constexpr uint32_t VK_R8G8B8A8_SRGB = 43;
+    constexpr uint32_t VK_BC1_RGB_UNORM = 131;
+    constexpr uint32_t VK_BC1_RGBA_SRGB = 134;
+    constexpr uint32_t VK_BC3_UNORM = 137;
+    constexpr uint32_t VK_BC3_SRGB = 138;
+    constexpr uint32_t VK_ETC2_RGB8_UNORM = 147;
+    constexpr uint32_t VK_ETC2_RGB8_SRGB = 148;
+    constexpr uint32_t VK_ETC2_RGBA8_UNORM = 151;
+    constexpr uint32_t VK_ETC2_RGBA8_SRGB = 152;
+    constexpr uint32_t VK_ASTC_4X4_UNORM = 157;
+    constexpr uint32_t VK_ASTC_4X4_SRGB = 158;
+
+    inline uint32_t readU32(const unsigned char* p) {
+        return p[0] | p[1] << 8 | p[2] << 16 | static_cast<uint32_t>(p[3]) << 24;
+    }
+
+    inline uint64_t readU64(const unsigned char* p) {
+        return readU32(p) | static_cast<uint64_t>(readU32(p + 4)) << 32;
+    }
+
+    bool toFormat(uint32_t vkFormat, TextureTranscoder::Format& format) {
+        using Format = TextureTranscoder::Format;
+        if(vkFormat == VK_R8G8B8A8_UNORM || vkFormat == VK_R8G8B8A8_SRGB) format = Format::RGBA8;
+        else if(vkFormat >= VK_BC1_RGB_UNORM && vkFormat <= VK_BC1_RGBA_SRGB) format = Format::BC1;
+        else if(vkFormat == VK_BC3_UNORM || vkFormat == VK_BC3_SRGB) format = Format::BC3;
+        else if(vkFormat == VK_ETC2_RGB8_UNORM || vkFormat == VK_ETC2_RGB8_SRGB) format = Format::ETC2_RGB8;
+        else if(vkFormat == VK_ETC2_RGBA8_UNORM || vkFormat == VK_ETC2_RGBA8_SRGB) format = Format::ETC2_RGBA8;
+        else if(vkFormat == VK_ASTC_4X4_UNORM || vkFormat == VK_ASTC_4X4_SRGB) format = Format::ASTC_4X4;
+        else return false;
+        return true;
+    }
+}
+
+/*
+** Read
+*/
+bool Ktx2Reader::isKtx2(const unsigned char* data, size_t size) {
+    return size >= sizeof(KTX2_SIGNATURE) && memcmp(data, KTX2_SIGNATURE, sizeof(KTX2_SIGNATURE)) == 0;
+}
+
+bool Ktx2Reader::read(const unsigned char* data, size_t size, TextureTranscoder::Texture& out) {
+    if(!isKtx2(data, size) || size < HEADER_SIZE) {
+        std::cerr << "Not a KTX2 file" << std::endl;
+        return false;
+    }
+
+    const unsigned char* header = data + sizeof(KTX2_SIGNATURE);
+    uint32_t vkFormat = readU32(header);
+    uint32_t width = readU32(header + 8);
+    uint32_t height = readU32(header + 12);
+    uint32_t depth = readU32(header + 16);
+    uint32_t layers = readU32(header + 20);
+    uint32_t faces = readU32(header + 24);
+    uint32_t levels = readU32(header + 28);
+    uint32_t supercompression = readU32(header + 32);
+
+    if(vkFormat == VK_UNDEFINED) {
+        std::cerr << "KTX2 Basis Universal payloads are not supported" << std::endl;
+        return false;
+    }
+    if(supercompression != 0) {
+        std::cerr << "KTX2 supercompression scheme " << supercompression << " is not supported" << std::endl;
+        return false;
+    }
+    if(depth > 1 || layers > 1 || faces != 1) {
+        std::cerr << "Only 2D KTX2 textures are supported" << std::endl;
+        return false;
+    }
+    if(width == 0 || height == 0 || width > 16384 || height > 16384) {
+        std::cerr << "Unsupported KTX2 size: " << width << "x" << height << std::endl;
+        return false;
+    }
+
+    TextureTranscoder::Format format;
+    if(!toFormat(vkFormat, format)) {
+        std::cerr << "Unsupported KTX2 format: " << vkFormat << std::endl;
+        return false;
+    }
+
+    /* Zero levels asks the loader to build the chain; only level 0 is stored */
+    if(levels == 0) levels = 1;
+    if(levels > MAX_LEVELS || HEADER_SIZE + levels * LEVEL_ENTRY_SIZE > size) {
+        std::cerr << "Invalid KTX2 level index" << std::endl;
+        return false;
+    }
+
+    out.format = format;
+    out.width = static_cast<int>(width);
+    out.height = static_cast<int>(height);
+    out.levels.clear();
+    out.data.clear();
+
+    const unsigned char* index = data + HEADER_SIZE;
+    for(uint32_t l = 0; l < levels; l++) {
+        int w = std::max(1, out.width >> l);
+        int h = std::max(1, out.height >> l);
+        uint64_t offset = readU64(index + l * LEVEL_ENTRY_SIZE);
+        uint64_t length = readU64(index + l * LEVEL_ENTRY_SIZE + 8);
+        size_t expected = TextureTranscoder::levelSize(format, w, h);
+        if(length < expected || offset > size || length > size - offset) {
+            std::cerr << "Truncated KTX2 level " << l << std::endl;
+            return false;
+        }
+        out.levels.push_back(TextureTranscoder::Level{w, h, out.data.size(), expected});
+        out.data.insert(out.data.end(), data + offset, data + offset + expected);
+        if(w == 1 && h == 1) break;
+    }
+    return true;
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "texture_transcoder.h"
+#include <cstddef>
+
+/*
+** Reads KTX2 files into a TextureTranscoder::Texture: a single 2D
+** image with its mip levels, level 0 first. Supported payloads are
+** RGBA8 and the block formats the transcoder knows (BC1, BC3, ETC2,
+** EAC and ASTC 4x4), with no supercompression. sRGB variants load as
+** their UNORM twins, as the renderer samples everything linearly, and
+** BC1 with punch-through alpha loads as opaque BC1.
+**
+** Basis Universal files (BasisLZ or UASTC) need the basisu transcoder
+** and are rejected.
+*/
+class Ktx2Reader {
+    public:
+        static bool isKtx2(const unsigned char* data, size_t size);
+        static bool read(const unsigned char* data, size_t size, TextureTranscoder::Texture& out);
+};
@@ -0,0 +1,135 @@
+#include "profiler.h"
+#include "../_platform/platform.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+Profiler::Profiler() {
+    reset();
+}
+
+Profiler& Profiler::get() {
+    static Profiler profiler;
+    return profiler;
+}
+
+const char* Profiler::zoneName(Zone zone) {
+    static const char* names[ZONE_COUNT] = {
+        "simulation",
+        "culling",
+        "uniforms",
+        "draw",
+        "raycast",
+        "preset_io",
+        "preview",
+        "textures"
+    };
+    size_t i = static_cast<size_t>(zone);
+    return i < ZONE_COUNT ? names[i] : "unknown";
+}
+
+void Profiler::reset() {
+    memset(frames, 0, sizeof(frames));
+    memset(&current, 0, sizeof(current));
+    memset(&stats, 0, sizeof(stats));
+    head = 0;
+    count = 0;
+    frameStart = 0.0;
+}
+
+/*
+** Scope
+*/
+Profiler::Scope::Scope(Zone zone) :
+    zone(zone),
+    start(Platform::now())
+{}
+
+Profiler::Scope::~Scope() {
+    Profiler::get().addZoneTime(zone, Platform::now() - start);
+}
+
+/*
+** Frames
+*/
+void Profiler::beginFrame() {
+    double now = Platform::now();
+    if(frameStart > 0.0) {
+        current.frameMs = static_cast<float>(now - frameStart);
+        frames[head] = current;
+        head = (head + 1) % FRAME_HISTORY;
+        if(count < FRAME_HISTORY) count++;
+    }
+    memset(&current, 0, sizeof(current));
+    frameStart = now;
+}
+
+void Profiler::addZoneTime(Zone zone, double ms) {
+    size_t i = static_cast<size_t>(zone);
+    if(i < ZONE_COUNT) current.zoneMs[i] += static_cast<float>(ms);
+}
+
+/*
+** Stats
+*/
+const Profiler::Stats& Profiler::computeStats() {
+    memset(&stats, 0, sizeof(stats));
+    if(count == 0) return stats;
+
+    float sorted[FRAME_HISTORY];
+    double frameSum = 0.0;
+    double zoneSum[ZONE_COUNT] = {};
+    for(size_t i = 0; i < count; i++) {
+        const FrameRecord& frame = frames[i];
+        sorted[i] = frame.frameMs;
+        frameSum += frame.frameMs;
+        for(size_t z = 0; z < ZONE_COUNT; z++) zoneSum[z] += frame.zoneMs[z];
+    }
+    std::sort(sorted, sorted + count);
+
+    auto percentile = [&](float p) {
+        size_t index = static_cast<size_t>(p * (count - 1) + 0.5f);
+        return sorted[std::min(index, count - 1)];
+    };
+    stats.frameP50 = percentile(0.50f);
+    stats.frameP95 = percentile(0.95f);
+    stats.frameP99 = percentile(0.99f);
+    stats.frameAvg = static_cast<float>(frameSum / count);
+    for(size_t z = 0; z < ZONE_COUNT; z++) {
+        stats.zoneAvg[z] = static_cast<float>(zoneSum[z] / count);
+    }
+
+    const FrameRecord& last = frames[(head + FRAME_HISTORY - 1) % FRAME_HISTORY];
+    stats.drawCalls = last.drawCalls;
+    stats.triangles = last.triangles;
+    stats.uniformUploads = last.uniformUploads;
+    stats.frames = static_cast<uint32_t>(count);
+    return stats;
+}
+
+/*
+** Write CSV
+*/
+bool Profiler::writeCsv(const char* path) const {
+    FILE* file = fopen(path, "w");
+    if(!file) return false;
+
+    fprintf(file, "frame,frame_ms");
+    for(size_t z = 0; z < ZONE_COUNT; z++) {
+        fprintf(file, ",%s_ms", zoneName(static_cast<Zone>(z)));
+    }
+    fprintf(file, ",draw_calls,triangles,uniform_uploads\n");
+
+    size_t first = (head + FRAME_HISTORY - count) % FRAME_HISTORY;
+    for(size_t i = 0; i < count; i++) {
+        const FrameRecord& frame = frames[(first + i) % FRAME_HISTORY];
+        fprintf(file, "%zu,%.4f", i, frame.frameMs);
+        for(size_t z = 0; z < ZONE_COUNT; z++) {
+            fprintf(file, ",%.4f", frame.zoneMs[z]);
+        }
+        fprintf(file, ",%u,%u,%u\n", frame.drawCalls, frame.triangles, frame.uniformUploads);
+    }
+
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*
+** Per-frame scoped timers and counters. Frames are kept in a fixed
+** ring buffer so recording never allocates.
+*/
+class Profiler {
+    public:
+        enum class Zone {
+            SIMULATION,
+            CULLING,
+            UNIFORMS,
+            DRAW,
+            RAYCAST,
+            PRESET_IO,
+            PREVIEW,
+            TEXTURES,
+            COUNT
+        };
+
+        static constexpr size_t ZONE_COUNT = static_cast<size_t>(Zone::COUNT);
+        static constexpr size_t FRAME_HISTORY = 240;
+
+        struct FrameRecord {
+            float frameMs;
+            float zoneMs[ZONE_COUNT];
+            uint32_t drawCalls;
+            uint32_t triangles;
+            uint32_t uniformUploads;
+        };
+
+        /* Packed block handed to JS; every field is 4 bytes wide */
+        struct Stats {
+            float frameP50;
+            float frameP95;
+            float frameP99;
+            float frameAvg;
+            float zoneAvg[ZONE_COUNT];
+            uint32_t drawCalls;
+            uint32_t triangles;
+            uint32_t uniformUploads;
+            uint32_t frames;
+        };
+
+        class Scope {
+            private:
+                Zone zone;
+                double start;
+
+            public:
+                explicit Scope(Zone zone);
+                ~Scope();
+        };
+
+        static Profiler& get();
+        static const char* zoneName(Zone zone);
+
+        void beginFrame();
+        void addZoneTime(Zone zone, double ms);
+        void countDraw(uint32_t triangles) {
+            current.drawCalls++;
+            current.triangles += triangles;
+        }
+        void countUniforms(uint32_t count) {
+            current.uniformUploads += count;
+        }
+
+        const Stats& computeStats();
+        bool writeCsv(const char* path) const;
+        void reset();
+
+    private:
+        Profiler();
+
+        FrameRecord frames[FRAME_HISTORY];
+        FrameRecord current;
+        size_t head;
+        size_t count;
+        double frameStart;
+        Stats stats;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_ZONE(zone) \
+    Profiler::Scope PROFILE_CONCAT(profileScope_, __LINE__)(Profiler::Zone::zone)
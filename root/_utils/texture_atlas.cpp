@@ -0,0 +1,168 @@
+#include "texture_atlas.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+TextureAtlas::TextureAtlas(int size, int levels, int blockSize) :
+    size(size),
+    levels(levels),
+    unit(blockSize << (levels - 1)),
+    cells(size / unit),
+    usedCells(0)
+{
+    clear();
+}
+
+/*
+** Insert
+*/
+bool TextureAtlas::fits(int width, int height) const {
+    return width > 0 && height > 0 &&
+        width % unit == 0 && height % unit == 0 &&
+        width + 2 * unit <= size && height + 2 * unit <= size;
+}
+
+/*
+ * Lowest position over any skyline segment, narrowest segment on ties
+ */
+bool TextureAtlas::insert(int width, int height, Rect& out) {
+    if(!fits(width, height)) return false;
+    int w = width / unit + 2;
+    int h = height / unit + 2;
+
+    size_t best = skyline.size();
+    int bestY = INT_MAX;
+    int bestWidth = INT_MAX;
+    for(size_t i = 0; i < skyline.size(); i++) {
+        int y = fitAt(i, w, h);
+        if(y < 0) continue;
+        if(y < bestY || (y == bestY && skyline[i].width < bestWidth)) {
+            best = i;
+            bestY = y;
+            bestWidth = skyline[i].width;
+        }
+    }
+    if(best == skyline.size()) return false;
+
+    int x = skyline[best].x;
+    place(best, x, bestY, w, h);
+    usedCells += w * h;
+    out = { (x + 1) * unit, (bestY + 1) * unit, width, height };
+    return true;
+}
+
+void TextureAtlas::clear() {
+    skyline.assign(1, Segment{0, 0, cells});
+    usedCells = 0;
+}
+
+float TextureAtlas::occupancy() const {
+    return cells > 0 ? static_cast<float>(usedCells) / (cells * cells) : 0.0f;
+}
+
+/*
+ * Height a width x height box would rest at with its left edge on
+ * segment index, or -1 when it leaves the page
+ */
+int TextureAtlas::fitAt(size_t index, int width, int height) const {
+    if(skyline[index].x + width > cells) return -1;
+    int y = 0;
+    int left = width;
+    for(size_t i = index; left > 0; i++) {
+        y = std::max(y, skyline[i].y);
+        if(y + height > cells) return -1;
+        left -= skyline[i].width;
+    }
+    return y;
+}
+
+void TextureAtlas::place(size_t index, int x, int y, int width, int height) {
+    skyline.insert(skyline.begin() + index, Segment{x, y + height, width});
+
+    /* Segments now under the box shrink or go */
+    size_t i = index + 1;
+    while(i < skyline.size() && skyline[i].x < x + width) {
+        int covered = x + width - skyline[i].x;
+        if(covered < skyline[i].width) {
+            skyline[i].x += covered;
+            skyline[i].width -= covered;
+            break;
+        }
+        skyline.erase(skyline.begin() + i);
+    }
+
+    for(size_t j = 0; j + 1 < skyline.size();) {
+        if(skyline[j].y == skyline[j + 1].y) {
+            skyline[j].width += skyline[j + 1].width;
+            skyline.erase(skyline.begin() + j + 1);
+        } else {
+            j++;
+        }
+    }
+}
+
+/*
+** Pad
+**
+** Builds levels of the texture, each with gutter >> level texels on
+** every side copied from the opposite edge. Block formats are copied
+** as whole blocks and need every level they keep in the source; a
+** single RGBA level has the rest of its chain built here.
+*/
+bool TextureAtlas::pad(const TextureTranscoder::Texture& src, int gutter, int levels, TextureTranscoder::Texture& out) {
+    bool compressed = TextureTranscoder::isCompressed(src.format);
+    int blockSize = compressed ? 4 : 1;
+    size_t cellBytes = compressed ? TextureTranscoder::blockBytes(src.format) : 4;
+    int unit = blockSize << (levels - 1);
+    if(src.levels.empty() || src.width % unit != 0 || src.height % unit != 0 || gutter % unit != 0) {
+        std::cerr << "Texture does not fit the atlas grid: " << src.width << "x" << src.height << std::endl;
+        return false;
+    }
+
+    std::vector<const unsigned char*> sources(levels);
+    std::vector<ImageDecoder::Image> built;
+    if(src.levels.size() >= static_cast<size_t>(levels)) {
+        for(int l = 0; l < levels; l++) sources[l] = src.data.data() + src.levels[l].offset;
+    } else if(!compressed) {
+        built.resize(levels);
+        built[0].width = src.width;
+        built[0].height = src.height;
+        built[0].pixels.assign(src.data.begin(), src.data.begin() + src.levels[0].size);
+        for(int l = 1; l < levels; l++) TextureTranscoder::downsample(built[l - 1], built[l]);
+        for(int l = 0; l < levels; l++) sources[l] = built[l].pixels.data();
+    } else {
+        std::cerr << "Compressed texture has " << src.levels.size() << " of " << levels << " atlas levels" << std::endl;
+        return false;
+    }
+
+    out.format = src.format;
+    out.width = src.width + 2 * gutter;
+    out.height = src.height + 2 * gutter;
+    out.levels.clear();
+    size_t total = 0;
+    for(int l = 0; l < levels; l++) {
+        int w = out.width >> l;
+        int h = out.height >> l;
+        out.levels.push_back(TextureTranscoder::Level{w, h, total, TextureTranscoder::levelSize(src.format, w, h)});
+        total += out.levels.back().size;
+    }
+    out.data.resize(total);
+
+    for(int l = 0; l < levels; l++) {
+        int cols = (src.width >> l) / blockSize;
+        int rows = (src.height >> l) / blockSize;
+        int edge = (gutter >> l) / blockSize;
+        size_t rowBytes = cols * cellBytes;
+        size_t edgeBytes = edge * cellBytes;
+        unsigned char* dst = out.data.data() + out.levels[l].offset;
+        for(int y = 0; y < rows + 2 * edge; y++) {
+            const unsigned char* row = sources[l] + ((y - edge + rows) % rows) * rowBytes;
+            memcpy(dst, row + rowBytes - edgeBytes, edgeBytes);
+            memcpy(dst + edgeBytes, row, rowBytes);
+            memcpy(dst + edgeBytes + rowBytes, row, edgeBytes);
+            dst += rowBytes + 2 * edgeBytes;
+        }
+    }
+    return true;
+}
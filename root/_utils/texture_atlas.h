@@ -0,0 +1,59 @@
+#pragma once
+#include "texture_transcoder.h"
+#include <vector>
+
+/*
+** Packs textures into a square atlas page with a skyline bottom-left
+** packer. The page is split into cells of unit x unit texels, where
+** the unit is the format's block size times 2^(levels - 1); every
+** padded texture starts on a cell and covers whole cells, so each of
+** the page's mip levels samples only its own texture and block
+** formats stay block aligned.
+**
+** Each texture is surrounded by a gutter one unit wide on every side,
+** filled by pad() with texels from the opposite edge. Bilinear samples
+** at the border then match the GL_REPEAT of a standalone texture, at
+** every mip level the page keeps.
+*/
+class TextureAtlas {
+    public:
+        /* Content area in level 0 texels, gutter excluded */
+        struct Rect {
+            int x;
+            int y;
+            int width;
+            int height;
+        };
+
+        TextureAtlas(int size, int levels, int blockSize);
+
+        int getSize() const { return size; }
+        int getLevels() const { return levels; }
+        int getGutter() const { return unit; }
+
+        bool fits(int width, int height) const;
+        bool insert(int width, int height, Rect& out);
+        void clear();
+        /* Share of the page covered by padded textures */
+        float occupancy() const;
+
+        static bool pad(const TextureTranscoder::Texture& src, int gutter, int levels, TextureTranscoder::Texture& out);
+
+    private:
+        /* Top edge of the packed area over [x, x + width), in cells */
+        struct Segment {
+            int x;
+            int y;
+            int width;
+        };
+
+        int size;
+        int levels;
+        int unit;
+        int cells;
+        int usedCells;
+        std::vector<Segment> skyline;
+
+        int fitAt(size_t index, int width, int height) const;
+        void place(size_t index, int x, int y, int width, int height);
+};
@@ -0,0 +1,184 @@
+#include "texture_decode_queue.h"
+#include "ktx2_reader.h"
+#include <utility>
+
+TextureDecodeQueue::TextureDecodeQueue() :
+    running(0),
+    stopping(false)
+{
+#if TEXTURE_DECODE_THREADED
+    worker = std::thread(&TextureDecodeQueue::run, this);
+#endif
+}
+
+TextureDecodeQueue::~TextureDecodeQueue() {
+#if TEXTURE_DECODE_THREADED
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+#endif
+}
+
+/*
+ * FNV-1a over the pixels and dimensions
+ */
+uint64_t TextureDecodeQueue::hashPixels(const unsigned char* data, size_t size, int width, int height) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](unsigned char c) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    };
+    for(size_t i = 0; i < size; i++) mix(data[i]);
+    for(int i = 0; i < 4; i++) mix(static_cast<unsigned char>(width >> (i * 8)));
+    for(int i = 0; i < 4; i++) mix(static_cast<unsigned char>(height >> (i * 8)));
+    return hash;
+}
+
+/*
+** Submit
+*/
+void TextureDecodeQueue::submit(Job job) {
+#if TEXTURE_DECODE_THREADED
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    wake.notify_one();
+#else
+    Result result;
+    result.texture.data = takeBuffer();
+    process(job, result);
+    results.push_back(std::move(result));
+#endif
+}
+
+/*
+** Poll
+*/
+bool TextureDecodeQueue::poll(Result& result) {
+#if TEXTURE_DECODE_THREADED
+    std::lock_guard<std::mutex> lock(mutex);
+#endif
+    if(results.empty()) return false;
+    result = std::move(results.front());
+    results.pop_front();
+    return true;
+}
+
+void TextureDecodeQueue::recycle(Result& result) {
+#if TEXTURE_DECODE_THREADED
+    std::lock_guard<std::mutex> lock(mutex);
+#endif
+    if(pool.size() < MAX_POOLED && result.texture.data.capacity() > 0) {
+        pool.push_back(std::move(result.texture.data));
+    }
+    result.texture.data = std::vector<unsigned char>();
+    result.texture.levels.clear();
+}
+
+bool TextureDecodeQueue::idle() {
+#if TEXTURE_DECODE_THREADED
+    std::lock_guard<std::mutex> lock(mutex);
+#endif
+    return jobs.empty() && results.empty() && running == 0;
+}
+
+/*
+ * Called with the lock held
+ */
+std::vector<unsigned char> TextureDecodeQueue::takeBuffer() {
+    if(pool.empty()) return std::vector<unsigned char>();
+    std::vector<unsigned char> buffer = std::move(pool.back());
+    pool.pop_back();
+    buffer.clear();
+    return buffer;
+}
+
+/*
+** Worker
+*/
+#if TEXTURE_DECODE_THREADED
+void TextureDecodeQueue::run() {
+    for(;;) {
+        Job job;
+        Result result;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if(stopping) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            result.texture.data = takeBuffer();
+            running++;
+        }
+
+        process(job, result);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            results.push_back(std::move(result));
+            running--;
+        }
+    }
+}
+#endif
+
+/*
+ * Files in a known format are decoded; anything else is taken as raw
+ * RGBA when its size matches the dimensions given with the job
+ */
+void TextureDecodeQueue::process(Job& job, Result& result) {
+    result.handle = job.handle;
+    result.hash = 0;
+
+    const unsigned char* data = job.encoded.data();
+    size_t size = job.encoded.size();
+    TextureTranscoder::Texture& texture = result.texture;
+    if(Ktx2Reader::isKtx2(data, size)) {
+        result.ok = Ktx2Reader::read(data, size, texture);
+        if(result.ok && !TextureTranscoder::canSample(texture.format, job.support)) {
+            const TextureTranscoder::Level& level = texture.levels[0];
+            result.ok = TextureTranscoder::decode(
+                texture.data.data() + level.offset, level.size,
+                texture.format, level.width, level.height, scratch
+            ) && transcode(job.support, texture);
+        }
+    } else {
+        size_t rawSize = job.width > 0 && job.height > 0 ?
+            static_cast<size_t>(job.width) * job.height * 4 : 0;
+        if(ImageDecoder::detect(data, size) == ImageDecoder::Format::UNKNOWN && size == rawSize) {
+            scratch.pixels.swap(job.encoded);
+            scratch.width = job.width;
+            scratch.height = job.height;
+            result.ok = true;
+        } else {
+            result.ok = ImageDecoder::decode(data, size, scratch);
+        }
+        result.ok = result.ok && transcode(job.support, texture);
+    }
+
+    if(result.ok) {
+        result.hash = hashPixels(texture.data.data(), texture.data.size(), texture.width, texture.height);
+    }
+}
+
+/*
+ * Scratch pixels into the best format the context samples. Plain
+ * RGBA keeps a single level and GL builds the mips; block formats
+ * cannot be mipmapped by GL, so the chain is encoded here
+ */
+bool TextureDecodeQueue::transcode(uint32_t support, TextureTranscoder::Texture& texture) {
+    TextureTranscoder::Format format = TextureTranscoder::chooseFormat(support, TextureTranscoder::isOpaque(scratch));
+    if(TextureTranscoder::isCompressed(format)) {
+        return TextureTranscoder::encode(scratch, format, true, texture);
+    }
+    texture.format = format;
+    texture.width = scratch.width;
+    texture.height = scratch.height;
+    texture.data.swap(scratch.pixels);
+    texture.levels.assign(1, TextureTranscoder::Level{scratch.width, scratch.height, 0, texture.data.size()});
+    return true;
+}
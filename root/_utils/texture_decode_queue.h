@@ -0,0 +1,83 @@
+#pragma once
+#include "image_decoder.h"
+#include "texture_registry.h"
+#include "texture_transcoder.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    #define TEXTURE_DECODE_THREADED 0
+#else
+    #define TEXTURE_DECODE_THREADED 1
+    #include <condition_variable>
+    #include <mutex>
+    #include <thread>
+#endif
+
+/*
+** Turns encoded texture files into GPU-ready textures on a worker
+** thread. PNG, JPEG and raw RGBA are decoded and, when the job allows a
+** compressed format family, transcoded to it with a mip chain. KTX2
+** files pass through when the context samples their format, and are
+** decoded and transcoded like any other image when it does not. The
+** render thread submits jobs and polls for finished textures; it only
+** has to do the GL upload. Buffers of finished textures are handed
+** back with recycle() and reused for later decodes.
+**
+** Browser builds without -pthread decode inside submit().
+*/
+class TextureDecodeQueue {
+    public:
+        struct Job {
+            TextureRegistry::Handle handle;
+            std::vector<unsigned char> encoded;
+            /* Size of a raw RGBA payload, used when the format is unknown */
+            int width;
+            int height;
+            /* TextureTranscoder::SUPPORT_* families the context can sample */
+            uint32_t support;
+        };
+
+        struct Result {
+            TextureRegistry::Handle handle;
+            bool ok;
+            /* Hash of the texture data and size, for sharing identical images */
+            uint64_t hash;
+            TextureTranscoder::Texture texture;
+        };
+
+        TextureDecodeQueue();
+        ~TextureDecodeQueue();
+        TextureDecodeQueue(const TextureDecodeQueue&) = delete;
+        TextureDecodeQueue& operator=(const TextureDecodeQueue&) = delete;
+
+        void submit(Job job);
+        bool poll(Result& result);
+        void recycle(Result& result);
+        bool idle();
+
+        static uint64_t hashPixels(const unsigned char* data, size_t size, int width, int height);
+
+    private:
+        static constexpr size_t MAX_POOLED = 4;
+
+        std::deque<Job> jobs;
+        std::deque<Result> results;
+        std::vector<std::vector<unsigned char>> pool;
+        size_t running;
+        bool stopping;
+        /* Decoded pixels ahead of transcoding; only touched by process() */
+        ImageDecoder::Image scratch;
+
+#if TEXTURE_DECODE_THREADED
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::thread worker;
+
+        void run();
+#endif
+        void process(Job& job, Result& result);
+        bool transcode(uint32_t support, TextureTranscoder::Texture& texture);
+        std::vector<unsigned char> takeBuffer();
+};
@@ -1,43 +1,441 @@
 #include "texture_loader.h"
 #include "base64_decoder.h"
+#include "profiler.h"
+#include "../_platform/platform.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <vector>
+#include <unordered_set>
+#ifdef __EMSCRIPTEN__
+    #include <emscripten/html5.h>
+#endif
 
-TextureLoader::TextureLoader() {};
+/* Extension formats, absent from the core GLES3 header */
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+    #define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+    #define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+    #define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+
+namespace {
+    GLenum internalFormat(TextureTranscoder::Format format) {
+        switch(format) {
+            case TextureTranscoder::Format::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case TextureTranscoder::Format::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case TextureTranscoder::Format::ETC2_RGB8: return GL_COMPRESSED_RGB8_ETC2;
+            case TextureTranscoder::Format::ETC2_RGBA8: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+            case TextureTranscoder::Format::ASTC_4X4: return GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+            case TextureTranscoder::Format::RGBA8: break;
+        }
+        return GL_RGBA8;
+    }
+
+    /* A lone RGBA level gets its mip chain from glGenerateMipmap */
+    bool buildsMipmaps(const TextureTranscoder::Texture& texture) {
+        return !TextureTranscoder::isCompressed(texture.format) && texture.levels.size() == 1;
+    }
+
+    GLsizei fullChain(int width, int height) {
+        GLsizei levels = 1;
+        for(int size = std::max(width, height); size > 1; size >>= 1) levels++;
+        return levels;
+    }
+
+    constexpr TextureLoader::UvRect FULL_RECT = { 0.0f, 0.0f, 1.0f, 1.0f };
+}
+
+TextureLoader::TextureLoader() :
+    formatSupport(0),
+    formatsDetected(false),
+    uploadBudget(DEFAULT_UPLOAD_BUDGET),
+    uploadStats{},
+    uploadHandle(TextureRegistry::NONE),
+    uploadWidth(0),
+    uploadHeight(0)
+{};
 TextureLoader::~TextureLoader() {
-    for(auto& p : textures) {
-        glDeleteTextures(1, &p.second);
+    /* Handles can alias one GL texture; delete each id once */
+    std::unordered_set<GLuint> ids;
+    for(auto& p : textures) ids.insert(p.second.texId);
+    for(auto& p : contents) ids.insert(p.second.texId);
+    for(auto& page : pages) ids.insert(page.texId);
+    for(auto& upload : uploads) {
+        if(upload.texId != 0) ids.insert(upload.texId);
+    }
+    for(GLuint id : ids) {
+        glDeleteTextures(1, &id);
     }
     textures.clear();
+    contents.clear();
+    pages.clear();
 };
 
-GLuint TextureLoader::loadTexture(
-    const std::string& name,
-    const std::string& data,
+/*
+ * Load Texture
+ */
+bool TextureLoader::loadTexture(
+    std::string_view name,
+    std::string_view data,
     int width,
     int height
 ) {
     try {
-        std::vector<unsigned char> imgData = Base64Decoder::decode(data);
-        if(imgData.empty()) {
+        std::vector<unsigned char> encoded = Base64Decoder::decode(data);
+        if(encoded.empty()) {
             std::cerr << "Failed to decode base64 image data!" << name << std::endl;
-            return 0;
-        }
-    
-        GLuint texId = loadTextureFromMemory(imgData.data(), width, height);
-        if(texId != 0) {
-            textures[name] = texId;
-            std::cout << "Texture loaded successfully: " 
-                << name << " (" 
-                << width << "x" << height << ")" 
-                << std::endl;
+            return false;
         }
-    
-        return texId;
+        TextureRegistry::Handle handle = TextureRegistry::get().intern(name);
+        decoding.insert(handle);
+        decodeQueue.submit({ handle, std::move(encoded), width, height, supportedFormats() });
+        return true;
     } catch(const std::exception& err) {
         std::cerr << "Error loading texture from base64: " << err.what() << std::endl;
-        return 0;
+        return false;
+    }
+}
+
+/*
+ * Chunked Upload
+ */
+void TextureLoader::beginUpload(std::string_view name, int width, int height) {
+    uploadHandle = TextureRegistry::get().intern(name);
+    uploadWidth = width;
+    uploadHeight = height;
+    uploadData.clear();
+    uploadStream.reset();
+}
+
+bool TextureLoader::appendUpload(std::string_view chunk) {
+    if(uploadHandle == TextureRegistry::NONE) return false;
+    if(!uploadStream.write(chunk, uploadData)) {
+        std::cerr << "Invalid base64 in texture upload: " 
+            << TextureRegistry::get().source(uploadHandle) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool TextureLoader::finishUpload() {
+    TextureRegistry::Handle handle = uploadHandle;
+    uploadHandle = TextureRegistry::NONE;
+    if(handle == TextureRegistry::NONE) return false;
+
+    if(!uploadStream.finish(uploadData) || uploadData.empty()) {
+        std::cerr << "Failed to decode base64 image data!" 
+            << TextureRegistry::get().source(handle) << std::endl;
+        std::vector<unsigned char>().swap(uploadData);
+        return false;
+    }
+    /* The queue takes the buffer; nothing of the upload stays here */
+    decoding.insert(handle);
+    decodeQueue.submit({ handle, std::move(uploadData), uploadWidth, uploadHeight, supportedFormats() });
+    uploadData = std::vector<unsigned char>();
+    return true;
+}
+
+/*
+ * Compressed Formats
+ *
+ * WebGL hides compressed formats until their extension is enabled, and
+ * enabling needs a current context, so this runs on first use
+ */
+uint32_t TextureLoader::supportedFormats() {
+    if(formatsDetected) return formatSupport;
+    formatsDetected = true;
+#ifdef __EMSCRIPTEN__
+    EMSCRIPTEN_WEBGL_CONTEXT_HANDLE context = emscripten_webgl_get_current_context();
+    if(context) {
+        if(emscripten_webgl_enable_extension(context, "WEBGL_compressed_texture_s3tc")) {
+            formatSupport |= TextureTranscoder::SUPPORT_BC;
+        }
+        if(emscripten_webgl_enable_extension(context, "WEBGL_compressed_texture_etc")) {
+            formatSupport |= TextureTranscoder::SUPPORT_ETC2;
+        }
+        if(emscripten_webgl_enable_extension(context, "WEBGL_compressed_texture_astc")) {
+            formatSupport |= TextureTranscoder::SUPPORT_ASTC;
+        }
+    }
+#else
+    /* ETC2 is core in GLES 3.0; the others are still extensions */
+    formatSupport |= TextureTranscoder::SUPPORT_ETC2;
+    const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    if(extensions && strstr(extensions, "GL_EXT_texture_compression_s3tc")) {
+        formatSupport |= TextureTranscoder::SUPPORT_BC;
+    }
+    if(extensions && strstr(extensions, "GL_KHR_texture_compression_astc_ldr")) {
+        formatSupport |= TextureTranscoder::SUPPORT_ASTC;
+    }
+#endif
+    return formatSupport;
+}
+
+/*
+ * Update
+ *
+ * Runs on the render thread once per frame. Images the decode worker
+ * has finished join the upload queue, then the queue is drained in
+ * order until the frame's byte budget is spent. At least one row is
+ * uploaded per frame so a tiny budget still makes progress.
+ */
+void TextureLoader::update() {
+    PROFILE_ZONE(TEXTURES);
+    double start = Platform::now();
+
+    TextureDecodeQueue::Result result;
+    while(decodeQueue.poll(result)) {
+        auto job = decoding.find(result.handle);
+        if(job != decoding.end()) decoding.erase(job);
+        if(result.ok) {
+            queueUpload(result);
+        } else {
+            std::cerr << "Failed to decode texture image: " 
+                << TextureRegistry::get().source(result.handle) << std::endl;
+            decodeQueue.recycle(result);
+        }
+    }
+
+    size_t spent = 0;
+    while(!uploads.empty() && (uploadBudget == 0 || spent < uploadBudget)) {
+        Upload& upload = uploads.front();
+        spent += uploadRows(upload, uploadBudget == 0 ? SIZE_MAX : uploadBudget - spent);
+        if(upload.level < upload.result.texture.levels.size()) continue;
+        completeUpload(upload);
+        uploads.pop_front();
+    }
+
+    uploadStats.uploadedBytes = static_cast<uint32_t>(spent);
+    uploadStats.uploadMs = static_cast<float>(Platform::now() - start);
+}
+
+/*
+ * Images whose pixels match a resident or queued texture are not
+ * uploaded again
+ */
+void TextureLoader::queueUpload(TextureDecodeQueue::Result& result) {
+    const std::string& name = TextureRegistry::get().source(result.handle);
+    auto shared = contents.find(result.hash);
+    if(shared != contents.end()) {
+        textures[result.handle] = shared->second;
+        std::cout << "Texture shared: " << name << std::endl;
+        decodeQueue.recycle(result);
+        return;
+    }
+    for(auto& upload : uploads) {
+        if(upload.result.hash == result.hash) {
+            upload.aliases.push_back(result.handle);
+            decodeQueue.recycle(result);
+            return;
+        }
+    }
+
+    Upload upload;
+    upload.result = std::move(result);
+    upload.texId = 0;
+    upload.atlased = false;
+    upload.x = 0;
+    upload.y = 0;
+    upload.rect = FULL_RECT;
+    upload.level = 0;
+    upload.row = 0;
+    placeInAtlas(upload);
+    uploads.push_back(std::move(upload));
+}
+
+/*
+ * Swaps the upload's texture for its padded copy and reserves room on
+ * a page of its format, opening a page when all are full. Textures off
+ * the atlas grid or larger than a page stay standalone
+ */
+bool TextureLoader::placeInAtlas(Upload& upload) {
+    TextureTranscoder::Texture& texture = upload.result.texture;
+    int blockSize = TextureTranscoder::isCompressed(texture.format) ? 4 : 1;
+    TextureAtlas grid(ATLAS_PAGE_SIZE, ATLAS_LEVELS, blockSize);
+    if(!grid.fits(texture.width, texture.height)) return false;
+
+    TextureTranscoder::Texture padded;
+    if(!TextureAtlas::pad(texture, grid.getGutter(), ATLAS_LEVELS, padded)) return false;
+
+    TextureAtlas::Rect rect;
+    AtlasPage* target = nullptr;
+    for(auto& page : pages) {
+        if(page.format == texture.format && page.atlas.insert(texture.width, texture.height, rect)) {
+            target = &page;
+            break;
+        }
+    }
+    if(!target) {
+        AtlasPage page{ texture.format, 0, grid };
+        glGenTextures(1, &page.texId);
+        glBindTexture(GL_TEXTURE_2D, page.texId);
+        glTexStorage2D(GL_TEXTURE_2D, ATLAS_LEVELS, internalFormat(texture.format), ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        /* Gutters are padded at every level, so minified pages sample them too */
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        size_t bytes = 0;
+        for(int l = 0; l < ATLAS_LEVELS; l++) {
+            bytes += TextureTranscoder::levelSize(texture.format, ATLAS_PAGE_SIZE >> l, ATLAS_PAGE_SIZE >> l);
+        }
+        residentBytes[page.texId] = bytes;
+        pages.push_back(std::move(page));
+        target = &pages.back();
+        target->atlas.insert(texture.width, texture.height, rect);
+    }
+
+    float scale = 1.0f / ATLAS_PAGE_SIZE;
+    upload.texId = target->texId;
+    upload.atlased = true;
+    upload.x = rect.x - grid.getGutter();
+    upload.y = rect.y - grid.getGutter();
+    upload.rect = { rect.x * scale, rect.y * scale, rect.width * scale, rect.height * scale };
+    texture = std::move(padded);
+    return true;
+}
+
+/*
+ * Allocates immutable storage for every mip level on the first call,
+ * unless the texture has a place on an atlas page,
+ * then fills the levels in order a strip at a time. Block formats go
+ * in strips of whole block rows
+ */
+size_t TextureLoader::uploadRows(Upload& upload, size_t budget) {
+    const TextureTranscoder::Texture& texture = upload.result.texture;
+    GLenum format = internalFormat(texture.format);
+    bool compressed = TextureTranscoder::isCompressed(texture.format);
+    if(upload.texId == 0) {
+        GLsizei levels = buildsMipmaps(texture) ?
+            fullChain(texture.width, texture.height) :
+            static_cast<GLsizei>(texture.levels.size());
+
+        glGenTextures(1, &upload.texId);
+        glBindTexture(GL_TEXTURE_2D, upload.texId);
+        glTexStorage2D(GL_TEXTURE_2D, levels, format, texture.width, texture.height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, upload.texId);
+    }
+
+    const TextureTranscoder::Level& level = texture.levels[upload.level];
+    GLint mip = static_cast<GLint>(upload.level);
+    GLint x = upload.x >> mip;
+    GLint y = (upload.y >> mip) + upload.row;
+    int step = compressed ? 4 : 1;
+    size_t stripBytes = TextureTranscoder::levelSize(texture.format, level.width, step);
+    size_t left = static_cast<size_t>(level.height - upload.row + step - 1) / step;
+    size_t strips = std::min(left, std::max<size_t>(1, budget / stripBytes));
+    int rows = std::min(level.height - upload.row, static_cast<int>(strips) * step);
+    const unsigned char* src = texture.data.data() + level.offset + upload.row / step * stripBytes;
+    if(compressed) {
+        glCompressedTexSubImage2D(
+            GL_TEXTURE_2D, mip,
+            x, y,
+            level.width, rows,
+            format, static_cast<GLsizei>(strips * stripBytes),
+            src
+        );
+    } else {
+        glTexSubImage2D(
+            GL_TEXTURE_2D, mip,
+            x, y,
+            level.width, rows,
+            GL_RGBA, GL_UNSIGNED_BYTE,
+            src
+        );
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    upload.row += rows;
+    if(upload.row >= level.height) {
+        upload.level++;
+        upload.row = 0;
+    }
+    return strips * stripBytes;
+}
+
+/*
+ * Atlas pages are counted once, when they are opened
+ */
+void TextureLoader::completeUpload(Upload& upload) {
+    const TextureTranscoder::Texture& texture = upload.result.texture;
+    size_t bytes = 0;
+    if(upload.atlased) {
+        bytes = texture.data.size();
+    } else if(buildsMipmaps(texture)) {
+        glBindTexture(GL_TEXTURE_2D, upload.texId);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        for(int w = texture.width, h = texture.height;; w = std::max(1, w / 2), h = std::max(1, h / 2)) {
+            bytes += TextureTranscoder::levelSize(texture.format, w, h);
+            if(w == 1 && h == 1) break;
+        }
+    } else {
+        bytes = texture.data.size();
+    }
+
+    Resident resident{ upload.texId, upload.rect };
+    textures[upload.result.handle] = resident;
+    for(TextureRegistry::Handle alias : upload.aliases) {
+        textures[alias] = resident;
     }
+    contents[upload.result.hash] = resident;
+    if(!upload.atlased) residentBytes[upload.texId] = bytes;
+    std::cout << "Texture loaded successfully: " 
+        << TextureRegistry::get().source(upload.result.handle) << " (" 
+        << texture.width << "x" << texture.height << " "
+        << TextureTranscoder::name(texture.format) << ", " << (bytes >> 10) << " KB"
+        << (upload.atlased ? ", atlas" : "") << ")"
+        << std::endl;
+    decodeQueue.recycle(upload.result);
+}
+
+/*
+ * Upload Budget
+ */
+void TextureLoader::setUploadBudget(size_t bytes) {
+    uploadBudget = bytes;
+}
+
+const TextureLoader::UploadStats& TextureLoader::getUploadStats() {
+    size_t pendingBytes = 0;
+    for(const auto& upload : uploads) {
+        const TextureTranscoder::Texture& texture = upload.result.texture;
+        for(size_t l = upload.level; l < texture.levels.size(); l++) {
+            pendingBytes += texture.levels[l].size;
+        }
+        if(upload.level < texture.levels.size()) {
+            const TextureTranscoder::Level& level = texture.levels[upload.level];
+            pendingBytes -= TextureTranscoder::levelSize(texture.format, level.width, upload.row);
+        }
+    }
+    size_t resident = 0;
+    for(const auto& p : residentBytes) resident += p.second;
+    uploadStats.budgetBytes = static_cast<uint32_t>(uploadBudget);
+    uploadStats.pendingTextures = static_cast<uint32_t>(uploads.size());
+    uploadStats.pendingBytes = static_cast<uint32_t>(pendingBytes);
+    uploadStats.residentTextures = static_cast<uint32_t>(contents.size());
+    uploadStats.residentBytes = static_cast<uint32_t>(resident);
+    uploadStats.formats = formatSupport;
+    uploadStats.atlasPages = static_cast<uint32_t>(pages.size());
+    uploadStats.atlasTextures = 0;
+    for(const auto& p : contents) {
+        for(const auto& page : pages) {
+            if(p.second.texId == page.texId) uploadStats.atlasTextures++;
+        }
+    }
+    return uploadStats;
 }
 
 /*
@@ -69,28 +467,76 @@ GLuint TextureLoader::loadTextureFromMemory(
  */
 void TextureLoader::unloadTexture(GLuint texId) {
     glDeleteTextures(1, &texId);
+    residentBytes.erase(texId);
+    for(auto it = textures.begin(); it != textures.end();) {
+        it = it->second.texId == texId ? textures.erase(it) : std::next(it);
+    }
+    for(auto it = contents.begin(); it != contents.end();) {
+        it = it->second.texId == texId ? contents.erase(it) : std::next(it);
+    }
+    for(auto it = pages.begin(); it != pages.end();) {
+        it = it->texId == texId ? pages.erase(it) : std::next(it);
+    }
+}
+
+/*
+ * Release
+ */
+void TextureLoader::collectPending(std::unordered_set<TextureRegistry::Handle>& live) const {
+    live.insert(decoding.begin(), decoding.end());
+    for(const auto& upload : uploads) {
+        live.insert(upload.result.handle);
+        live.insert(upload.aliases.begin(), upload.aliases.end());
+    }
+    if(uploadHandle != TextureRegistry::NONE) live.insert(uploadHandle);
+}
+
+/*
+ * Standalone textures no remaining handle uses are deleted. Atlas
+ * slots stay reserved, as the packer cannot free space, and keep their
+ * content entry so the same image comes back to its slot
+ */
+void TextureLoader::release(const std::vector<TextureRegistry::Handle>& handles) {
+    std::unordered_set<GLuint> dropped;
+    for(TextureRegistry::Handle handle : handles) {
+        auto it = textures.find(handle);
+        if(it == textures.end()) continue;
+        dropped.insert(it->second.texId);
+        textures.erase(it);
+    }
+    for(const auto& p : textures) dropped.erase(p.second.texId);
+    for(const auto& page : pages) dropped.erase(page.texId);
+    for(GLuint texId : dropped) unloadTexture(texId);
 }
 
 /*
  * Texture Exists
  */
-bool TextureLoader::texExists(const std::string& texName) const {
-    return textures.find(texName) != textures.end();
+bool TextureLoader::texExists(TextureRegistry::Handle handle) const {
+    return textures.find(handle) != textures.end();
 }
 
 /*
  * Get Texture
  */
-GLuint TextureLoader::getTex(const std::string& texName) const {
-    auto it = textures.find(texName);
-    return it != textures.end() ? it->second : 0;
+GLuint TextureLoader::getTex(TextureRegistry::Handle handle) const {
+    auto it = textures.find(handle);
+    return it != textures.end() ? it->second.texId : 0;
+}
+
+/*
+ * Get Texture Rect
+ */
+TextureLoader::UvRect TextureLoader::getTexRect(TextureRegistry::Handle handle) const {
+    auto it = textures.find(handle);
+    return it != textures.end() ? it->second.rect : FULL_RECT;
 }
 
 /*
  * Add Texture
  */
-void TextureLoader::addTex(const std::string& name, GLuint texId) {
-    textures[name] = texId;
+void TextureLoader::addTex(TextureRegistry::Handle handle, GLuint texId) {
+    textures[handle] = Resident{ texId, FULL_RECT };
 }
 
 
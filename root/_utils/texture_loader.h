@@ -1,25 +1,149 @@
 #pragma once
+#include "texture_registry.h"
+#include "base64_decoder.h"
+#include "texture_decode_queue.h"
+#include "texture_atlas.h"
 #include <string>
+#include <cstdint>
+#include <deque>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <GLES3/gl3.h>
 
+/*
+** GL textures by registry handle. Uploads are also keyed by a hash of
+** the decoded pixels, so identical images under different names share
+** one GL texture.
+**
+** Uploads take a base64 PNG, JPEG, KTX2 or raw RGBA payload, whole or
+** in chunks (beginUpload, appendUpload, finishUpload). The image
+** itself is decoded on the decode queue's worker and transcoded to a
+** block format when the context exposes S3TC or ETC2, otherwise it
+** stays RGBA. update() runs once per frame and uploads finished
+** images in row strips, at most the upload budget in bytes per frame;
+** a texture is only visible to getTex() once all of it is resident,
+** until then planets draw their flat color.
+**
+** Textures whose sides are multiples of the atlas grid are packed into
+** shared atlas pages, one set of pages per format, so planets with
+** different textures can still be drawn in one batch. getTex() then
+** returns the page and getTexRect() the texture's area in it; for
+** standalone textures the rect is the whole texture.
+*/
 class TextureLoader {
+    public:
+        /* Packed block handed to JS; every field is 4 bytes wide */
+        struct UploadStats {
+            uint32_t budgetBytes;
+            uint32_t uploadedBytes;
+            uint32_t pendingTextures;
+            uint32_t pendingBytes;
+            uint32_t residentTextures;
+            float uploadMs;
+            /* GPU memory of resident textures, mip levels included */
+            uint32_t residentBytes;
+            /* TextureTranscoder::SUPPORT_* bits of the context */
+            uint32_t formats;
+            uint32_t atlasPages;
+            uint32_t atlasTextures;
+        };
+
+        /* Area of a texture inside its GL texture, in texture coordinates */
+        struct UvRect {
+            float u;
+            float v;
+            float width;
+            float height;
+        };
+
+        static constexpr size_t DEFAULT_UPLOAD_BUDGET = 4 << 20;
+        /* Page side every WebGL2 context supports, and the mip levels pages keep */
+        static constexpr int ATLAS_PAGE_SIZE = 2048;
+        static constexpr int ATLAS_LEVELS = 4;
+
     private:
-        std::unordered_map<std::string, GLuint> textures;
+        struct Resident {
+            GLuint texId;
+            UvRect rect;
+        };
+
+        struct AtlasPage {
+            TextureTranscoder::Format format;
+            GLuint texId;
+            TextureAtlas atlas;
+        };
+
+        /*
+         * A decoded image part way through its upload, into its own
+         * texture or at (x, y) of an atlas page
+         */
+        struct Upload {
+            TextureDecodeQueue::Result result;
+            std::vector<TextureRegistry::Handle> aliases;
+            GLuint texId;
+            bool atlased;
+            int x;
+            int y;
+            UvRect rect;
+            size_t level;
+            int row;
+        };
+
+        std::unordered_map<TextureRegistry::Handle, Resident> textures;
+        std::unordered_map<uint64_t, Resident> contents;
+        std::vector<AtlasPage> pages;
+        std::unordered_map<GLuint, size_t> residentBytes;
+        uint32_t formatSupport;
+        bool formatsDetected;
+
+        TextureDecodeQueue decodeQueue;
+        /* Handles submitted to the decode queue and not yet polled */
+        std::unordered_multiset<TextureRegistry::Handle> decoding;
+        std::deque<Upload> uploads;
+        size_t uploadBudget;
+        UploadStats uploadStats;
+
+        TextureRegistry::Handle uploadHandle;
+        int uploadWidth;
+        int uploadHeight;
+        std::vector<unsigned char> uploadData;
+        Base64Decoder::Stream uploadStream;
+
+        uint32_t supportedFormats();
+        void queueUpload(TextureDecodeQueue::Result& result);
+        bool placeInAtlas(Upload& upload);
+        size_t uploadRows(Upload& upload, size_t budget);
+        void completeUpload(Upload& upload);
 
     public:
         TextureLoader();
         ~TextureLoader();
 
-        GLuint loadTexture(
-            const std::string& name,
-            const std::string& data,
+        bool loadTexture(
+            std::string_view name,
+            std::string_view data,
             int width,
             int height
         );
+        void beginUpload(std::string_view name, int width, int height);
+        bool appendUpload(std::string_view chunk);
+        bool finishUpload();
+        void update();
+
+        /* Bytes uploaded per frame, 0 for no limit */
+        void setUploadBudget(size_t bytes);
+        size_t getUploadBudget() const { return uploadBudget; }
+        const UploadStats& getUploadStats();
         GLuint loadTextureFromMemory(const unsigned char* data, int width, int height);
         void unloadTexture(GLuint texId);
-        bool texExists(const std::string& texName) const;
-        GLuint getTex(const std::string& texName) const;
-        void addTex(const std::string& name, GLuint texId);
+        bool texExists(TextureRegistry::Handle handle) const;
+        GLuint getTex(TextureRegistry::Handle handle) const;
+        UvRect getTexRect(TextureRegistry::Handle handle) const;
+        void addTex(TextureRegistry::Handle handle, GLuint texId);
+
+        /* Handles still being decoded or uploaded */
+        void collectPending(std::unordered_set<TextureRegistry::Handle>& live) const;
+        void release(const std::vector<TextureRegistry::Handle>& handles);
 };
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "texture_registry.h"
+
+TextureRegistry::TextureRegistry() :
+    totalBytes(0)
+{}
+
+TextureRegistry& TextureRegistry::get() {
+    static TextureRegistry registry;
+    return registry;
+}
+
+/*
+** Intern
+*/
+TextureRegistry::Handle TextureRegistry::intern(std::string_view source) {
+    if(source.empty()) return NONE;
+
+    auto it = index.find(source);
+    if(it != index.end()) return it->second;
+
+    sources.emplace_back(source);
+    Handle handle = static_cast<Handle>(sources.size());
+    index.emplace(std::string_view(sources.back()), handle);
+    totalBytes += source.size();
+    return handle;
+}
+
+TextureRegistry::Handle TextureRegistry::find(std::string_view source) const {
+    auto it = index.find(source);
+    return it != index.end() ? it->second : NONE;
+}
+
+/*
+** Sweep
+*/
+std::vector<TextureRegistry::Handle> TextureRegistry::sweep(const std::unordered_set<Handle>& live) {
+    std::vector<Handle> freed;
+    for(size_t i = 0; i < sources.size(); i++) {
+        Handle handle = static_cast<Handle>(i + 1);
+        std::string& source = sources[i];
+        if(source.empty() || live.count(handle)) continue;
+
+        /* The index key views into the string, so it goes first */
+        index.erase(std::string_view(source));
+        totalBytes -= source.size();
+        std::string().swap(source);
+        freed.push_back(handle);
+    }
+    return freed;
+}
+
+const std::string& TextureRegistry::source(Handle handle) const {
+    static const std::string empty;
+    if(handle == NONE || handle > sources.size()) return empty;
+    return sources[handle - 1];
+}
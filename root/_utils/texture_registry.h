@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/*
+** Interns texture sources (a texture key or a full data URL) by
+** content. Planets carry the returned handle instead of the string,
+** so copying a PlanetData never copies texture bytes and planets that
+** use the same texture share one entry. Handle 0 means no texture.
+**
+** Entries stay until sweep() is given a live set without them. Handles
+** are never reused: a swept handle reads as an empty source, and
+** interning the same source again gives a new handle.
+*/
+class TextureRegistry {
+    public:
+        using Handle = uint32_t;
+        static constexpr Handle NONE = 0;
+
+        static TextureRegistry& get();
+
+        Handle intern(std::string_view source);
+        Handle find(std::string_view source) const;
+        const std::string& source(Handle handle) const;
+        /* Frees every entry not in live and returns the freed handles */
+        std::vector<Handle> sweep(const std::unordered_set<Handle>& live);
+
+        size_t size() const { return index.size(); }
+        size_t bytes() const { return totalBytes; }
+
+    private:
+        /* deque keeps element addresses stable, the index keys view into it */
+        std::deque<std::string> sources;
+        std::unordered_map<std::string_view, Handle> index;
+        size_t totalBytes;
+
+        TextureRegistry();
+};
@@ -0,0 +1,796 @@
+#include "texture_transcoder.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    /* ETC1/ETC2 intensity modifiers, {small, large} per table */
+    constexpr int ETC_MODIFIERS[8][2] = {
+        {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}
+    };
+
+    /* ETC2 T and H mode paint distances */
+    constexpr int ETC_DISTANCES[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+    constexpr int EAC_MODIFIERS[16][8] = {
+        {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9}, {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9}, {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9}, {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8}, {-3, -5, -7, -9, 2, 4, 6, 8}
+    };
+
+    /* Table 13 holds a zero modifier, so flat alpha is stored exactly */
+    constexpr int EAC_FLAT_TABLE = 13;
+    constexpr int EAC_FLAT_INDEX = 4;
+
+    inline int clamp255(int v) {
+        return v < 0 ? 0 : (v > 255 ? 255 : v);
+    }
+
+    inline int extend4(int v) { return (v << 4) | v; }
+    inline int extend5(int v) { return (v << 3) | (v >> 2); }
+    inline int extend6(int v) { return (v << 2) | (v >> 4); }
+    inline int extend7(int v) { return (v << 1) | (v >> 6); }
+
+    inline int signExtend3(int v) {
+        return v & 4 ? v - 8 : v;
+    }
+
+    inline uint64_t readBig64(const unsigned char* p) {
+        uint64_t v = 0;
+        for(int i = 0; i < 8; i++) v = (v << 8) | p[i];
+        return v;
+    }
+
+    inline void writeBig64(unsigned char* p, uint64_t v) {
+        for(int i = 7; i >= 0; i--) {
+            p[i] = static_cast<unsigned char>(v);
+            v >>= 8;
+        }
+    }
+
+    inline uint64_t bits(uint64_t v, int hi, int lo) {
+        return (v >> lo) & ((uint64_t(1) << (hi - lo + 1)) - 1);
+    }
+
+    inline int colorError(const unsigned char* a, int r, int g, int b) {
+        int dr = a[0] - r;
+        int dg = a[1] - g;
+        int db = a[2] - b;
+        return dr * dr + dg * dg + db * db;
+    }
+
+    /*
+     * Gathers the 4x4 block at (bx, by), repeating edge texels when the
+     * image does not cover it
+     */
+    void fetchBlock(const ImageDecoder::Image& image, int bx, int by, unsigned char* pixels) {
+        for(int y = 0; y < 4; y++) {
+            int sy = std::min(by * 4 + y, image.height - 1);
+            for(int x = 0; x < 4; x++) {
+                int sx = std::min(bx * 4 + x, image.width - 1);
+                memcpy(pixels + (y * 4 + x) * 4, &image.pixels[(static_cast<size_t>(sy) * image.width + sx) * 4], 4);
+            }
+        }
+    }
+
+    void storeBlock(const unsigned char* pixels, int bx, int by, ImageDecoder::Image& image) {
+        for(int y = 0; y < 4 && by * 4 + y < image.height; y++) {
+            int dy = by * 4 + y;
+            for(int x = 0; x < 4 && bx * 4 + x < image.width; x++) {
+                int dx = bx * 4 + x;
+                memcpy(&image.pixels[(static_cast<size_t>(dy) * image.width + dx) * 4], pixels + (y * 4 + x) * 4, 4);
+            }
+        }
+    }
+
+    /*
+    ** BC helpers
+    */
+    inline uint16_t pack565(int r, int g, int b) {
+        return static_cast<uint16_t>(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+    }
+
+    inline void unpack565(uint16_t c, int* rgb) {
+        rgb[0] = extend5(c >> 11);
+        rgb[1] = (((c >> 5) & 63) << 2) | (((c >> 5) & 63) >> 4);
+        rgb[2] = extend5(c & 31);
+    }
+
+    /*
+     * 16 alpha values, one per texel, into an 8-byte BC3 / BC4 block
+     * using the eight-value ramp between the extremes
+     */
+    void encodeBcAlpha(const unsigned char* alpha, int stride, unsigned char* block) {
+        int lo = 255;
+        int hi = 0;
+        for(int i = 0; i < 16; i++) {
+            lo = std::min(lo, static_cast<int>(alpha[i * stride]));
+            hi = std::max(hi, static_cast<int>(alpha[i * stride]));
+        }
+        block[0] = static_cast<unsigned char>(hi);
+        block[1] = static_cast<unsigned char>(lo);
+        uint64_t indices = 0;
+        if(hi > lo) {
+            int ramp[8];
+            ramp[0] = hi;
+            ramp[1] = lo;
+            for(int i = 1; i < 7; i++) ramp[i + 1] = ((7 - i) * hi + i * lo) / 7;
+            for(int i = 0; i < 16; i++) {
+                int a = alpha[i * stride];
+                int best = 0;
+                int bestErr = INT_MAX;
+                for(int k = 0; k < 8; k++) {
+                    int err = std::abs(ramp[k] - a);
+                    if(err < bestErr) {
+                        bestErr = err;
+                        best = k;
+                    }
+                }
+                indices |= static_cast<uint64_t>(best) << (i * 3);
+            }
+        }
+        for(int i = 0; i < 6; i++) block[2 + i] = static_cast<unsigned char>(indices >> (i * 8));
+    }
+
+    void decodeBcAlpha(const unsigned char* block, unsigned char* alpha, int stride) {
+        int ramp[8];
+        ramp[0] = block[0];
+        ramp[1] = block[1];
+        if(ramp[0] > ramp[1]) {
+            for(int i = 1; i < 7; i++) ramp[i + 1] = ((7 - i) * ramp[0] + i * ramp[1]) / 7;
+        } else {
+            for(int i = 1; i < 5; i++) ramp[i + 1] = ((5 - i) * ramp[0] + i * ramp[1]) / 5;
+            ramp[6] = 0;
+            ramp[7] = 255;
+        }
+        uint64_t indices = 0;
+        for(int i = 0; i < 6; i++) indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+        for(int i = 0; i < 16; i++) alpha[i * stride] = static_cast<unsigned char>(ramp[(indices >> (i * 3)) & 7]);
+    }
+
+    /*
+    ** ETC helpers
+    */
+
+    /*
+     * Texel (x, y) of a block is index x * 4 + y in every ETC layout
+     */
+    inline bool inFirstSubblock(int x, int y, bool flip) {
+        return flip ? y < 2 : x < 2;
+    }
+
+    /*
+     * Best modifier table for one subblock around a base color; writes
+     * the 2-bit selector for each of its texels. A modifier m moves all
+     * three channels, so a texel's error is s2 + m * (2 * s1 + 3 * m)
+     * from its sums of differences to the base. Clamping is ignored; it
+     * only ever lowers the real error
+     */
+    int fitEtcSubblock(const unsigned char* pixels, bool flip, bool first, const int* base, int& table, int* selectors) {
+        int s1[8];
+        int s2[8];
+        int texel[8];
+        int count = 0;
+        for(int x = 0; x < 4; x++) {
+            for(int y = 0; y < 4; y++) {
+                if(inFirstSubblock(x, y, flip) != first) continue;
+                const unsigned char* p = pixels + (y * 4 + x) * 4;
+                int dr = base[0] - p[0];
+                int dg = base[1] - p[1];
+                int db = base[2] - p[2];
+                s1[count] = 2 * (dr + dg + db);
+                s2[count] = dr * dr + dg * dg + db * db;
+                texel[count++] = x * 4 + y;
+            }
+        }
+
+        int bestErr = INT_MAX;
+        int chosen[8];
+        for(int t = 0; t < 8 && bestErr > 0; t++) {
+            int mods[4] = { ETC_MODIFIERS[t][0], ETC_MODIFIERS[t][1], -ETC_MODIFIERS[t][0], -ETC_MODIFIERS[t][1] };
+            /* The error is a parabola in m, so the sign of s1 picks the side and one compare the size */
+            int split = 3 * (mods[0] + mods[1]);
+            int err = 0;
+            for(int i = 0; i < count && err < bestErr; i++) {
+                int m = s1[i] <= 0 ? (-s1[i] > split ? 1 : 0) : (s1[i] > split ? 3 : 2);
+                chosen[i] = m;
+                err += s2[i] + mods[m] * (s1[i] + 3 * mods[m]);
+            }
+            if(err < bestErr) {
+                bestErr = err;
+                table = t;
+                for(int i = 0; i < count; i++) selectors[texel[i]] = chosen[i];
+            }
+        }
+        return bestErr;
+    }
+
+    uint64_t packEtcSelectors(const int* selectors) {
+        uint64_t v = 0;
+        for(int i = 0; i < 16; i++) {
+            v |= static_cast<uint64_t>(selectors[i] >> 1) << (i + 16);
+            v |= static_cast<uint64_t>(selectors[i] & 1) << i;
+        }
+        return v;
+    }
+
+    /*
+     * Alpha as an EAC block. Each table gets the multiplier and base that
+     * stretch it over the block's alpha range; the closest fit wins
+     */
+    uint64_t encodeEacAlpha(const unsigned char* pixels) {
+        int lo = 255;
+        int hi = 0;
+        for(int i = 0; i < 16; i++) {
+            lo = std::min(lo, static_cast<int>(pixels[i * 4 + 3]));
+            hi = std::max(hi, static_cast<int>(pixels[i * 4 + 3]));
+        }
+        if(lo == hi) {
+            uint64_t v = static_cast<uint64_t>(lo) << 56 | uint64_t(1) << 52 | static_cast<uint64_t>(EAC_FLAT_TABLE) << 48;
+            for(int i = 0; i < 16; i++) v |= static_cast<uint64_t>(EAC_FLAT_INDEX) << (45 - i * 3);
+            return v;
+        }
+
+        uint64_t best = 0;
+        int bestErr = INT_MAX;
+        for(int t = 0; t < 16 && bestErr > 0; t++) {
+            const int* mods = EAC_MODIFIERS[t];
+            int span = mods[7] - mods[3];
+            int mult = std::min(15, std::max(1, (hi - lo + span / 2) / span));
+            int base = clamp255((hi + lo - (mods[7] + mods[3]) * mult + 1) / 2);
+            int values[8];
+            for(int k = 0; k < 8; k++) values[k] = clamp255(base + mods[k] * mult);
+
+            uint64_t v = static_cast<uint64_t>(base) << 56 | static_cast<uint64_t>(mult) << 52 | static_cast<uint64_t>(t) << 48;
+            int err = 0;
+            for(int i = 0; i < 16 && err < bestErr; i++) {
+                int a = pixels[((i % 4) * 4 + i / 4) * 4 + 3];
+                int index = 0;
+                int indexErr = INT_MAX;
+                for(int k = 0; k < 8; k++) {
+                    int d = values[k] - a;
+                    if(d * d < indexErr) {
+                        indexErr = d * d;
+                        index = k;
+                    }
+                }
+                err += indexErr;
+                v |= static_cast<uint64_t>(index) << (45 - i * 3);
+            }
+            if(err < bestErr) {
+                bestErr = err;
+                best = v;
+            }
+        }
+        return best;
+    }
+
+    void decodeEacAlpha(uint64_t v, unsigned char* pixels) {
+        int base = static_cast<int>(bits(v, 63, 56));
+        int mult = static_cast<int>(bits(v, 55, 52));
+        const int* mods = EAC_MODIFIERS[bits(v, 51, 48)];
+        for(int i = 0; i < 16; i++) {
+            int index = static_cast<int>(bits(v, 47 - i * 3, 45 - i * 3));
+            int x = i / 4;
+            int y = i % 4;
+            pixels[(y * 4 + x) * 4 + 3] = static_cast<unsigned char>(clamp255(base + mods[index] * mult));
+        }
+    }
+}
+
+/*
+** Formats
+*/
+const char* TextureTranscoder::name(Format format) {
+    switch(format) {
+        case Format::RGBA8: return "RGBA8";
+        case Format::BC1: return "BC1";
+        case Format::BC3: return "BC3";
+        case Format::ETC2_RGB8: return "ETC2";
+        case Format::ETC2_RGBA8: return "ETC2+EAC";
+        case Format::ASTC_4X4: return "ASTC 4x4";
+    }
+    return "?";
+}
+
+size_t TextureTranscoder::blockBytes(Format format) {
+    switch(format) {
+        case Format::BC1:
+        case Format::ETC2_RGB8:
+            return 8;
+        case Format::BC3:
+        case Format::ETC2_RGBA8:
+        case Format::ASTC_4X4:
+            return 16;
+        case Format::RGBA8:
+            break;
+    }
+    return 0;
+}
+
+size_t TextureTranscoder::levelSize(Format format, int width, int height) {
+    if(!isCompressed(format)) return static_cast<size_t>(width) * height * 4;
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * blockBytes(format);
+}
+
+bool TextureTranscoder::canSample(Format format, uint32_t support) {
+    switch(format) {
+        case Format::RGBA8: return true;
+        case Format::BC1:
+        case Format::BC3:
+            return (support & SUPPORT_BC) != 0;
+        case Format::ETC2_RGB8:
+        case Format::ETC2_RGBA8:
+            return (support & SUPPORT_ETC2) != 0;
+        case Format::ASTC_4X4:
+            return (support & SUPPORT_ASTC) != 0;
+    }
+    return false;
+}
+
+/*
+ * BC is preferred where both exist: desktop GPUs decode ETC2 in the
+ * driver. ASTC needs an encoder this tree does not have, so it is only
+ * ever uploaded straight from a KTX2 file
+ */
+TextureTranscoder::Format TextureTranscoder::chooseFormat(uint32_t support, bool opaque) {
+    if(support & SUPPORT_BC) return opaque ? Format::BC1 : Format::BC3;
+    if(support & SUPPORT_ETC2) return opaque ? Format::ETC2_RGB8 : Format::ETC2_RGBA8;
+    return Format::RGBA8;
+}
+
+bool TextureTranscoder::isOpaque(const ImageDecoder::Image& image) {
+    const unsigned char* p = image.pixels.data();
+    size_t count = static_cast<size_t>(image.width) * image.height;
+    for(size_t i = 0; i < count; i++) {
+        if(p[i * 4 + 3] != 255) return false;
+    }
+    return true;
+}
+
+/*
+** Encode
+*/
+bool TextureTranscoder::encode(const ImageDecoder::Image& image, Format format, bool mipmaps, Texture& out) {
+    if(image.width <= 0 || image.height <= 0 || image.pixels.size() < static_cast<size_t>(image.width) * image.height * 4) {
+        std::cerr << "Cannot encode an empty image" << std::endl;
+        return false;
+    }
+    if(format == Format::ASTC_4X4) {
+        std::cerr << "ASTC encoding is not supported" << std::endl;
+        return false;
+    }
+
+    out.format = format;
+    out.width = image.width;
+    out.height = image.height;
+    out.levels.clear();
+
+    size_t total = 0;
+    int w = image.width;
+    int h = image.height;
+    for(;;) {
+        out.levels.push_back(Level{w, h, total, levelSize(format, w, h)});
+        total += out.levels.back().size;
+        if(!mipmaps || (w == 1 && h == 1)) break;
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+    out.data.resize(total);
+
+    ImageDecoder::Image scratch[2];
+    const ImageDecoder::Image* src = &image;
+    unsigned char pixels[64];
+    for(size_t l = 0; l < out.levels.size(); l++) {
+        if(l > 0) {
+            ImageDecoder::Image& dst = scratch[l & 1];
+            downsample(*src, dst);
+            src = &dst;
+        }
+        const Level& level = out.levels[l];
+        unsigned char* dst = out.data.data() + level.offset;
+        if(format == Format::RGBA8) {
+            memcpy(dst, src->pixels.data(), level.size);
+            continue;
+        }
+
+        int blocksX = (level.width + 3) / 4;
+        int blocksY = (level.height + 3) / 4;
+        size_t stride = blockBytes(format);
+        for(int by = 0; by < blocksY; by++) {
+            for(int bx = 0; bx < blocksX; bx++) {
+                fetchBlock(*src, bx, by, pixels);
+                unsigned char* block = dst + (static_cast<size_t>(by) * blocksX + bx) * stride;
+                switch(format) {
+                    case Format::BC1: encodeBc1(pixels, block); break;
+                    case Format::BC3: encodeBc3(pixels, block); break;
+                    case Format::ETC2_RGB8: encodeEtc2Rgb(pixels, block); break;
+                    case Format::ETC2_RGBA8: encodeEtc2Rgba(pixels, block); break;
+                    case Format::RGBA8:
+                    case Format::ASTC_4X4:
+                        break;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * 2x2 box filter; an odd last row or column is folded into its neighbour
+ */
+void TextureTranscoder::downsample(const ImageDecoder::Image& src, ImageDecoder::Image& dst) {
+    dst.width = std::max(1, src.width / 2);
+    dst.height = std::max(1, src.height / 2);
+    dst.pixels.resize(static_cast<size_t>(dst.width) * dst.height * 4);
+    for(int y = 0; y < dst.height; y++) {
+        int y0 = std::min(y * 2, src.height - 1);
+        int y1 = std::min(y * 2 + 1, src.height - 1);
+        for(int x = 0; x < dst.width; x++) {
+            int x0 = std::min(x * 2, src.width - 1);
+            int x1 = std::min(x * 2 + 1, src.width - 1);
+            const unsigned char* a = &src.pixels[(static_cast<size_t>(y0) * src.width + x0) * 4];
+            const unsigned char* b = &src.pixels[(static_cast<size_t>(y0) * src.width + x1) * 4];
+            const unsigned char* c = &src.pixels[(static_cast<size_t>(y1) * src.width + x0) * 4];
+            const unsigned char* d = &src.pixels[(static_cast<size_t>(y1) * src.width + x1) * 4];
+            unsigned char* out = &dst.pixels[(static_cast<size_t>(y) * dst.width + x) * 4];
+            for(int i = 0; i < 4; i++) out[i] = static_cast<unsigned char>((a[i] + b[i] + c[i] + d[i] + 2) >> 2);
+        }
+    }
+}
+
+/*
+ * BC1 endpoints are the corners of the color bounding box, with the
+ * minor channels flipped to follow the major one where they run against
+ * it, inset by 1/16 of the range to spend less on outliers
+ */
+void TextureTranscoder::encodeBc1(const unsigned char* pixels, unsigned char* block) {
+    int lo[3] = { 255, 255, 255 };
+    int hi[3] = { 0, 0, 0 };
+    int mean[3] = { 0, 0, 0 };
+    for(int i = 0; i < 16; i++) {
+        for(int c = 0; c < 3; c++) {
+            int v = pixels[i * 4 + c];
+            lo[c] = std::min(lo[c], v);
+            hi[c] = std::max(hi[c], v);
+            mean[c] += v;
+        }
+    }
+    int major = 0;
+    for(int c = 1; c < 3; c++) {
+        if(hi[c] - lo[c] > hi[major] - lo[major]) major = c;
+    }
+    for(int c = 0; c < 3; c++) {
+        if(c == major) continue;
+        int cov = 0;
+        for(int i = 0; i < 16; i++) {
+            cov += (pixels[i * 4 + major] * 16 - mean[major]) * (pixels[i * 4 + c] * 16 - mean[c]);
+        }
+        if(cov < 0) std::swap(lo[c], hi[c]);
+    }
+    for(int c = 0; c < 3; c++) {
+        int inset = (hi[c] - lo[c]) / 16;
+        hi[c] -= inset;
+        lo[c] += inset;
+    }
+
+    uint16_t c0 = pack565(hi[0], hi[1], hi[2]);
+    uint16_t c1 = pack565(lo[0], lo[1], lo[2]);
+    if(c0 < c1) std::swap(c0, c1);
+
+    uint32_t indices = 0;
+    if(c0 != c1) {
+        int palette[4][3];
+        unpack565(c0, palette[0]);
+        unpack565(c1, palette[1]);
+        for(int c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for(int i = 0; i < 16; i++) {
+            int best = 0;
+            int bestErr = INT_MAX;
+            for(int k = 0; k < 4; k++) {
+                int err = colorError(pixels + i * 4, palette[k][0], palette[k][1], palette[k][2]);
+                if(err < bestErr) {
+                    bestErr = err;
+                    best = k;
+                }
+            }
+            indices |= static_cast<uint32_t>(best) << (i * 2);
+        }
+    }
+
+    block[0] = static_cast<unsigned char>(c0);
+    block[1] = static_cast<unsigned char>(c0 >> 8);
+    block[2] = static_cast<unsigned char>(c1);
+    block[3] = static_cast<unsigned char>(c1 >> 8);
+    for(int i = 0; i < 4; i++) block[4 + i] = static_cast<unsigned char>(indices >> (i * 8));
+}
+
+void TextureTranscoder::encodeBc3(const unsigned char* pixels, unsigned char* block) {
+    encodeBcAlpha(pixels + 3, 4, block);
+    encodeBc1(pixels, block + 8);
+}
+
+/*
+ * Individual and differential modes only, which every ETC2 decoder
+ * reads. Both subblock orientations are tried
+ */
+void TextureTranscoder::encodeEtc2Rgb(const unsigned char* pixels, unsigned char* block) {
+    uint64_t best = 0;
+    int bestErr = INT_MAX;
+    for(int flip = 0; flip < 2; flip++) {
+        int sum[2][3] = {};
+        for(int y = 0; y < 4; y++) {
+            for(int x = 0; x < 4; x++) {
+                int s = inFirstSubblock(x, y, flip) ? 0 : 1;
+                for(int c = 0; c < 3; c++) sum[s][c] += pixels[(y * 4 + x) * 4 + c];
+            }
+        }
+
+        int q5[2][3];
+        bool differential = true;
+        for(int c = 0; c < 3; c++) {
+            q5[0][c] = (sum[0][c] * 31 + 255 * 4) / (255 * 8);
+            q5[1][c] = (sum[1][c] * 31 + 255 * 4) / (255 * 8);
+            int d = q5[1][c] - q5[0][c];
+            if(d < -4 || d > 3) differential = false;
+        }
+
+        int base[2][3];
+        int q4[2][3];
+        for(int s = 0; s < 2; s++) {
+            for(int c = 0; c < 3; c++) {
+                if(differential) {
+                    base[s][c] = extend5(q5[s][c]);
+                } else {
+                    q4[s][c] = (sum[s][c] * 15 + 255 * 4) / (255 * 8);
+                    base[s][c] = extend4(q4[s][c]);
+                }
+            }
+        }
+
+        int selectors[16];
+        int tables[2];
+        int err = fitEtcSubblock(pixels, flip, true, base[0], tables[0], selectors);
+        err += fitEtcSubblock(pixels, flip, false, base[1], tables[1], selectors);
+        if(err >= bestErr) continue;
+        bestErr = err;
+
+        uint64_t v = 0;
+        if(differential) {
+            for(int c = 0; c < 3; c++) {
+                int shift = 59 - c * 8;
+                v |= static_cast<uint64_t>(q5[0][c]) << shift;
+                v |= static_cast<uint64_t>((q5[1][c] - q5[0][c]) & 7) << (shift - 3);
+            }
+            v |= uint64_t(1) << 33;
+        } else {
+            for(int c = 0; c < 3; c++) {
+                int shift = 60 - c * 8;
+                v |= static_cast<uint64_t>(q4[0][c]) << shift;
+                v |= static_cast<uint64_t>(q4[1][c]) << (shift - 4);
+            }
+        }
+        v |= static_cast<uint64_t>(tables[0]) << 37;
+        v |= static_cast<uint64_t>(tables[1]) << 34;
+        v |= static_cast<uint64_t>(flip) << 32;
+        v |= packEtcSelectors(selectors);
+        best = v;
+    }
+    writeBig64(block, best);
+}
+
+void TextureTranscoder::encodeEtc2Rgba(const unsigned char* pixels, unsigned char* block) {
+    writeBig64(block, encodeEacAlpha(pixels));
+    encodeEtc2Rgb(pixels, block + 8);
+}
+
+/*
+** Decode
+*/
+bool TextureTranscoder::decode(const unsigned char* blocks, size_t size, Format format, int width, int height, ImageDecoder::Image& out) {
+    if(format == Format::ASTC_4X4) {
+        std::cerr << "ASTC decoding is not supported" << std::endl;
+        return false;
+    }
+    if(width <= 0 || height <= 0 || size < levelSize(format, width, height)) {
+        std::cerr << "Compressed level too small for " << width << "x" << height << std::endl;
+        return false;
+    }
+
+    out.width = width;
+    out.height = height;
+    out.pixels.resize(static_cast<size_t>(width) * height * 4);
+    if(format == Format::RGBA8) {
+        memcpy(out.pixels.data(), blocks, out.pixels.size());
+        return true;
+    }
+
+    int blocksX = (width + 3) / 4;
+    int blocksY = (height + 3) / 4;
+    size_t stride = blockBytes(format);
+    unsigned char pixels[64];
+    for(int by = 0; by < blocksY; by++) {
+        for(int bx = 0; bx < blocksX; bx++) {
+            const unsigned char* block = blocks + (static_cast<size_t>(by) * blocksX + bx) * stride;
+            switch(format) {
+                case Format::BC1: decodeBc1(block, pixels, true); break;
+                case Format::BC3: decodeBc3(block, pixels); break;
+                case Format::ETC2_RGB8: decodeEtc2Rgb(block, pixels); break;
+                case Format::ETC2_RGBA8: decodeEtc2Rgba(block, pixels); break;
+                case Format::RGBA8:
+                case Format::ASTC_4X4:
+                    break;
+            }
+            storeBlock(pixels, bx, by, out);
+        }
+    }
+    return true;
+}
+
+/*
+ * BC1 is the opaque RGB variant, so the three-color mode's last entry
+ * is black rather than transparent. threeColor is false for the color
+ * half of BC3, which always uses the four-color ramp
+ */
+void TextureTranscoder::decodeBc1(const unsigned char* block, unsigned char* pixels, bool threeColor) {
+    uint16_t c0 = static_cast<uint16_t>(block[0] | block[1] << 8);
+    uint16_t c1 = static_cast<uint16_t>(block[2] | block[3] << 8);
+    int palette[4][4];
+    unpack565(c0, palette[0]);
+    unpack565(c1, palette[1]);
+    palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+    if(c0 > c1 || !threeColor) {
+        for(int c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+    } else {
+        for(int c = 0; c < 3; c++) {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    uint32_t indices = block[4] | block[5] << 8 | block[6] << 16 | static_cast<uint32_t>(block[7]) << 24;
+    for(int i = 0; i < 16; i++) {
+        const int* color = palette[(indices >> (i * 2)) & 3];
+        for(int c = 0; c < 4; c++) pixels[i * 4 + c] = static_cast<unsigned char>(color[c]);
+    }
+}
+
+void TextureTranscoder::decodeBc3(const unsigned char* block, unsigned char* pixels) {
+    decodeBc1(block + 8, pixels, false);
+    decodeBcAlpha(block, pixels + 3, 4);
+}
+
+/*
+ * All five ETC2 modes. Differential blocks whose second base overflows
+ * in red, green or blue are T, H and planar blocks respectively
+ */
+void TextureTranscoder::decodeEtc2Rgb(const unsigned char* block, unsigned char* pixels) {
+    uint64_t v = readBig64(block);
+    bool differential = bits(v, 33, 33) != 0;
+    bool flip = bits(v, 32, 32) != 0;
+
+    int paint[4][3];
+    bool paintMode = false;
+    if(differential) {
+        int r = static_cast<int>(bits(v, 63, 59)) + signExtend3(static_cast<int>(bits(v, 58, 56)));
+        int g = static_cast<int>(bits(v, 55, 51)) + signExtend3(static_cast<int>(bits(v, 50, 48)));
+        int b = static_cast<int>(bits(v, 47, 43)) + signExtend3(static_cast<int>(bits(v, 42, 40)));
+
+        if(r < 0 || r > 31) {
+            int base1[3] = {
+                extend4(static_cast<int>(bits(v, 60, 59) << 2 | bits(v, 57, 56))),
+                extend4(static_cast<int>(bits(v, 55, 52))),
+                extend4(static_cast<int>(bits(v, 51, 48)))
+            };
+            int base2[3] = {
+                extend4(static_cast<int>(bits(v, 47, 44))),
+                extend4(static_cast<int>(bits(v, 43, 40))),
+                extend4(static_cast<int>(bits(v, 39, 36)))
+            };
+            int d = ETC_DISTANCES[bits(v, 35, 34) << 1 | bits(v, 32, 32)];
+            for(int c = 0; c < 3; c++) {
+                paint[0][c] = base1[c];
+                paint[1][c] = clamp255(base2[c] + d);
+                paint[2][c] = base2[c];
+                paint[3][c] = clamp255(base2[c] - d);
+            }
+            paintMode = true;
+        } else if(g < 0 || g > 31) {
+            int q1[3] = {
+                static_cast<int>(bits(v, 62, 59)),
+                static_cast<int>(bits(v, 58, 56) << 1 | bits(v, 52, 52)),
+                static_cast<int>(bits(v, 51, 51) << 3 | bits(v, 49, 47))
+            };
+            int q2[3] = {
+                static_cast<int>(bits(v, 46, 43)),
+                static_cast<int>(bits(v, 42, 39)),
+                static_cast<int>(bits(v, 38, 35))
+            };
+            int order = (q1[0] << 8 | q1[1] << 4 | q1[2]) >= (q2[0] << 8 | q2[1] << 4 | q2[2]) ? 1 : 0;
+            int d = ETC_DISTANCES[bits(v, 34, 34) << 2 | bits(v, 32, 32) << 1 | order];
+            for(int c = 0; c < 3; c++) {
+                paint[0][c] = clamp255(extend4(q1[c]) + d);
+                paint[1][c] = clamp255(extend4(q1[c]) - d);
+                paint[2][c] = clamp255(extend4(q2[c]) + d);
+                paint[3][c] = clamp255(extend4(q2[c]) - d);
+            }
+            paintMode = true;
+        } else if(b < 0 || b > 31) {
+            int o[3] = {
+                extend6(static_cast<int>(bits(v, 62, 57))),
+                extend7(static_cast<int>(bits(v, 56, 56) << 6 | bits(v, 54, 49))),
+                extend6(static_cast<int>(bits(v, 48, 48) << 5 | bits(v, 44, 43) << 3 | bits(v, 41, 39)))
+            };
+            int h[3] = {
+                extend6(static_cast<int>(bits(v, 38, 34) << 1 | bits(v, 32, 32))),
+                extend7(static_cast<int>(bits(v, 31, 25))),
+                extend6(static_cast<int>(bits(v, 24, 19)))
+            };
+            int vv[3] = {
+                extend6(static_cast<int>(bits(v, 18, 13))),
+                extend7(static_cast<int>(bits(v, 12, 6))),
+                extend6(static_cast<int>(bits(v, 5, 0)))
+            };
+            for(int y = 0; y < 4; y++) {
+                for(int x = 0; x < 4; x++) {
+                    unsigned char* p = pixels + (y * 4 + x) * 4;
+                    for(int c = 0; c < 3; c++) {
+                        p[c] = static_cast<unsigned char>(clamp255((x * (h[c] - o[c]) + y * (vv[c] - o[c]) + 4 * o[c] + 2) >> 2));
+                    }
+                    p[3] = 255;
+                }
+            }
+            return;
+        }
+    }
+
+    if(paintMode) {
+        for(int i = 0; i < 16; i++) {
+            int index = static_cast<int>(bits(v, i + 16, i + 16) << 1 | bits(v, i, i));
+            unsigned char* p = pixels + ((i % 4) * 4 + i / 4) * 4;
+            for(int c = 0; c < 3; c++) p[c] = static_cast<unsigned char>(paint[index][c]);
+            p[3] = 255;
+        }
+        return;
+    }
+
+    int base[2][3];
+    for(int c = 0; c < 3; c++) {
+        if(differential) {
+            int q = static_cast<int>(bits(v, 63 - c * 8, 59 - c * 8));
+            base[0][c] = extend5(q);
+            base[1][c] = extend5(q + signExtend3(static_cast<int>(bits(v, 58 - c * 8, 56 - c * 8))));
+        } else {
+            base[0][c] = extend4(static_cast<int>(bits(v, 63 - c * 8, 60 - c * 8)));
+            base[1][c] = extend4(static_cast<int>(bits(v, 59 - c * 8, 56 - c * 8)));
+        }
+    }
+    int tables[2] = { static_cast<int>(bits(v, 39, 37)), static_cast<int>(bits(v, 36, 34)) };
+    for(int i = 0; i < 16; i++) {
+        int x = i / 4;
+        int y = i % 4;
+        int s = inFirstSubblock(x, y, flip) ? 0 : 1;
+        int index = static_cast<int>(bits(v, i + 16, i + 16) << 1 | bits(v, i, i));
+        int mod = ETC_MODIFIERS[tables[s]][index & 1];
+        if(index & 2) mod = -mod;
+        unsigned char* p = pixels + (y * 4 + x) * 4;
+        for(int c = 0; c < 3; c++) p[c] = static_cast<unsigned char>(clamp255(base[s][c] + mod));
+        p[3] = 255;
+    }
+}
+
+void TextureTranscoder::decodeEtc2Rgba(const unsigned char* block, unsigned char* pixels) {
+    decodeEtc2Rgb(block + 8, pixels);
+    decodeEacAlpha(readBig64(block), pixels);
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "image_decoder.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+** CPU side of compressed textures, free of GL so it runs on the decode
+** worker and in native builds. Encodes RGBA8 images to the block
+** formats WebGL2 exposes (BC1/BC3 through WEBGL_compressed_texture_s3tc,
+** ETC2/EAC through WEBGL_compressed_texture_etc) with a full mip chain,
+** and decodes those formats back to RGBA8 for contexts that lack them.
+**
+** The encoders are single-pass, real-time ones: bounding-box endpoints
+** for BC, per-subblock averages for ETC. They trade some quality for
+** running at import time.
+*/
+class TextureTranscoder {
+    public:
+        enum class Format : uint8_t {
+            RGBA8,
+            BC1,
+            BC3,
+            ETC2_RGB8,
+            ETC2_RGBA8,
+            ASTC_4X4
+        };
+
+        /* Compressed format families a context can sample */
+        enum : uint32_t {
+            SUPPORT_BC = 1,
+            SUPPORT_ETC2 = 2,
+            SUPPORT_ASTC = 4
+        };
+
+        struct Level {
+            int width;
+            int height;
+            size_t offset;
+            size_t size;
+        };
+
+        struct Texture {
+            Format format = Format::RGBA8;
+            int width = 0;
+            int height = 0;
+            std::vector<Level> levels;
+            std::vector<unsigned char> data;
+        };
+
+        static bool isCompressed(Format format) { return format != Format::RGBA8; }
+        static const char* name(Format format);
+        static size_t blockBytes(Format format);
+        static size_t levelSize(Format format, int width, int height);
+        static bool canSample(Format format, uint32_t support);
+        static Format chooseFormat(uint32_t support, bool opaque);
+        static bool isOpaque(const ImageDecoder::Image& image);
+
+        static bool encode(const ImageDecoder::Image& image, Format format, bool mipmaps, Texture& out);
+        static bool decode(const unsigned char* blocks, size_t size, Format format, int width, int height, ImageDecoder::Image& out);
+        static void downsample(const ImageDecoder::Image& src, ImageDecoder::Image& dst);
+
+        /* Single 4x4 blocks; pixels are 16 RGBA texels, row by row */
+        static void encodeBc1(const unsigned char* pixels, unsigned char* block);
+        static void encodeBc3(const unsigned char* pixels, unsigned char* block);
+        static void encodeEtc2Rgb(const unsigned char* pixels, unsigned char* block);
+        static void encodeEtc2Rgba(const unsigned char* pixels, unsigned char* block);
+        static void decodeBc1(const unsigned char* block, unsigned char* pixels, bool threeColor);
+        static void decodeBc3(const unsigned char* block, unsigned char* pixels);
+        static void decodeEtc2Rgb(const unsigned char* block, unsigned char* pixels);
+        static void decodeEtc2Rgba(const unsigned char* block, unsigned char* pixels);
+};
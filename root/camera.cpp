@@ -2,6 +2,7 @@
 #include "main.h"
 #include ".buffers/buffers.h"
 #include ".controller/buffer_controller.h"
+#include "_utils/profiler.h"
 #include <emscripten.h>
 #include <emscripten/html5.h>
 #include <GLES3/gl3.h>
@@ -48,15 +49,17 @@ Camera::~Camera() {}
 ** Set Camera
 */
 void Camera::set() {
+    PROFILE_ZONE(UNIFORMS);
     glUseProgram(shaderController->shaderProgram);
     
     glm::mat4 projMatrix = getProjectionMatrix();
-    int projMatrixLoc = glGetUniformLocation(shaderController->shaderProgram, "projection");
+    GLint projMatrixLoc = shaderController->getUniform(ShaderController::Uniform::PROJECTION);
     glUniformMatrix4fv(projMatrixLoc, 1, GL_FALSE, glm::value_ptr(projMatrix));
 
     glm::mat4 viewMatrix = getViewMatrix();
-    int viewLoc = glGetUniformLocation(shaderController->shaderProgram, "view");
+    GLint viewLoc = shaderController->getUniform(ShaderController::Uniform::VIEW);
     glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(viewMatrix));
+    Profiler::get().countUniforms(2);
 }
 
 /*
@@ -187,19 +190,15 @@ void Camera::updateFollowing() {
         return;
     }
 
-    const PlanetBuffer* planet = nullptr;
     if(
-        bufferController->buffers &&
-        followingPlanetIndex < bufferController->buffers->planetBuffers.size()
+        !bufferController->buffers ||
+        followingPlanetIndex >= bufferController->buffers->orbitalState.size()
     ) {
-        planet = &bufferController->buffers->planetBuffers[followingPlanetIndex];
-    }
-    if(!planet) {
         resetToSavedPos();
         return;
     }
 
-    target = planet->worldPos;
+    target = bufferController->buffers->orbitalState.getWorldPos(followingPlanetIndex);
     position = target + followingPlanetOffset;
     updateVectors();
 }
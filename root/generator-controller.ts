@@ -41,7 +41,16 @@ interface OptionsData {
 }
 
 export class GeneratorController {
+    /* Ordinals of BufferData::Type and RotationAxis */
+    private static readonly SHAPES = ['TRIANGLE', 'CUBE', 'SPHERE'];
+    private static readonly AXES = ['X', 'Y', 'Z'];
+    /* sizeof(PreviewPlanetPacket) */
+    private static readonly PACKET_BYTES = 36;
+    /* Base64 characters per texture upload call */
+    private static readonly TEXTURE_CHUNK = 16384;
+
     private emscriptenModule: any;
+    private previewPacket: number = 0;
     
     private loader: DocumentLoader;
     private container: HTMLElement | null = null;
@@ -209,7 +218,9 @@ export class GeneratorController {
     ** Upload Texture
     */
     private uploadTexture(data: any): void {
-        if(this.emscriptenModule._uploadTexture) {
+        if(this.emscriptenModule._beginTextureUpload) {
+            this.uploadTextureChunked(data);
+        } else if(this.emscriptenModule._uploadTexture) {
             this.emscriptenModule._uploadTexture(
                 data.name,
                 data.data,
@@ -230,6 +241,32 @@ export class GeneratorController {
         }
     }
 
+    /*
+    ** Sends the base64 payload in slices; the module decodes each
+    ** one as it arrives instead of taking the whole data URL at once
+    */
+    private uploadTextureChunked(data: any): void {
+        const module = this.emscriptenModule;
+        const text: string = data.data;
+        const start = text.startsWith('data:') ? text.indexOf(',') + 1 : 0;
+        const chunk = GeneratorController.TEXTURE_CHUNK;
+
+        module.ccall('beginTextureUpload',
+            null,
+            ['string', 'number', 'number'],
+            [data.name, data.width, data.height]
+        );
+        for(let i = start; i < text.length; i += chunk) {
+            const ok = module.ccall('appendTextureUpload',
+                'number',
+                ['string'],
+                [text.substring(i, i + chunk)]
+            );
+            if(!ok) break;
+        }
+        module.ccall('finishTextureUpload', 'number', [], []);
+    }
+
     /*
     ** Generate
     */
@@ -359,8 +396,27 @@ export class GeneratorController {
             updateTimeout = setTimeout(updatePreview, 100);
         }
 
+        /*
+        ** Slider and select changes go out once per frame as a packed
+        ** struct; name or texture edits take the debounced JSON path
+        */
+        let framePending = false;
+        let lastTextKey = '';
+        const scheduleUpdate = () => {
+            if(framePending) return;
+            framePending = true;
+            requestAnimationFrame(() => {
+                framePending = false;
+                const data = this.getCurrentData();
+                const textKey = `${data.name}|${data.texture}`;
+                if(textKey === lastTextKey && this.sendPreviewPacket(data)) return;
+                lastTextKey = textKey;
+                debouncedUpdate();
+            });
+        }
+
         if(this.generatorConfig) {
-            this.generatorConfig.setupFormElementListeners(this.container, debouncedUpdate);
+            this.generatorConfig.setupFormElementListeners(this.container, scheduleUpdate);
             this.generatorConfig.setupButtonListeners(
             this.container,
                 () => this.generate(),
@@ -369,6 +425,39 @@ export class GeneratorController {
         }
     }
 
+    /*
+    ** Preview Packet
+    */
+    private sendPreviewPacket(data: any): boolean {
+        const module = this.emscriptenModule;
+        if(!module || !module._updatePreviewPacket || !module._malloc) return false;
+
+        const shape = GeneratorController.SHAPES.indexOf(data.shape);
+        const axis = GeneratorController.AXES.indexOf(data.rotationDir);
+        const rgb = /^#([0-9a-f]{2})([0-9a-f]{2})([0-9a-f]{2})$/i.exec(data.color || '');
+        if(shape < 0 || axis < 0 || !rgb) return false;
+
+        if(!this.previewPacket) {
+            this.previewPacket = module._malloc(GeneratorController.PACKET_BYTES);
+            if(!this.previewPacket) return false;
+        }
+
+        /* Views are re-read every call, the heap may have grown */
+        const i32 = module.HEAP32 as Int32Array;
+        const f32 = module.HEAPF32 as Float32Array;
+        const p = this.previewPacket >> 2;
+        i32[p] = shape;
+        f32[p + 1] = Number(data.size);
+        f32[p + 2] = parseInt(rgb[1], 16) / 255;
+        f32[p + 3] = parseInt(rgb[2], 16) / 255;
+        f32[p + 4] = parseInt(rgb[3], 16) / 255;
+        i32[p + 5] = axis;
+        f32[p + 6] = Number(data.rotationSpeedItself);
+        f32[p + 7] = Number(data.rotationSpeedCenter);
+        i32[p + 8] = Number(data.position) | 0;
+        return module._updatePreviewPacket(this.previewPacket) === 1;
+    }
+
     public onGenerate(cb: (data: any) => void): void {
         this.onGenerateClick = cb;
     }
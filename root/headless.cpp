@@ -0,0 +1,136 @@
+/*
+** Headless native driver for the simulation core. Loads a preset,
+** optionally replicates it to N bodies, and steps the orbit update,
+** ray picking and preset round-trips without a browser or GL context.
+** When a CSV path is given, per-frame profiler zones are dumped there.
+** The /_data files the core loads itself come from the source tree, or
+** from $PLANET_DATA_ROOT when set.
+**
+**   planet_headless [preset.json] [frames] [bodies] [profile.csv]
+*/
+#include ".buffers/buffer_generator.h"
+#include ".buffers/orbital_state.h"
+#include ".buffers/ray_intersection.h"
+#include ".preset/preset_converter.h"
+#include ".preset/preset_binary.h"
+#include "_platform/platform.h"
+#include "_platform/file_source.h"
+#include "_utils/profiler.h"
+#include <cstdio>
+#include <cstdlib>
+
+static bool samePlanet(const PlanetData& a, const PlanetData& b) {
+    return a.id == b.id && a.name == b.name && a.shape == b.shape && a.size == b.size &&
+        a.texture == b.texture && a.color == b.color && a.colorRgb == b.colorRgb &&
+        a.position == b.position && a.rotationDir == b.rotationDir &&
+        a.rotationSpeedItself == b.rotationSpeedItself &&
+        a.rotationSpeedCenter == b.rotationSpeedCenter &&
+        a.distanceFromCenter == b.distanceFromCenter &&
+        a.currentRotation == b.currentRotation && a.orbitAngle == b.orbitAngle;
+}
+
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "_data/default_preset.json";
+    int frames = argc > 2 ? atoi(argv[2]) : 600;
+    size_t bodies = argc > 3 ? strtoul(argv[3], nullptr, 10) : 0;
+    const char* csvPath = argc > 4 ? argv[4] : nullptr;
+    if(const char* root = getenv("PLANET_DATA_ROOT")) Platform::setDataRoot(root);
+
+    FileSource data(path);
+    if(!data.isOpen()) {
+        fprintf(stderr, "Failed to open preset: %s\n", path.c_str());
+        return 1;
+    }
+
+    PresetData preset;
+    double start = Platform::now();
+    if(!PresetConverter::convertToPreset(data.view(), preset) || preset.planets.empty()) {
+        fprintf(stderr, "Failed to parse preset: %s\n", path.c_str());
+        return 1;
+    }
+    double parseMs = Platform::now() - start;
+
+    size_t source = preset.planets.size();
+    for(size_t i = source; i < bodies; i++) {
+        PlanetData planet = preset.planets[i % source];
+        planet.id = static_cast<uint32_t>(i);
+        planet.orbitAngle.y += static_cast<float>(i % 360);
+        preset.planets.push_back(planet);
+    }
+
+    BufferGenerator generator(nullptr);
+    OrbitalState state;
+    state.reserve(preset.planets.size());
+    for(const auto& planet : preset.planets) {
+        state.push(planet);
+    }
+
+    /* Simulation */
+    const float deltaTime = 1.0f / 60.0f;
+    start = Platform::now();
+    for(int f = 0; f < frames; f++) {
+        Profiler::get().beginFrame();
+        PROFILE_ZONE(SIMULATION);
+        generator.updatePlanetRotation(state, deltaTime);
+        state.updatePositions();
+    }
+    double simMs = Platform::now() - start;
+
+    /* Picking, from a camera looking down at the system */
+    glm::vec3 eye(0.0f, 8.0f, 8.0f);
+    size_t hits = 0;
+    start = Platform::now();
+    Profiler::get().beginFrame();
+    {
+        PROFILE_ZONE(RAYCAST);
+        for(size_t i = 0; i < state.size(); i++) {
+            glm::vec3 target = state.getWorldPos(i);
+            glm::vec3 dir = glm::normalize(target - eye);
+            if(RayIntersection::test(eye, dir, target, preset.planets[i].size, preset.planets[i].shape)) {
+                hits++;
+            }
+        }
+    }
+    double pickMs = Platform::now() - start;
+
+    /* Round-trip */
+    Profiler::get().beginFrame();
+    start = Platform::now();
+    PresetData roundTrip;
+    bool roundTripOk;
+    std::string out;
+    {
+        PROFILE_ZONE(PRESET_IO);
+        out = PresetConverter::presetToData(preset);
+        roundTripOk = PresetConverter::convertToPreset(out, roundTrip) && 
+            roundTrip.planets.size() == preset.planets.size();
+    }
+    Profiler::get().beginFrame();
+    double roundTripMs = Platform::now() - start;
+
+    /* Binary round-trip, compared field by field */
+    start = Platform::now();
+    std::string binary = PresetBinary::encode(preset);
+    PresetData binaryTrip;
+    bool binaryOk = PresetBinary::decode(binary, binaryTrip) &&
+        binaryTrip.planets.size() == preset.planets.size();
+    for(size_t i = 0; binaryOk && i < preset.planets.size(); i++) {
+        binaryOk = samePlanet(preset.planets[i], binaryTrip.planets[i]);
+    }
+    double binaryMs = Platform::now() - start;
+
+    printf("preset: %s (%zu bodies)\n", path.c_str(), preset.planets.size());
+    printf("parse:      %.3f ms\n", parseMs);
+    printf("simulate:   %.3f ms for %d frames (%.4f ms/frame)\n", simMs, frames, frames > 0 ? simMs / frames : 0.0);
+    printf("pick:       %.3f ms, %zu/%zu hits\n", pickMs, hits, state.size());
+    printf("round-trip: %.3f ms, %zu bytes, %s\n", roundTripMs, out.size(), roundTripOk ? "ok" : "FAILED");
+    printf("binary:     %.3f ms, %zu bytes, %s\n", binaryMs, binary.size(), binaryOk ? "ok" : "FAILED");
+
+    const Profiler::Stats& stats = Profiler::get().computeStats();
+    printf("frames:     p50 %.4f  p95 %.4f  p99 %.4f ms\n", stats.frameP50, stats.frameP95, stats.frameP99);
+    if(csvPath && !Profiler::get().writeCsv(csvPath)) {
+        fprintf(stderr, "Failed to write profile: %s\n", csvPath);
+        return 1;
+    }
+    return roundTripOk && binaryOk ? 0 : 1;
+}
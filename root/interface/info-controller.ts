@@ -5,6 +5,11 @@ export class InfoController {
     
     private loader: DocumentLoader;
     private container: HTMLElement | null = null;
+    private stats: HTMLElement | null = null;
+    private statsTimer: number | null = null;
+
+    private static readonly STATS_INTERVAL = 500;
+    private static readonly ZONES = ['sim', 'cull', 'uniforms', 'draw', 'raycast', 'preset io', 'preview', 'textures'];
         
     constructor(module: any) {
         this.emscriptenModule = module;
@@ -27,6 +32,7 @@ export class InfoController {
                 [html]
             );
         }
+        if(this.stats) document.body.appendChild(this.stats);
     }
 
     /*
@@ -63,6 +69,7 @@ export class InfoController {
             if(!doc) throw new Error('doc err');
 
             this.container = doc.querySelector('.info--container');
+            this.stats = doc.querySelector('#info--stats');
             return this.container;
         } catch(err) {
             console.error(err);
@@ -118,7 +125,83 @@ export class InfoController {
         }, 100);
     }
 
+    /*
+    ** Frame Stats
+    */
+    private toggleStats(): void {
+        const el = document.getElementById('info--stats');
+        if(!el) return;
+
+        if(this.statsTimer !== null) {
+            clearInterval(this.statsTimer);
+            this.statsTimer = null;
+            el.style.display = 'none';
+            return;
+        }
+        el.style.display = 'block';
+        this.updateStats(el);
+        this.statsTimer = window.setInterval(() => {
+            this.updateStats(el);
+        }, InfoController.STATS_INTERVAL);
+    }
+
+    /*
+     * Reads the packed Profiler::Stats block:
+     * 4 frame floats, one float per zone, then 4 uint32 counters
+     */
+    private updateStats(el: HTMLElement): void {
+        const module = this.emscriptenModule;
+        if(!module || !module._getFrameStats) return;
+
+        const ptr = module._getFrameStats() >> 2;
+        const f32 = module.HEAPF32 as Float32Array;
+        const u32 = module.HEAPU32 as Uint32Array;
+        const zones = InfoController.ZONES;
+        const counters = ptr + 4 + zones.length;
+
+        const lines = [
+            `frame  p50 ${f32[ptr].toFixed(2)}  p95 ${f32[ptr + 1].toFixed(2)}  p99 ${f32[ptr + 2].toFixed(2)} ms`,
+            `avg    ${f32[ptr + 3].toFixed(2)} ms over ${u32[counters + 3]} frames`
+        ];
+        for(let i = 0; i < zones.length; i++) {
+            lines.push(`${zones[i].padEnd(9)}${f32[ptr + 4 + i].toFixed(3)} ms`);
+        }
+        lines.push(`draws ${u32[counters]}  tris ${u32[counters + 1]}  uniforms ${u32[counters + 2]}`);
+        this.appendTextureStats(lines);
+
+        const pre = el.querySelector('pre');
+        if(pre) pre.textContent = lines.join('\n');
+    }
+
+    /*
+     * Reads the packed TextureLoader::UploadStats block: budget,
+     * uploaded last frame, pending textures, pending bytes, resident
+     * textures (uint32), upload ms (float), then resident bytes, the
+     * compressed format bits, atlas pages and atlased textures (uint32)
+     */
+    private appendTextureStats(lines: string[]): void {
+        const module = this.emscriptenModule;
+        if(!module._getTextureStats) return;
+        const ptr = module._getTextureStats() >> 2;
+        if(!ptr) return;
+
+        const f32 = module.HEAPF32 as Float32Array;
+        const u32 = module.HEAPU32 as Uint32Array;
+        const kb = (bytes: number) => (bytes / 1024).toFixed(0);
+        const formats = ['bc', 'etc2', 'astc'].filter((_, i) => u32[ptr + 7] & (1 << i));
+        lines.push(
+            `tex    ${u32[ptr + 4]} resident (${kb(u32[ptr + 6])} KB)  ${u32[ptr + 2]} pending (${kb(u32[ptr + 3])} KB)`,
+            `upload ${kb(u32[ptr + 1])} / ${u32[ptr] ? kb(u32[ptr]) : 'unlimited'} KB  ${f32[ptr + 5].toFixed(3)} ms`,
+            `format ${formats.length ? formats.join(' ') : 'rgba only'}`,
+            `atlas  ${u32[ptr + 9]} textures on ${u32[ptr + 8]} pages`
+        );
+    }
+
     public setupCallbacks(): void {
+        window.addEventListener('keydown', (e) => {
+            if(e.key === '`') this.toggleStats();
+        });
+
         (window as any).display = (name: string, info: string) => {
             this.display(name, info);
         }
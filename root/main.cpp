@@ -1,5 +1,6 @@
 #include "main.h"
 #include ".buffers/buffer_data.h"
+#include "_utils/profiler.h"
 
 static Main* g_app = nullptr;
 
@@ -118,6 +119,7 @@ void Main::init() {
 ** Render
 */
 void Main::render() {
+    Profiler::get().beginFrame();
     static float lastTime = 0;
     float currentTime = emscripten_get_now() / 1000.0f;
     float deltaTime = currentTime - lastTime;